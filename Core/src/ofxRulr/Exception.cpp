@@ -1,11 +1,11 @@
-#include "Exception.h"
-
-namespace ofxRulr {
-	//---------
-	Exception::Exception(const std::string message) : message(message) {	}
-
-	//---------
-	const char * Exception::what() const throw() {
-		return this->message.c_str();
-	}
+#include "Exception.h"
+
+namespace ofxRulr {
+	//---------
+	Exception::Exception(const std::string message) : message(message) {	}
+
+	//---------
+	const char * Exception::what() const throw() {
+		return this->message.c_str();
+	}
 }
\ No newline at end of file
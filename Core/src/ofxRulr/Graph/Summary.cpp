@@ -5,6 +5,8 @@
 #include "ofxCvGui/Widgets/EditableValue.h"
 #include "ofxCvGui/Widgets/Title.h"
 
+#include "../Utils/Bounds.h"
+
 using namespace ofxCvGui;
 
 namespace ofxRulr {
@@ -14,6 +16,7 @@ namespace ofxRulr {
 		world() {
 			RULR_NODE_INIT_LISTENER;
 			this->world = nullptr;
+			this->culledNodeCount = 0;
 		}
 
 		//----------
@@ -28,15 +31,22 @@ namespace ofxRulr {
 			RULR_NODE_SERIALIZATION_LISTENERS;
 
 			this->view = MAKE(ofxCvGui::Panels::World);
-			this->view->onDrawWorld += [this](ofCamera &) {
+			this->view->onDrawWorld += [this](ofCamera & camera) {
 				if (this->showGrid) {
 					this->drawGrid();
 				}
 				if (this->world) {
 					auto & world = *this->world;
+					Utils::Frustum frustum(camera.getModelViewProjectionMatrix());
+					size_t culledNodeCount = 0;
 					for (const auto node : world) {
+						if (this->cullOffscreen && !frustum.intersects(node->getWorldBounds())) {
+							culledNodeCount++;
+							continue;
+						}
 						node->drawWorld();
 					}
+					this->culledNodeCount = culledNodeCount;
 				}
 
 			};
@@ -50,6 +60,7 @@ namespace ofxRulr {
 			this->showGrid.set("Show Grid", true);
 			this->roomMinimum.set("Room minimum", ofVec3f(-5.0f, -4.0f, 0.0f));
 			this->roomMaximum.set("Room maxmimim", ofVec3f(+5.0f, 0.0f, 6.0f));
+			this->cullOffscreen.set("Cull offscreen nodes", true);
 			this->view->setGridEnabled(false);
 		}
 
@@ -76,6 +87,7 @@ namespace ofxRulr {
 			Utils::Serializable::serialize(this->showGrid, json);
 			Utils::Serializable::serialize(this->roomMinimum, json);
 			Utils::Serializable::serialize(this->roomMaximum, json);
+			Utils::Serializable::serialize(this->cullOffscreen, json);
 
 			auto & camera = this->view->getCamera();
 			auto & cameraJson = json["Camera"];
@@ -89,6 +101,7 @@ namespace ofxRulr {
 			Utils::Serializable::deserialize(this->showGrid, json);
 			Utils::Serializable::deserialize(this->roomMinimum, json);
 			Utils::Serializable::deserialize(this->roomMaximum, json);
+			Utils::Serializable::deserialize(this->cullOffscreen, json);
 
 			auto & camera = this->view->getCamera();
 			if (json.isMember("Camera")) {
@@ -123,6 +136,12 @@ namespace ofxRulr {
 			inspector->add(Widgets::Toggle::make(this->showGrid));
 			inspector->add(Widgets::EditableValue<ofVec3f>::make(this->roomMinimum));
 			inspector->add(Widgets::EditableValue<ofVec3f>::make(this->roomMaximum));
+
+			inspector->add(Widgets::Title::make("Drawing", Widgets::Title::Level::H3));
+			inspector->add(Widgets::Toggle::make(this->cullOffscreen));
+			inspector->add(Widgets::LiveValue<size_t>::make("Culled nodes", [this]() {
+				return this->culledNodeCount;
+			}));
 		}
 
 
@@ -34,6 +34,9 @@ namespace ofxRulr {
 			ofParameter<bool> showGrid;
 			ofParameter<ofVec3f> roomMinimum;
 			ofParameter<ofVec3f> roomMaximum;
+			ofParameter<bool> cullOffscreen;
+
+			size_t culledNodeCount;
 
 			const Utils::Set<Nodes::Base> * world;
 
@@ -0,0 +1,138 @@
+#include "Bounds.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace ofxRulr {
+	namespace Utils {
+#pragma mark Bounds
+		//----------
+		Bounds::Bounds() :
+		minimum(std::numeric_limits<float>::max()),
+		maximum(-std::numeric_limits<float>::max()),
+		everywhereFlag(false) {
+		}
+
+		//----------
+		Bounds::Bounds(const ofVec3f & minimum, const ofVec3f & maximum) :
+		minimum(minimum),
+		maximum(maximum),
+		everywhereFlag(false) {
+		}
+
+		//----------
+		Bounds Bounds::everywhere() {
+			Bounds bounds(ofVec3f(-std::numeric_limits<float>::max()), ofVec3f(std::numeric_limits<float>::max()));
+			bounds.everywhereFlag = true;
+			return bounds;
+		}
+
+		//----------
+		Bounds Bounds::fromPoints(const std::vector<ofVec3f> & points) {
+			Bounds bounds;
+			for (const auto & point : points) {
+				bounds.add(point);
+			}
+			return bounds;
+		}
+
+		//----------
+		bool Bounds::isEmpty() const {
+			return !this->everywhereFlag && (this->minimum.x > this->maximum.x || this->minimum.y > this->maximum.y || this->minimum.z > this->maximum.z);
+		}
+
+		//----------
+		bool Bounds::isEverywhere() const {
+			return this->everywhereFlag;
+		}
+
+		//----------
+		void Bounds::add(const ofVec3f & point) {
+			this->minimum.x = std::min(this->minimum.x, point.x);
+			this->minimum.y = std::min(this->minimum.y, point.y);
+			this->minimum.z = std::min(this->minimum.z, point.z);
+			this->maximum.x = std::max(this->maximum.x, point.x);
+			this->maximum.y = std::max(this->maximum.y, point.y);
+			this->maximum.z = std::max(this->maximum.z, point.z);
+		}
+
+		//----------
+		void Bounds::add(const Bounds & other) {
+			if (other.everywhereFlag) {
+				*this = other;
+			}
+			else if (!other.isEmpty() && !this->everywhereFlag) {
+				this->add(other.minimum);
+				this->add(other.maximum);
+			}
+		}
+
+		//----------
+		Bounds Bounds::getTransformed(const ofMatrix4x4 & transform) const {
+			if (this->isEmpty() || this->everywhereFlag) {
+				return *this;
+			}
+			Bounds transformed;
+			for (int i = 0; i < 8; i++) {
+				const ofVec3f corner(i & 1 ? this->maximum.x : this->minimum.x,
+					i & 2 ? this->maximum.y : this->minimum.y,
+					i & 4 ? this->maximum.z : this->minimum.z);
+				transformed.add(corner * transform);
+			}
+			return transformed;
+		}
+
+		//----------
+		const ofVec3f & Bounds::getMinimum() const {
+			return this->minimum;
+		}
+
+		//----------
+		const ofVec3f & Bounds::getMaximum() const {
+			return this->maximum;
+		}
+
+#pragma mark Frustum
+		//----------
+		Frustum::Frustum(const ofMatrix4x4 & viewProjection) {
+			//with row vectors, clip space coordinate j is the dot product of the point with column j
+			auto column = [&viewProjection](int j) {
+				return ofVec4f(viewProjection(0, j), viewProjection(1, j), viewProjection(2, j), viewProjection(3, j));
+			};
+			const auto x = column(0);
+			const auto y = column(1);
+			const auto z = column(2);
+			const auto w = column(3);
+
+			this->planes[0] = w + x; // left
+			this->planes[1] = w - x; // right
+			this->planes[2] = w + y; // bottom
+			this->planes[3] = w - y; // top
+			this->planes[4] = w + z; // near
+			this->planes[5] = w - z; // far
+		}
+
+		//----------
+		bool Frustum::intersects(const Bounds & bounds) const {
+			if (bounds.isEverywhere()) {
+				return true;
+			}
+			if (bounds.isEmpty()) {
+				return false;
+			}
+
+			const auto & minimum = bounds.getMinimum();
+			const auto & maximum = bounds.getMaximum();
+			for (const auto & plane : this->planes) {
+				//the corner furthest along the plane's normal
+				const auto x = plane.x > 0.0f ? maximum.x : minimum.x;
+				const auto y = plane.y > 0.0f ? maximum.y : minimum.y;
+				const auto z = plane.z > 0.0f ? maximum.z : minimum.z;
+				if (plane.x * x + plane.y * y + plane.z * z + plane.w < 0.0f) {
+					return false;
+				}
+			}
+			return true;
+		}
+	}
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "ofVec3f.h"
+#include "ofVec4f.h"
+#include "ofMatrix4x4.h"
+
+#include <vector>
+
+namespace ofxRulr {
+	namespace Utils {
+		/**
+		Axis aligned box in world space.
+		A default constructed Bounds is empty (contains nothing). Use Bounds::everywhere() for content which should never be culled.
+		**/
+		class Bounds {
+		public:
+			Bounds();
+			Bounds(const ofVec3f & minimum, const ofVec3f & maximum);
+			static Bounds everywhere();
+			static Bounds fromPoints(const std::vector<ofVec3f> &);
+
+			bool isEmpty() const;
+			bool isEverywhere() const;
+
+			void add(const ofVec3f &);
+			void add(const Bounds &);
+
+			///Bounds of the 8 corners after transforming by a matrix (e.g. a rigid body's transform)
+			Bounds getTransformed(const ofMatrix4x4 &) const;
+
+			const ofVec3f & getMinimum() const;
+			const ofVec3f & getMaximum() const;
+		protected:
+			ofVec3f minimum;
+			ofVec3f maximum;
+			bool everywhereFlag;
+		};
+
+		/**
+		The 6 planes of a view frustum, for culling Bounds before drawing.
+		Built from a view * projection matrix in openFrameworks' row vector convention,
+		e.g. ofCamera::getModelViewProjectionMatrix() or ofxRay::Camera's getViewMatrix() * getClippedProjectionMatrix().
+		**/
+		class Frustum {
+		public:
+			Frustum(const ofMatrix4x4 & viewProjection);
+
+			///Conservative : may return true for some boxes which are just outside the frustum near its corners
+			bool intersects(const Bounds &) const;
+		protected:
+			ofVec4f planes[6];
+		};
+	}
+}
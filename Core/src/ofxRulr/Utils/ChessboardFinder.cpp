@@ -0,0 +1,150 @@
+#include "ChessboardFinder.h"
+
+#include <opencv2/imgproc/imgproc.hpp>
+#include <opencv2/calib3d/calib3d.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+//squares smaller than this at the search level are not found reliably
+#define RULR_CHESSBOARD_FINDER_MIN_SQUARE_SIZE 12.0f
+#define RULR_CHESSBOARD_FINDER_MAX_LEVEL 6
+#define RULR_CHESSBOARD_FINDER_MIN_LEVEL_SIZE 64
+
+namespace ofxRulr {
+	namespace Utils {
+		//----------
+		ChessboardFinder::ChessboardFinder() {
+			this->searchWidth = 1024;
+			this->lastSearchLevel = 0;
+			this->lastSquareSize = 0.0f;
+		}
+
+		//----------
+		bool ChessboardFinder::find(const cv::Mat & image, const cv::Size & boardSize, std::vector<cv::Point2f> & corners, bool mirrored) {
+			corners.clear();
+			if (image.empty()) {
+				return false;
+			}
+
+			//the full resolution level (only copied if we need to convert it)
+			switch (image.channels()) {
+			case 3:
+				cv::cvtColor(image, this->grayscale, CV_RGB2GRAY);
+				break;
+			case 4:
+				cv::cvtColor(image, this->grayscale, CV_RGBA2GRAY);
+				break;
+			default:
+				this->grayscale = image;
+				break;
+			}
+
+			//build the levels we need. pyrDown reuses the existing buffers when the size is unchanged
+			const auto level = this->chooseSearchLevel(this->grayscale.size());
+			this->pyramid.resize(std::max((int) this->pyramid.size(), level + 1));
+			this->pyramid[0] = this->grayscale;
+			for (int i = 1; i <= level; i++) {
+				cv::pyrDown(this->pyramid[i - 1], this->pyramid[i]);
+			}
+
+			//search at the chosen level, then one finer in case the board has become smaller since the last detection
+			const auto finestLevel = std::max(level - 1, 0);
+			for (int searchLevel = level; searchLevel >= finestLevel; searchLevel--) {
+				if (this->findAtLevel(searchLevel, boardSize, corners, mirrored)) {
+					return true;
+				}
+			}
+
+			this->lastSquareSize = 0.0f;
+			return false;
+		}
+
+		//----------
+		void ChessboardFinder::reset() {
+			this->lastSquareSize = 0.0f;
+		}
+
+		//----------
+		void ChessboardFinder::setSearchWidth(int searchWidth) {
+			this->searchWidth = std::max(searchWidth, RULR_CHESSBOARD_FINDER_MIN_LEVEL_SIZE);
+		}
+
+		//----------
+		int ChessboardFinder::getSearchWidth() const {
+			return this->searchWidth;
+		}
+
+		//----------
+		int ChessboardFinder::getLastSearchLevel() const {
+			return this->lastSearchLevel;
+		}
+
+		//----------
+		float ChessboardFinder::getLastSquareSize() const {
+			return this->lastSquareSize;
+		}
+
+		//----------
+		int ChessboardFinder::chooseSearchLevel(const cv::Size & imageSize) const {
+			int level;
+			if (this->lastSquareSize > 0.0f) {
+				//size the search from the last detection
+				level = (int) std::floor(std::log2(this->lastSquareSize / RULR_CHESSBOARD_FINDER_MIN_SQUARE_SIZE));
+			}
+			else {
+				//round up so that the searched level is never wider than the search width
+				level = (int) std::ceil(std::log2((float) imageSize.width / (float) this->searchWidth));
+			}
+
+			//don't go so coarse that the image becomes tiny
+			auto smallestSide = std::min(imageSize.width, imageSize.height);
+			auto maxLevel = 0;
+			while (maxLevel < RULR_CHESSBOARD_FINDER_MAX_LEVEL && (smallestSide >> (maxLevel + 1)) >= RULR_CHESSBOARD_FINDER_MIN_LEVEL_SIZE) {
+				maxLevel++;
+			}
+
+			return std::max(0, std::min(level, maxLevel));
+		}
+
+		//----------
+		bool ChessboardFinder::findAtLevel(int level, const cv::Size & boardSize, std::vector<cv::Point2f> & corners, bool mirrored) {
+			auto & levelImage = this->pyramid[level];
+			auto & searchImage = mirrored ? this->mirroredLevel : levelImage;
+			if (mirrored) {
+				cv::flip(levelImage, this->mirroredLevel, 1);
+			}
+
+			if (!cv::findChessboardCorners(searchImage, boardSize, corners, CV_CALIB_CB_ADAPTIVE_THRESH | CV_CALIB_CB_NORMALIZE_IMAGE | CV_CALIB_CB_FAST_CHECK)) {
+				corners.clear();
+				return false;
+			}
+
+			//pyrDown samples the even pixels, so a pixel at this level lands on (x * scale) at full resolution
+			const auto scale = (float) (1 << level);
+			const auto levelWidth = (float) levelImage.cols;
+			for (auto & corner : corners) {
+				if (mirrored) {
+					corner.x = levelWidth - 1.0f - corner.x;
+				}
+				corner *= scale;
+			}
+
+			//size of a square at full resolution, measured along the first row
+			const auto rowSpan = corners[boardSize.width - 1] - corners[0];
+			const auto squareSize = std::sqrt(rowSpan.dot(rowSpan)) / (float) std::max(boardSize.width - 1, 1);
+
+			//the window must cover the error of the coarse level, but stay inside a square
+			const auto windowSize = (int) std::max(std::min(2.0f * scale, 0.4f * squareSize), 3.0f);
+			cv::cornerSubPix(this->grayscale
+				, corners
+				, cv::Size(windowSize, windowSize)
+				, cv::Size(-1, -1)
+				, cv::TermCriteria(cv::TermCriteria::EPS + cv::TermCriteria::COUNT, 40, 0.01));
+
+			this->lastSearchLevel = level;
+			this->lastSquareSize = squareSize;
+			return true;
+		}
+	}
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <opencv2/core/core.hpp>
+
+#include <vector>
+
+namespace ofxRulr {
+	namespace Utils {
+		/**
+		Finds checkerboard corners by searching a downsampled level of an image pyramid, then refining the corners with cornerSubPix on the full resolution image.
+		The level is chosen so that the board's squares are just large enough to be found reliably, using the square size of the last detection
+		(or the search width when there is no previous detection). The pyramid buffers are kept between calls, so use one finder per image stream.
+		**/
+		class ChessboardFinder {
+		public:
+			ChessboardFinder();
+
+			///image may be grayscale, RGB or RGBA. boardSize is the count of inner corners.
+			///If mirrored is true, the search runs on a horizontally flipped image (so the corner ordering matches that of a mirrored camera),
+			///but the corners are returned in the coordinates of the image passed in.
+			bool find(const cv::Mat & image, const cv::Size & boardSize, std::vector<cv::Point2f> & corners, bool mirrored = false);
+
+			///Forget the square size of the last detection
+			void reset();
+
+			///Image width to search at when there is no previous detection to size the search from
+			void setSearchWidth(int);
+			int getSearchWidth() const;
+
+			int getLastSearchLevel() const;
+			float getLastSquareSize() const; // [px] at full resolution, or 0 if the last search failed
+		protected:
+			int chooseSearchLevel(const cv::Size & imageSize) const;
+			bool findAtLevel(int level, const cv::Size & boardSize, std::vector<cv::Point2f> & corners, bool mirrored);
+
+			cv::Mat grayscale;
+			std::vector<cv::Mat> pyramid;
+			cv::Mat mirroredLevel;
+
+			int searchWidth;
+			int lastSearchLevel;
+			float lastSquareSize;
+		};
+	}
+}
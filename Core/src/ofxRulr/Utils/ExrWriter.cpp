@@ -0,0 +1,179 @@
+#include "ExrWriter.h"
+
+#include "ofxRulr/Exception.h"
+#include "ofxRulr/Utils/Constants.h"
+
+#include "ofUtils.h"
+
+#include <stdint.h>
+
+namespace ofxRulr {
+	namespace Utils {
+		//----------
+		template<typename T>
+		static void writeValue(std::ofstream & file, const T & value) {
+			file.write((const char *)&value, sizeof(T));
+		}
+
+		//----------
+		static void writeAttribute(std::ofstream & file, const std::string & name, const std::string & type, const std::string & value) {
+			file.write(name.c_str(), name.size() + 1);
+			file.write(type.c_str(), type.size() + 1);
+			writeValue<int32_t>(file, (int32_t)value.size());
+			file.write(value.data(), value.size());
+		}
+
+		//----------
+		template<typename T>
+		static void appendValue(std::string & data, const T & value) {
+			data.append((const char *)&value, sizeof(T));
+		}
+
+		//----------
+		ExrWriter::ExrWriter() {
+			this->width = 0;
+			this->height = 0;
+			this->channels = 0;
+			this->rowsWritten = 0;
+		}
+
+		//----------
+		ExrWriter::~ExrWriter() {
+			if (this->file.is_open()) {
+				this->file.close();
+			}
+		}
+
+		//----------
+		void ExrWriter::open(const std::string & filename, int width, int height, int channels) {
+			if (channels != 3 && channels != 4) {
+				throw(Exception("ExrWriter supports RGB or RGBA images only"));
+			}
+			if (width <= 0 || height <= 0) {
+				throw(Exception("ExrWriter cannot write an empty image"));
+			}
+
+			this->close();
+			this->file.open(ofToDataPath(filename).c_str(), std::ios::binary | std::ios::out | std::ios::trunc);
+			if (!this->file.is_open()) {
+				throw(Exception("Couldn't open " + filename + " for writing"));
+			}
+
+			this->filename = filename;
+			this->width = width;
+			this->height = height;
+			this->channels = channels;
+			this->rowsWritten = 0;
+			this->planarRow.resize(width * channels);
+
+			//magic number and version 2 (single part scanline)
+			writeValue<int32_t>(this->file, 20000630);
+			writeValue<int32_t>(this->file, 2);
+
+			//channels are stored in alphabetical order
+			std::string channelList;
+			const char * channelNames = channels == 4 ? "ABGR" : "BGR";
+			for (int i = 0; i < channels; i++) {
+				channelList.push_back(channelNames[i]);
+				channelList.push_back('\0');
+				appendValue<int32_t>(channelList, 2); // FLOAT
+				appendValue<int32_t>(channelList, 0); // pLinear + reserved
+				appendValue<int32_t>(channelList, 1); // xSampling
+				appendValue<int32_t>(channelList, 1); // ySampling
+			}
+			channelList.push_back('\0');
+			writeAttribute(this->file, "channels", "chlist", channelList);
+
+			writeAttribute(this->file, "compression", "compression", std::string(1, '\0'));
+
+			std::string window;
+			appendValue<int32_t>(window, 0);
+			appendValue<int32_t>(window, 0);
+			appendValue<int32_t>(window, width - 1);
+			appendValue<int32_t>(window, height - 1);
+			writeAttribute(this->file, "dataWindow", "box2i", window);
+			writeAttribute(this->file, "displayWindow", "box2i", window);
+
+			writeAttribute(this->file, "lineOrder", "lineOrder", std::string(1, '\0'));
+
+			std::string one;
+			appendValue<float>(one, 1.0f);
+			writeAttribute(this->file, "pixelAspectRatio", "float", one);
+
+			std::string center;
+			appendValue<float>(center, 0.0f);
+			appendValue<float>(center, 0.0f);
+			writeAttribute(this->file, "screenWindowCenter", "v2f", center);
+			writeAttribute(this->file, "screenWindowWidth", "float", one);
+
+			//end of header
+			this->file.put('\0');
+
+			//offset table. each uncompressed chunk is one scanline of a fixed size, so we can write this up front
+			const uint64_t rowDataSize = (uint64_t)width * channels * sizeof(float);
+			const uint64_t chunkSize = sizeof(int32_t) * 2 + rowDataSize;
+			const uint64_t firstChunk = (uint64_t) this->file.tellp() + sizeof(uint64_t) * height;
+			for (int y = 0; y < height; y++) {
+				writeValue<uint64_t>(this->file, firstChunk + chunkSize * y);
+			}
+		}
+
+		//----------
+		void ExrWriter::writeRows(const float * interleavedPixels, int rowCount) {
+			if (!this->isOpen()) {
+				throw(Exception("ExrWriter is not open"));
+			}
+			if (this->rowsWritten + rowCount > this->height) {
+				throw(Exception("ExrWriter was given more rows than the image height"));
+			}
+
+			//input channel for each channel in file order (A, B, G, R or B, G, R)
+			const int alphabeticalRGBA[] = { 3, 2, 1, 0 };
+			const int alphabeticalRGB[] = { 2, 1, 0 };
+			const auto inputChannelForFileChannel = this->channels == 4 ? alphabeticalRGBA : alphabeticalRGB;
+
+			const auto rowDataSize = (int32_t)(this->width * this->channels * sizeof(float));
+			for (int row = 0; row < rowCount; row++) {
+				auto input = interleavedPixels + row * this->width * this->channels;
+				auto output = this->planarRow.data();
+				for (int fileChannel = 0; fileChannel < this->channels; fileChannel++) {
+					const auto inputChannel = inputChannelForFileChannel[fileChannel];
+					for (int x = 0; x < this->width; x++) {
+						*output++ = input[x * this->channels + inputChannel];
+					}
+				}
+
+				writeValue<int32_t>(this->file, this->rowsWritten);
+				writeValue<int32_t>(this->file, rowDataSize);
+				this->file.write((const char *) this->planarRow.data(), rowDataSize);
+				this->rowsWritten++;
+			}
+
+			if (!this->file.good()) {
+				throw(Exception("Failed to write to " + this->filename));
+			}
+		}
+
+		//----------
+		void ExrWriter::close() {
+			if (!this->file.is_open()) {
+				return;
+			}
+			this->file.close();
+			if (this->rowsWritten != this->height) {
+				RULR_WARNING << this->filename << " was closed after " << this->rowsWritten << " of " << this->height << " rows";
+			}
+			this->planarRow.clear();
+		}
+
+		//----------
+		bool ExrWriter::isOpen() const {
+			return this->file.is_open();
+		}
+
+		//----------
+		int ExrWriter::getRowsWritten() const {
+			return this->rowsWritten;
+		}
+	}
+}
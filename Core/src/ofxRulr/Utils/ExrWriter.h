@@ -0,0 +1,36 @@
+#pragma once
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace ofxRulr {
+	namespace Utils {
+		/**
+		Writes float OpenEXR images (uncompressed, scanline) a block of rows at a time,
+		so that images larger than we would want to hold in memory (or in an FBO) can be streamed to disk.
+		Rows are given as interleaved RGB or RGBA floats, top row first.
+		**/
+		class ExrWriter {
+		public:
+			ExrWriter();
+			~ExrWriter();
+
+			void open(const std::string & filename, int width, int height, int channels = 4);
+			void writeRows(const float * interleavedPixels, int rowCount);
+			void close();
+
+			bool isOpen() const;
+			int getRowsWritten() const;
+		protected:
+			std::ofstream file;
+			std::string filename;
+			int width;
+			int height;
+			int channels;
+			int rowsWritten;
+
+			std::vector<float> planarRow;
+		};
+	}
+}
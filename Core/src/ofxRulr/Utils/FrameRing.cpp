@@ -0,0 +1,161 @@
+#include "FrameRing.h"
+
+#include "ofUtils.h"
+
+#include <algorithm>
+
+namespace ofxRulr {
+	namespace Utils {
+#pragma mark Frame
+		//----------
+		FrameRing::Frame::Frame() :
+		frameIndex(0),
+		timestamp(0) {
+		}
+
+		//----------
+		uint64_t FrameRing::Frame::getFrameIndex() const {
+			return this->frameIndex;
+		}
+
+		//----------
+		uint64_t FrameRing::Frame::getTimestamp() const {
+			return this->timestamp;
+		}
+
+		//----------
+		const ofPixels & FrameRing::Frame::getPixels() const {
+			return this->pixels;
+		}
+
+		//----------
+		cv::Mat FrameRing::Frame::getMat() const {
+			if (!this->pixels.isAllocated()) {
+				return cv::Mat();
+			}
+			return cv::Mat(this->pixels.getHeight()
+				, this->pixels.getWidth()
+				, CV_MAKETYPE(CV_8U, this->pixels.getNumChannels())
+				, (void*) this->pixels.getPixels());
+		}
+
+#pragma mark FrameRing
+		//----------
+		FrameRing::FrameRing(size_t size) :
+		nextSlot(0),
+		nextFrameIndex(0) {
+			this->setSize(size);
+		}
+
+		//----------
+		void FrameRing::setSize(size_t size) {
+			std::lock_guard<std::mutex> lock(this->mutex);
+
+			//keep the newest frames, oldest first
+			std::vector<std::shared_ptr<Frame>> frames;
+			for (size_t i = 0; i < this->slots.size(); i++) {
+				const auto & slot = this->slots[(this->nextSlot + i) % this->slots.size()];
+				if (slot) {
+					frames.push_back(slot);
+				}
+			}
+			size = std::max<size_t>(size, 1);
+			if (frames.size() > size) {
+				frames.erase(frames.begin(), frames.end() - size);
+			}
+
+			this->slots.assign(size, nullptr);
+			std::copy(frames.begin(), frames.end(), this->slots.begin());
+			this->nextSlot = frames.size() % size;
+		}
+
+		//----------
+		size_t FrameRing::getSize() const {
+			std::lock_guard<std::mutex> lock(this->mutex);
+			return this->slots.size();
+		}
+
+		//----------
+		FrameRing::FramePtr FrameRing::push(const ofPixels & pixels) {
+			//take the oldest slot out of the ring, so that nobody can see it whilst we write to it
+			std::shared_ptr<Frame> frame;
+			size_t slotIndex;
+			{
+				std::lock_guard<std::mutex> lock(this->mutex);
+				slotIndex = this->nextSlot;
+				this->nextSlot = (this->nextSlot + 1) % this->slots.size();
+
+				auto & slot = this->slots[slotIndex];
+				if (slot && slot.use_count() == 1) {
+					//nobody else holds it, so we can reuse its buffer
+					frame = slot;
+				}
+				else {
+					frame = std::make_shared<Frame>();
+				}
+				slot.reset();
+
+				frame->frameIndex = this->nextFrameIndex++;
+			}
+
+			//ofPixels keeps its allocation when the size and format are unchanged
+			frame->pixels = pixels;
+			frame->timestamp = ofGetElapsedTimeMicros();
+
+			{
+				std::lock_guard<std::mutex> lock(this->mutex);
+				if (slotIndex < this->slots.size()) {
+					this->slots[slotIndex] = frame;
+				}
+			}
+			return frame;
+		}
+
+		//----------
+		FrameRing::FramePtr FrameRing::getLatestFrame() const {
+			std::lock_guard<std::mutex> lock(this->mutex);
+			std::shared_ptr<Frame> latest;
+			for (const auto & slot : this->slots) {
+				if (slot && (!latest || slot->frameIndex > latest->frameIndex)) {
+					latest = slot;
+				}
+			}
+			return latest;
+		}
+
+		//----------
+		FrameRing::FramePtr FrameRing::getFrame(uint64_t frameIndex) const {
+			std::lock_guard<std::mutex> lock(this->mutex);
+			for (const auto & slot : this->slots) {
+				if (slot && slot->frameIndex == frameIndex) {
+					return slot;
+				}
+			}
+			return nullptr;
+		}
+
+		//----------
+		std::vector<FrameRing::FramePtr> FrameRing::getFrames() const {
+			std::lock_guard<std::mutex> lock(this->mutex);
+			std::vector<FramePtr> frames;
+			for (const auto & slot : this->slots) {
+				if (slot) {
+					frames.push_back(slot);
+				}
+			}
+			std::sort(frames.begin(), frames.end(), [](const FramePtr & a, const FramePtr & b) {
+				return a->getFrameIndex() < b->getFrameIndex();
+			});
+			return frames;
+		}
+
+		//----------
+		void FrameRing::clear() {
+			std::lock_guard<std::mutex> lock(this->mutex);
+			for (auto & slot : this->slots) {
+				slot.reset();
+			}
+			this->nextSlot = 0;
+		}
+	}
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include "ofPixels.h"
+
+#include <opencv2/core/core.hpp>
+
+#include <memory>
+#include <mutex>
+#include <stdint.h>
+#include <vector>
+
+namespace ofxRulr {
+	namespace Utils {
+		/**
+		A ring of the most recent frames from an image stream, handed out as reference counted read only frames.
+		Each pushed image is copied once into a slot. Consumers can then hold a frame (on any thread, for as long as they like)
+		without locking anything and without copying, since a slot is only written to again once nobody else holds it.
+		If every slot is held when a new image arrives, a new buffer takes the oldest slot's place (the holders keep the old one).
+		**/
+		class FrameRing {
+		public:
+			class Frame {
+			public:
+				Frame();
+
+				uint64_t getFrameIndex() const; // increments with each push
+				uint64_t getTimestamp() const; // [us] ofGetElapsedTimeMicros() at the time of the push
+				const ofPixels & getPixels() const;
+
+				///A header onto the frame's pixels (no copy). The data must be treated as read only.
+				cv::Mat getMat() const;
+			protected:
+				friend FrameRing;
+				ofPixels pixels;
+				uint64_t frameIndex;
+				uint64_t timestamp;
+			};
+			typedef std::shared_ptr<const Frame> FramePtr;
+
+			FrameRing(size_t size = 4);
+
+			void setSize(size_t);
+			size_t getSize() const;
+
+			///Copies the pixels into the oldest slot and returns it as the latest frame. Call from one thread only (normally the main thread).
+			FramePtr push(const ofPixels &);
+
+			///Returns nullptr if nothing has been pushed (since the last clear).
+			FramePtr getLatestFrame() const;
+
+			///Returns nullptr if this frame has already left the ring.
+			FramePtr getFrame(uint64_t frameIndex) const;
+
+			///Oldest first
+			std::vector<FramePtr> getFrames() const;
+
+			void clear();
+		protected:
+			mutable std::mutex mutex;
+			std::vector<std::shared_ptr<Frame>> slots;
+			size_t nextSlot;
+			uint64_t nextFrameIndex;
+		};
+	}
+}
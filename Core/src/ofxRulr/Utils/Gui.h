@@ -1,11 +1,11 @@
-#pragma once
-
-#include "ofxCvGui.h"
-
-namespace ofxRulr {
-	namespace Utils {
-		namespace Gui {
-			shared_ptr<ofxCvGui::Widgets::Slider> addIntSlider(ofParameter<float> & parameter, ofxCvGui::ElementGroupPtr inspector);
-		}
-	}
+#pragma once
+
+#include "ofxCvGui.h"
+
+namespace ofxRulr {
+	namespace Utils {
+		namespace Gui {
+			shared_ptr<ofxCvGui::Widgets::Slider> addIntSlider(ofParameter<float> & parameter, ofxCvGui::ElementGroupPtr inspector);
+		}
+	}
 }
\ No newline at end of file
@@ -1,28 +1,28 @@
-#include "Initialiser.h"
-
-#include "ofxAssets.h"
-
-namespace ofxRulr {
-	namespace Utils {
-		//----------
-		Initialiser::Initialiser() {
-			this->initialised = false;
-		}
-
-		//----------
-		void Initialiser::checkInitialised() {
-			if (!this->initialised) {
-				this->initialise();
-				this->initialised = true;
-			}
-		}
-
-		//----------
-		void Initialiser::initialise() {
-			ofxAssets::Register::X().addAddon("ofxRulr");
-		}
-
-		//----------
-		Initialiser initialiser = Initialiser();
-	}
+#include "Initialiser.h"
+
+#include "ofxAssets.h"
+
+namespace ofxRulr {
+	namespace Utils {
+		//----------
+		Initialiser::Initialiser() {
+			this->initialised = false;
+		}
+
+		//----------
+		void Initialiser::checkInitialised() {
+			if (!this->initialised) {
+				this->initialise();
+				this->initialised = true;
+			}
+		}
+
+		//----------
+		void Initialiser::initialise() {
+			ofxAssets::Register::X().addAddon("ofxRulr");
+		}
+
+		//----------
+		Initialiser initialiser = Initialiser();
+	}
 }
\ No newline at end of file
@@ -1,16 +1,16 @@
-#pragma once
-
-namespace ofxRulr {
-	namespace Utils {
-		class Initialiser {
-		public:
-			Initialiser();
-			void checkInitialised();
-		protected:
-			void initialise();
-			bool initialised;
-		};
-
-		extern Initialiser initialiser;
-	}
+#pragma once
+
+namespace ofxRulr {
+	namespace Utils {
+		class Initialiser {
+		public:
+			Initialiser();
+			void checkInitialised();
+		protected:
+			void initialise();
+			bool initialised;
+		};
+
+		extern Initialiser initialiser;
+	}
 }
\ No newline at end of file
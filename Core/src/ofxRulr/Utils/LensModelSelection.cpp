@@ -0,0 +1,219 @@
+#include "LensModelSelection.h"
+
+#include "Parallel.h"
+#include "../Exception.h"
+
+#include <opencv2/calib3d/calib3d.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+namespace ofxRulr {
+	namespace Utils {
+		//----------
+		//sum of squared reprojection errors of a set of points
+		static double getSquaredError(const std::vector<cv::Point3f> & objectPoints, const std::vector<cv::Point2f> & imagePoints, const cv::Mat & rotation, const cv::Mat & translation, const cv::Mat & cameraMatrix, const cv::Mat & distortionCoefficients) {
+			std::vector<cv::Point2f> projected;
+			cv::projectPoints(objectPoints, rotation, translation, cameraMatrix, distortionCoefficients, projected);
+			double squaredError = 0.0;
+			for (size_t i = 0; i < projected.size(); i++) {
+				const auto delta = projected[i] - imagePoints[i];
+				squaredError += delta.dot(delta);
+			}
+			return squaredError;
+		}
+
+		//----------
+		std::vector<LensModelSelection::Model> LensModelSelection::getDefaultModels() {
+			std::vector<Model> models;
+			const int alwaysFixed = CV_CALIB_FIX_K3 | CV_CALIB_FIX_K4 | CV_CALIB_FIX_K5 | CV_CALIB_FIX_K6;
+			for (int radial = 0; radial < 2; radial++) {
+				for (int tangential = 0; tangential < 2; tangential++) {
+					for (int principalPoint = 0; principalPoint < 2; principalPoint++) {
+						Model model;
+						model.flags = alwaysFixed;
+						model.name = radial ? "K1-K2" : "K1";
+						if (!radial) {
+							model.flags |= CV_CALIB_FIX_K2;
+						}
+						if (tangential) {
+							model.name += ", tangential";
+						}
+						else {
+							model.flags |= CV_CALIB_ZERO_TANGENT_DIST;
+						}
+						if (principalPoint) {
+							model.name += ", fixed principal point";
+							model.flags |= CV_CALIB_FIX_PRINCIPAL_POINT;
+						}
+						models.push_back(model);
+					}
+				}
+			}
+			return models;
+		}
+
+		//----------
+		std::vector<LensModelSelection::Result> LensModelSelection::select(const std::vector<std::vector<cv::Point3f>> & objectPoints
+			, const std::vector<std::vector<cv::Point2f>> & imagePoints
+			, const cv::Size & imageSize
+			, const cv::Mat & cameraMatrix
+			, const cv::Mat & distortionCoefficients
+			, int baseFlags
+			, int foldCount
+			, const std::vector<Model> & models) {
+
+			const auto viewCount = objectPoints.size();
+			if (viewCount == 0 || viewCount != imagePoints.size()) {
+				throw(Exception("LensModelSelection needs matching sets of object and image points"));
+			}
+			foldCount = std::max(foldCount, 2);
+			const auto holdOutViews = viewCount >= (size_t) foldCount;
+
+			//initial distortion as k1, k2, p1, p2, k3
+			cv::Mat initialDistortion = cv::Mat::zeros(5, 1, CV_64F);
+			if (!distortionCoefficients.empty()) {
+				cv::Mat distortion;
+				distortionCoefficients.reshape(1, (int) distortionCoefficients.total()).convertTo(distortion, CV_64F);
+				for (int i = 0; i < std::min(distortion.rows, 5); i++) {
+					initialDistortion.at<double>(i) = distortion.at<double>(i);
+				}
+			}
+
+			struct FoldResult {
+				bool success;
+				double squaredError;
+				size_t pointCount;
+				std::string errorMessage;
+			};
+
+			std::vector<Result> results(models.size());
+			std::vector<FoldResult> foldResults(models.size() * foldCount);
+
+			//one job per model for the full fit, plus one per model per fold
+			const auto jobsPerModel = (size_t) foldCount + 1;
+			parallelFor(models.size() * jobsPerModel, [&](size_t begin, size_t end) {
+				for (auto job = begin; job < end; job++) {
+					const auto modelIndex = job / jobsPerModel;
+					const auto fold = (int) (job % jobsPerModel) - 1; // -1 is the full fit
+					const auto & model = models[modelIndex];
+					const auto flags = model.flags | baseFlags;
+
+					//start each model from the initial values, without the terms it doesn't have
+					cv::Mat fitCameraMatrix = cameraMatrix.clone();
+					cv::Mat fitDistortion = initialDistortion.clone();
+					if (flags & CV_CALIB_FIX_K1) {
+						fitDistortion.at<double>(0) = 0.0;
+					}
+					if (flags & CV_CALIB_FIX_K2) {
+						fitDistortion.at<double>(1) = 0.0;
+					}
+					if (flags & CV_CALIB_ZERO_TANGENT_DIST) {
+						fitDistortion.at<double>(2) = 0.0;
+						fitDistortion.at<double>(3) = 0.0;
+					}
+					if (flags & CV_CALIB_FIX_K3) {
+						fitDistortion.at<double>(4) = 0.0;
+					}
+
+					std::vector<cv::Mat> rotations, translations;
+					if (fold == -1) {
+						auto & result = results[modelIndex];
+						result.model = model;
+						try {
+							result.fitError = (float) cv::calibrateCamera(objectPoints, imagePoints, imageSize, fitCameraMatrix, fitDistortion, rotations, translations, flags);
+							result.cameraMatrix = fitCameraMatrix;
+							result.distortionCoefficients = fitDistortion;
+							result.rotations = rotations;
+							result.translations = translations;
+							result.success = true;
+						}
+						catch (const cv::Exception & e) {
+							result.success = false;
+							result.errorMessage = e.what();
+						}
+						continue;
+					}
+
+					auto & foldResult = foldResults[modelIndex * foldCount + fold];
+					foldResult.squaredError = 0.0;
+					foldResult.pointCount = 0;
+					try {
+						if (holdOutViews) {
+							//every foldCount'th view is held out
+							std::vector<std::vector<cv::Point3f>> trainObjectPoints;
+							std::vector<std::vector<cv::Point2f>> trainImagePoints;
+							for (size_t view = 0; view < viewCount; view++) {
+								if ((int) (view % foldCount) != fold) {
+									trainObjectPoints.push_back(objectPoints[view]);
+									trainImagePoints.push_back(imagePoints[view]);
+								}
+							}
+							cv::calibrateCamera(trainObjectPoints, trainImagePoints, imageSize, fitCameraMatrix, fitDistortion, rotations, translations, flags);
+
+							for (size_t view = fold; view < viewCount; view += foldCount) {
+								cv::Mat rotation, translation;
+								cv::solvePnP(objectPoints[view], imagePoints[view], fitCameraMatrix, fitDistortion, rotation, translation);
+								foldResult.squaredError += getSquaredError(objectPoints[view], imagePoints[view], rotation, translation, fitCameraMatrix, fitDistortion);
+								foldResult.pointCount += objectPoints[view].size();
+							}
+						}
+						else {
+							//every foldCount'th point of every view is held out
+							std::vector<std::vector<cv::Point3f>> trainObjectPoints(viewCount), testObjectPoints(viewCount);
+							std::vector<std::vector<cv::Point2f>> trainImagePoints(viewCount), testImagePoints(viewCount);
+							for (size_t view = 0; view < viewCount; view++) {
+								for (size_t point = 0; point < objectPoints[view].size(); point++) {
+									const auto heldOut = (int) (point % foldCount) == fold;
+									(heldOut ? testObjectPoints : trainObjectPoints)[view].push_back(objectPoints[view][point]);
+									(heldOut ? testImagePoints : trainImagePoints)[view].push_back(imagePoints[view][point]);
+								}
+							}
+							cv::calibrateCamera(trainObjectPoints, trainImagePoints, imageSize, fitCameraMatrix, fitDistortion, rotations, translations, flags);
+
+							for (size_t view = 0; view < viewCount; view++) {
+								if (!testObjectPoints[view].empty()) {
+									foldResult.squaredError += getSquaredError(testObjectPoints[view], testImagePoints[view], rotations[view], translations[view], fitCameraMatrix, fitDistortion);
+									foldResult.pointCount += testObjectPoints[view].size();
+								}
+							}
+						}
+						foldResult.success = true;
+					}
+					catch (const cv::Exception & e) {
+						foldResult.success = false;
+						foldResult.errorMessage = e.what();
+					}
+				}
+			}, 1);
+
+			//a model only scores if its full fit and all of its folds succeeded
+			for (size_t modelIndex = 0; modelIndex < models.size(); modelIndex++) {
+				auto & result = results[modelIndex];
+				double squaredError = 0.0;
+				size_t pointCount = 0;
+				for (int fold = 0; fold < foldCount; fold++) {
+					const auto & foldResult = foldResults[modelIndex * foldCount + fold];
+					if (!foldResult.success) {
+						if (result.success) {
+							result.success = false;
+							result.errorMessage = "Fold " + std::to_string(fold) + " failed : " + foldResult.errorMessage;
+						}
+						continue;
+					}
+					squaredError += foldResult.squaredError;
+					pointCount += foldResult.pointCount;
+				}
+				result.crossValidationError = pointCount > 0 ? (float) std::sqrt(squaredError / (double) pointCount) : 0.0f;
+			}
+
+			std::stable_sort(results.begin(), results.end(), [](const Result & a, const Result & b) {
+				if (a.success != b.success) {
+					return a.success;
+				}
+				return a.crossValidationError < b.crossValidationError;
+			});
+			return results;
+		}
+	}
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <opencv2/core/core.hpp>
+
+#include <string>
+#include <vector>
+
+namespace ofxRulr {
+	namespace Utils {
+		/**
+		Fits a set of candidate lens models (calibration flag sets) with cv::calibrateCamera, all at once across the cores,
+		and scores each by k-fold cross validated reprojection error.
+		With at least as many views as folds, whole views are held out (and posed with solvePnP against the intrinsics fitted without them).
+		Otherwise individual points are held out of every view.
+		**/
+		class LensModelSelection {
+		public:
+			struct Model {
+				std::string name;
+				int flags;
+			};
+
+			struct Result {
+				Model model;
+				bool success;
+				float fitError; // [px] RMS over all points
+				float crossValidationError; // [px] RMS over held out points
+				cv::Mat cameraMatrix;
+				cv::Mat distortionCoefficients; // k1, k2, p1, p2, k3
+				std::vector<cv::Mat> rotations;
+				std::vector<cv::Mat> translations;
+				std::string errorMessage;
+			};
+
+			///K1 or K1-K2 radial, with or without tangential, with a free or fixed principal point.
+			///Higher order terms are always fixed, since Item::View stores k1, k2, p1, p2.
+			static std::vector<Model> getDefaultModels();
+
+			///Returns one result per model, the best (lowest cross validation error) first and failed fits last.
+			///baseFlags are added to every model (e.g. CV_CALIB_USE_INTRINSIC_GUESS), and cameraMatrix / distortionCoefficients are the initial values.
+			static std::vector<Result> select(const std::vector<std::vector<cv::Point3f>> & objectPoints
+				, const std::vector<std::vector<cv::Point2f>> & imagePoints
+				, const cv::Size & imageSize
+				, const cv::Mat & cameraMatrix
+				, const cv::Mat & distortionCoefficients
+				, int baseFlags
+				, int foldCount
+				, const std::vector<Model> & models = getDefaultModels());
+		};
+	}
+}
@@ -0,0 +1,72 @@
+#include "Parallel.h"
+
+#include <opencv2/core/core.hpp>
+
+#include <exception>
+#include <mutex>
+
+namespace ofxRulr {
+	namespace Utils {
+		//----------
+		class ParallelRangeBody : public cv::ParallelLoopBody {
+		public:
+			ParallelRangeBody(size_t count, size_t rangeSize, const std::function<void(size_t, size_t)> & body) :
+				count(count),
+				rangeSize(rangeSize),
+				body(body) {
+			}
+
+			void operator()(const cv::Range & blocks) const override {
+				for (int block = blocks.start; block < blocks.end; block++) {
+					auto begin = (size_t)block * this->rangeSize;
+					auto end = std::min(begin + this->rangeSize, this->count);
+					try {
+						this->body(begin, end);
+					}
+					catch (...) {
+						std::lock_guard<std::mutex> lock(this->exceptionLock);
+						if (!this->exception) {
+							this->exception = std::current_exception();
+						}
+					}
+				}
+			}
+
+			void rethrowIfFailed() const {
+				if (this->exception) {
+					std::rethrow_exception(this->exception);
+				}
+			}
+		protected:
+			const size_t count;
+			const size_t rangeSize;
+			const std::function<void(size_t, size_t)> & body;
+
+			mutable std::mutex exceptionLock;
+			mutable std::exception_ptr exception;
+		};
+
+		//----------
+		void parallelFor(size_t count, const std::function<void(size_t begin, size_t end)> & body, size_t rangeSize) {
+			if (count == 0) {
+				return;
+			}
+			rangeSize = std::max<size_t>(rangeSize, 1);
+			const auto blockCount = (count + rangeSize - 1) / rangeSize;
+
+			if (blockCount == 1) {
+				body(0, count);
+				return;
+			}
+
+			ParallelRangeBody parallelBody(count, rangeSize, body);
+			cv::parallel_for_(cv::Range(0, (int)blockCount), parallelBody);
+			parallelBody.rethrowIfFailed();
+		}
+
+		//----------
+		int getThreadCount() {
+			return cv::getNumThreads();
+		}
+	}
+}
@@ -0,0 +1,14 @@
+#pragma once
+
+#include <functional>
+
+namespace ofxRulr {
+	namespace Utils {
+		///Calls body(begin, end) over ranges which cover [0, count), spread across all cores.
+		///Returns once every range is complete. The first exception thrown by the body is rethrown on the calling thread.
+		void parallelFor(size_t count, const std::function<void(size_t begin, size_t end)> & body, size_t rangeSize = 4096);
+
+		///Number of threads which parallelFor will use
+		int getThreadCount();
+	}
+}
@@ -0,0 +1,297 @@
+#include "PlyReader.h"
+
+#include "ofxRulr/Exception.h"
+#include "ofxRulr/Utils/Parallel.h"
+
+#include "ofMesh.h"
+#include "ofUtils.h"
+
+#include "Poco/File.h"
+
+#include <algorithm>
+#include <sstream>
+#include <stdint.h>
+
+namespace ofxRulr {
+	namespace Utils {
+		//----------
+		template<typename T>
+		static float readAs(const char * data) {
+			T value;
+			memcpy(&value, data, sizeof(T));
+			return (float)value;
+		}
+
+		//----------
+		PlyReader::PlyReader() {
+			this->close();
+		}
+
+		//----------
+		void PlyReader::open(const std::string & filename) {
+			this->close();
+
+			auto path = ofToDataPath(filename);
+			Poco::File file(path);
+			if (!file.exists()) {
+				throw(Exception(filename + " does not exist"));
+			}
+
+			this->mapping = Poco::SharedMemory(file, Poco::SharedMemory::AM_READ);
+			const auto begin = this->mapping.begin();
+			const auto end = this->mapping.end();
+
+			//find the end of the header
+			const std::string endHeader = "end_header";
+			auto headerEnd = std::search(begin, end, endHeader.begin(), endHeader.end());
+			if (headerEnd == end) {
+				this->close();
+				throw(Exception(filename + " is not a PLY file"));
+			}
+			auto dataBegin = headerEnd + endHeader.size();
+			while (dataBegin != end && (*dataBegin == '\r' || *dataBegin == ' ')) {
+				dataBegin++;
+			}
+			if (dataBegin == end || *dataBegin != '\n') {
+				this->close();
+				throw(Exception(filename + " has a malformed PLY header"));
+			}
+			dataBegin++;
+
+			auto getTypeSize = [](Type type) -> size_t {
+				const size_t sizes[] = { 1, 1, 2, 2, 4, 4, 4, 8 };
+				return sizes[type];
+			};
+			auto parseType = [](const std::string & name, Type & type) -> bool {
+				const std::pair<const char *, Type> names[] = {
+					{ "char", Int8 }, { "int8", Int8 },
+					{ "uchar", UInt8 }, { "uint8", UInt8 },
+					{ "short", Int16 }, { "int16", Int16 },
+					{ "ushort", UInt16 }, { "uint16", UInt16 },
+					{ "int", Int32 }, { "int32", Int32 },
+					{ "uint", UInt32 }, { "uint32", UInt32 },
+					{ "float", Float32 }, { "float32", Float32 },
+					{ "double", Float64 }, { "float64", Float64 }
+				};
+				for (const auto & entry : names) {
+					if (name == entry.first) {
+						type = entry.second;
+						return true;
+					}
+				}
+				return false;
+			};
+			auto parseField = [](const std::string & name) -> int {
+				const std::pair<const char *, Field> names[] = {
+					{ "x", X }, { "y", Y }, { "z", Z },
+					{ "red", Red }, { "green", Green }, { "blue", Blue }, { "alpha", Alpha },
+					{ "diffuse_red", Red }, { "diffuse_green", Green }, { "diffuse_blue", Blue }, { "diffuse_alpha", Alpha },
+					{ "u", U }, { "v", V }, { "s", U }, { "t", V }, { "texture_u", U }, { "texture_v", V }
+				};
+				for (const auto & entry : names) {
+					if (name == entry.first) {
+						return entry.second;
+					}
+				}
+				return -1;
+			};
+
+			//parse the header. any fixed size elements before the vertices are skipped over
+			std::istringstream header(std::string(begin, headerEnd));
+			std::string line;
+			std::string currentElement;
+			size_t currentElementCount = 0;
+			size_t currentElementSize = 0;
+			bool currentElementHasList = false;
+			size_t skipBeforeVertices = 0;
+			bool foundVertices = false;
+
+			auto finishElement = [&]() {
+				if (currentElement == "vertex") {
+					this->vertexCount = currentElementCount;
+					this->recordSize = currentElementSize;
+					foundVertices = true;
+				}
+				else if (!foundVertices && !currentElement.empty()) {
+					if (currentElementHasList && currentElementCount > 0) {
+						throw(Exception("Elements with list properties before the vertices are not supported"));
+					}
+					skipBeforeVertices += currentElementCount * currentElementSize;
+				}
+			};
+
+			try {
+				bool isPly = false;
+				while (std::getline(header, line)) {
+					std::istringstream words(line);
+					std::string keyword;
+					words >> keyword;
+
+					if (keyword == "ply") {
+						isPly = true;
+					}
+					else if (keyword == "format") {
+						std::string format;
+						words >> format;
+						if (format != "binary_little_endian") {
+							throw(Exception("Only binary little endian PLY files can be memory mapped (this file is " + format + ")"));
+						}
+					}
+					else if (keyword == "element") {
+						finishElement();
+						words >> currentElement >> currentElementCount;
+						currentElementSize = 0;
+						currentElementHasList = false;
+					}
+					else if (keyword == "property") {
+						std::string typeName, name;
+						words >> typeName >> name;
+						if (typeName == "list") {
+							if (currentElement == "vertex") {
+								throw(Exception("List properties on vertices are not supported"));
+							}
+							//elements with lists have no fixed size, so we can't skip over them
+							currentElementHasList = true;
+							continue;
+						}
+
+						Type type;
+						if (!parseType(typeName, type)) {
+							throw(Exception("Unknown PLY property type " + typeName));
+						}
+						if (currentElement == "vertex") {
+							auto field = parseField(name);
+							if (field >= 0) {
+								this->fields[field].offset = (int)currentElementSize;
+								this->fields[field].type = type;
+							}
+						}
+						currentElementSize += getTypeSize(type);
+					}
+				}
+				finishElement();
+
+				if (!isPly) {
+					throw(Exception("Missing PLY magic"));
+				}
+				if (!foundVertices) {
+					throw(Exception("No vertex element"));
+				}
+				if (this->fields[X].offset < 0 || this->fields[Y].offset < 0 || this->fields[Z].offset < 0) {
+					throw(Exception("Vertices have no position"));
+				}
+
+				const auto dataOffset = (size_t)(dataBegin - begin) + skipBeforeVertices;
+				if (dataOffset + this->vertexCount * this->recordSize > (size_t)(end - begin)) {
+					throw(Exception("File is shorter than its header declares"));
+				}
+				this->vertexData = begin + dataOffset;
+			}
+			catch (const Exception & e) {
+				this->close();
+				throw(Exception(filename + " : " + e.what()));
+			}
+
+			this->filename = filename;
+		}
+
+		//----------
+		void PlyReader::close() {
+			this->mapping = Poco::SharedMemory();
+			this->filename = "";
+			this->vertexData = nullptr;
+			this->vertexCount = 0;
+			this->recordSize = 0;
+			for (int i = 0; i < FieldCount; i++) {
+				this->fields[i].offset = -1;
+				this->fields[i].type = Float32;
+			}
+		}
+
+		//----------
+		bool PlyReader::isOpen() const {
+			return this->vertexData != nullptr;
+		}
+
+		//----------
+		size_t PlyReader::getVertexCount() const {
+			return this->vertexCount;
+		}
+
+		//----------
+		bool PlyReader::getHasColors() const {
+			return this->fields[Red].offset >= 0 && this->fields[Green].offset >= 0 && this->fields[Blue].offset >= 0;
+		}
+
+		//----------
+		bool PlyReader::getHasTexCoords() const {
+			return this->fields[U].offset >= 0 && this->fields[V].offset >= 0;
+		}
+
+		//----------
+		void PlyReader::read(ofMesh & mesh) const {
+			if (!this->isOpen()) {
+				throw(Exception("PlyReader is not open"));
+			}
+
+			const auto hasColors = this->getHasColors();
+			const auto hasAlpha = this->fields[Alpha].offset >= 0;
+			const auto hasTexCoords = this->getHasTexCoords();
+
+			auto & vertices = mesh.getVertices();
+			auto & colors = mesh.getColors();
+			auto & texCoords = mesh.getTexCoords();
+			mesh.clear();
+			mesh.setMode(OF_PRIMITIVE_POINTS);
+			vertices.resize(this->vertexCount);
+			colors.resize(hasColors ? this->vertexCount : 0);
+			texCoords.resize(hasTexCoords ? this->vertexCount : 0);
+
+			auto readField = [this](const char * record, Field field) -> float {
+				const auto & property = this->fields[field];
+				const auto data = record + property.offset;
+				switch (property.type) {
+				case Int8: return readAs<int8_t>(data);
+				case UInt8: return readAs<uint8_t>(data);
+				case Int16: return readAs<int16_t>(data);
+				case UInt16: return readAs<uint16_t>(data);
+				case Int32: return readAs<int32_t>(data);
+				case UInt32: return readAs<uint32_t>(data);
+				case Float64: return readAs<double>(data);
+				case Float32:
+				default:
+					return readAs<float>(data);
+				}
+			};
+
+			//integer colors are 0..255, float colors are 0..1
+			auto colorScale = [this](Field field) -> float {
+				return this->fields[field].type == Float32 || this->fields[field].type == Float64 ? 1.0f : 1.0f / 255.0f;
+			};
+			const float colorScales[] = { colorScale(Red), colorScale(Green), colorScale(Blue), colorScale(Alpha) };
+
+			parallelFor(this->vertexCount, [&](size_t begin, size_t end) {
+				for (size_t i = begin; i < end; i++) {
+					const auto record = this->vertexData + i * this->recordSize;
+					vertices[i] = ofVec3f(readField(record, X), readField(record, Y), readField(record, Z));
+					if (hasColors) {
+						colors[i] = ofFloatColor(readField(record, Red) * colorScales[0],
+							readField(record, Green) * colorScales[1],
+							readField(record, Blue) * colorScales[2],
+							hasAlpha ? readField(record, Alpha) * colorScales[3] : 1.0f);
+					}
+					if (hasTexCoords) {
+						texCoords[i] = ofVec2f(readField(record, U), readField(record, V));
+					}
+				}
+			}, 65536);
+		}
+
+		//----------
+		void PlyReader::load(const std::string & filename, ofMesh & mesh) {
+			PlyReader reader;
+			reader.open(filename);
+			reader.read(mesh);
+		}
+	}
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include "Poco/SharedMemory.h"
+
+#include <string>
+#include <vector>
+
+class ofMesh;
+
+namespace ofxRulr {
+	namespace Utils {
+		/**
+		Reads the vertices of binary little endian PLY files by memory mapping them, so that only
+		the header is parsed up front and the vertex data is copied into a mesh across all cores.
+		Positions (x, y, z), colors (red, green, blue, alpha) and texture coordinates (u, v or s, t)
+		are read from any numeric property type. Other vertex properties and elements are skipped.
+		**/
+		class PlyReader {
+		public:
+			PlyReader();
+
+			void open(const std::string & filename);
+			void close();
+			bool isOpen() const;
+
+			size_t getVertexCount() const;
+			bool getHasColors() const;
+			bool getHasTexCoords() const;
+
+			///Replaces the contents of the mesh with the vertices of the file
+			void read(ofMesh &) const;
+
+			static void load(const std::string & filename, ofMesh &);
+		protected:
+			enum Type {
+				Int8, UInt8, Int16, UInt16, Int32, UInt32, Float32, Float64
+			};
+
+			struct Property {
+				int offset; // -1 if the file doesn't have this property
+				Type type;
+			};
+
+			enum Field {
+				X, Y, Z,
+				Red, Green, Blue, Alpha,
+				U, V,
+				FieldCount
+			};
+
+			Poco::SharedMemory mapping;
+			std::string filename;
+
+			const char * vertexData;
+			size_t vertexCount;
+			size_t recordSize;
+			Property fields[FieldCount];
+		};
+	}
+}
@@ -0,0 +1,158 @@
+#include "PlyWriter.h"
+
+#include "ofxRulr/Exception.h"
+#include "ofxRulr/Utils/Constants.h"
+#include "ofxRulr/Utils/Parallel.h"
+
+#include "ofMesh.h"
+#include "ofUtils.h"
+
+#include <stdint.h>
+
+#define RULR_PLY_WRITER_BLOCK_SIZE (1 << 20)
+
+namespace ofxRulr {
+	namespace Utils {
+		//----------
+		PlyWriter::PlyWriter() {
+			this->vertexCount = 0;
+			this->verticesWritten = 0;
+			this->hasColors = false;
+			this->hasTexCoords = false;
+			this->recordSize = 0;
+		}
+
+		//----------
+		PlyWriter::~PlyWriter() {
+			if (this->file.is_open()) {
+				this->file.close();
+			}
+		}
+
+		//----------
+		void PlyWriter::open(const std::string & filename, size_t vertexCount, bool hasColors, bool hasTexCoords) {
+			this->close();
+			this->file.open(ofToDataPath(filename).c_str(), std::ios::binary | std::ios::out | std::ios::trunc);
+			if (!this->file.is_open()) {
+				throw(Exception("Couldn't open " + filename + " for writing"));
+			}
+
+			this->filename = filename;
+			this->vertexCount = vertexCount;
+			this->verticesWritten = 0;
+			this->hasColors = hasColors;
+			this->hasTexCoords = hasTexCoords;
+			this->recordSize = sizeof(float) * 3
+				+ (hasColors ? sizeof(uint8_t) * 4 : 0)
+				+ (hasTexCoords ? sizeof(float) * 2 : 0);
+
+			//we write the host's byte order, which is little endian on every platform we build for
+			this->file << "ply" << "\n";
+			this->file << "format binary_little_endian 1.0" << "\n";
+			this->file << "comment ofxRulr" << "\n";
+			this->file << "element vertex " << vertexCount << "\n";
+			this->file << "property float x" << "\n";
+			this->file << "property float y" << "\n";
+			this->file << "property float z" << "\n";
+			if (hasColors) {
+				this->file << "property uchar red" << "\n";
+				this->file << "property uchar green" << "\n";
+				this->file << "property uchar blue" << "\n";
+				this->file << "property uchar alpha" << "\n";
+			}
+			if (hasTexCoords) {
+				this->file << "property float u" << "\n";
+				this->file << "property float v" << "\n";
+			}
+			this->file << "end_header" << "\n";
+		}
+
+		//----------
+		void PlyWriter::writeVertices(const ofVec3f * vertices, const ofFloatColor * colors, const ofVec2f * texCoords, size_t count) {
+			if (!this->isOpen()) {
+				throw(Exception("PlyWriter is not open"));
+			}
+			if (this->verticesWritten + count > this->vertexCount) {
+				throw(Exception("PlyWriter was given more vertices than declared in the header"));
+			}
+			if ((this->hasColors && !colors) || (this->hasTexCoords && !texCoords)) {
+				throw(Exception("PlyWriter needs colors and texture coordinates for every vertex"));
+			}
+
+			const auto hasColors = this->hasColors;
+			const auto hasTexCoords = this->hasTexCoords;
+			const auto recordSize = this->recordSize;
+
+			for (size_t blockBegin = 0; blockBegin < count; blockBegin += RULR_PLY_WRITER_BLOCK_SIZE) {
+				const auto blockCount = std::min<size_t>(RULR_PLY_WRITER_BLOCK_SIZE, count - blockBegin);
+				this->buffer.resize(blockCount * recordSize);
+				auto buffer = this->buffer.data();
+
+				parallelFor(blockCount, [&](size_t begin, size_t end) {
+					auto record = buffer + begin * recordSize;
+					for (size_t i = blockBegin + begin; i < blockBegin + end; i++) {
+						memcpy(record, &vertices[i], sizeof(float) * 3);
+						record += sizeof(float) * 3;
+						if (hasColors) {
+							const auto & color = colors[i];
+							record[0] = (uint8_t)(ofClamp(color.r, 0.0f, 1.0f) * 255.0f + 0.5f);
+							record[1] = (uint8_t)(ofClamp(color.g, 0.0f, 1.0f) * 255.0f + 0.5f);
+							record[2] = (uint8_t)(ofClamp(color.b, 0.0f, 1.0f) * 255.0f + 0.5f);
+							record[3] = (uint8_t)(ofClamp(color.a, 0.0f, 1.0f) * 255.0f + 0.5f);
+							record += sizeof(uint8_t) * 4;
+						}
+						if (hasTexCoords) {
+							memcpy(record, &texCoords[i], sizeof(float) * 2);
+							record += sizeof(float) * 2;
+						}
+					}
+				}, 16384);
+
+				this->file.write(buffer, blockCount * recordSize);
+				this->verticesWritten += blockCount;
+			}
+
+			if (!this->file.good()) {
+				throw(Exception("Failed to write to " + this->filename));
+			}
+		}
+
+		//----------
+		void PlyWriter::close() {
+			if (!this->file.is_open()) {
+				return;
+			}
+			this->file.close();
+			if (this->verticesWritten != this->vertexCount) {
+				RULR_WARNING << this->filename << " was closed after " << this->verticesWritten << " of " << this->vertexCount << " vertices";
+			}
+			this->buffer.clear();
+			this->buffer.shrink_to_fit();
+		}
+
+		//----------
+		bool PlyWriter::isOpen() const {
+			return this->file.is_open();
+		}
+
+		//----------
+		size_t PlyWriter::getVerticesWritten() const {
+			return this->verticesWritten;
+		}
+
+		//----------
+		void PlyWriter::save(const std::string & filename, const ofMesh & mesh) {
+			const auto vertexCount = mesh.getNumVertices();
+			const auto hasColors = mesh.getNumColors() == vertexCount && vertexCount > 0;
+			const auto hasTexCoords = mesh.getNumTexCoords() == vertexCount && vertexCount > 0;
+
+			PlyWriter writer;
+			writer.open(filename, vertexCount, hasColors, hasTexCoords);
+			writer.writeVertices(mesh.getVerticesPointer(),
+				hasColors ? mesh.getColorsPointer() : nullptr,
+				hasTexCoords ? mesh.getTexCoordsPointer() : nullptr,
+				vertexCount);
+			writer.close();
+		}
+	}
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include "ofVec2f.h"
+#include "ofVec3f.h"
+#include "ofColor.h"
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+class ofMesh;
+
+namespace ofxRulr {
+	namespace Utils {
+		/**
+		Writes point clouds as binary little endian PLY files, a block of vertices at a time.
+		Each block is packed into records across all cores, then written to disk in one call.
+		Colors are stored as uchar red, green, blue, alpha and texture coordinates as float u, v
+		(the same properties that ofMesh::save uses), so files open in MeshLab, CloudCompare, etc.
+		**/
+		class PlyWriter {
+		public:
+			PlyWriter();
+			~PlyWriter();
+
+			void open(const std::string & filename, size_t vertexCount, bool hasColors, bool hasTexCoords);
+			///colors and texCoords are ignored if the file was opened without them
+			void writeVertices(const ofVec3f * vertices, const ofFloatColor * colors, const ofVec2f * texCoords, size_t count);
+			void close();
+
+			bool isOpen() const;
+			size_t getVerticesWritten() const;
+
+			///Saves the vertices, and the colors and texture coordinates if there is one per vertex
+			static void save(const std::string & filename, const ofMesh &);
+		protected:
+			std::ofstream file;
+			std::string filename;
+			size_t vertexCount;
+			size_t verticesWritten;
+			bool hasColors;
+			bool hasTexCoords;
+			size_t recordSize;
+
+			std::vector<char> buffer;
+		};
+	}
+}
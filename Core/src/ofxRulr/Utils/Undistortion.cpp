@@ -0,0 +1,161 @@
+#include "Undistortion.h"
+
+#include "ofxRulr/Exception.h"
+#include "ofxRulr/Utils/Parallel.h"
+
+#include "ofUtils.h"
+
+#include <opencv2/imgproc/imgproc.hpp>
+
+#include <algorithm>
+
+namespace ofxRulr {
+	namespace Utils {
+		//----------
+		Undistortion::Undistortion(const cv::Mat & cameraMatrix, const cv::Mat & distortionCoefficients, const cv::Size & imageSize) :
+		imageSize(imageSize),
+		lutColumns(0),
+		lutRows(0) {
+			cameraMatrix.convertTo(this->cameraMatrix, CV_64F);
+			distortionCoefficients.convertTo(this->distortionCoefficients, CV_64F);
+			this->identity = cv::countNonZero(this->distortionCoefficients) == 0;
+		}
+
+		//----------
+		bool Undistortion::matches(const cv::Mat & cameraMatrix, const cv::Mat & distortionCoefficients, const cv::Size & imageSize) const {
+			if (imageSize != this->imageSize
+				|| cameraMatrix.total() != this->cameraMatrix.total()
+				|| distortionCoefficients.total() != this->distortionCoefficients.total()) {
+				return false;
+			}
+
+			cv::Mat cameraMatrix64, distortionCoefficients64;
+			cameraMatrix.convertTo(cameraMatrix64, CV_64F);
+			distortionCoefficients.convertTo(distortionCoefficients64, CV_64F);
+			return cv::norm(cameraMatrix64.reshape(1, 1), this->cameraMatrix.reshape(1, 1), cv::NORM_INF) == 0.0
+				&& cv::norm(distortionCoefficients64.reshape(1, 1), this->distortionCoefficients.reshape(1, 1), cv::NORM_INF) == 0.0;
+		}
+
+		//----------
+		bool Undistortion::isIdentity() const {
+			return this->identity;
+		}
+
+		//----------
+		void Undistortion::undistortImage(const cv::Mat & distorted, cv::Mat & undistorted) const {
+			if (distorted.size() != this->imageSize) {
+				throw(Exception("Cannot undistort an image of size " + ofToString(distorted.cols) + "x" + ofToString(distorted.rows)
+					+ " with intrinsics for " + ofToString(this->imageSize.width) + "x" + ofToString(this->imageSize.height)));
+			}
+			if (this->identity) {
+				distorted.copyTo(undistorted);
+				return;
+			}
+
+			std::call_once(this->mapsBuilt, [this]() {
+				this->buildMaps();
+			});
+			cv::remap(distorted, undistorted, this->map1, this->map2, cv::INTER_LINEAR);
+		}
+
+		//----------
+		void Undistortion::undistortPoints(const ofVec2f * distorted, size_t count, ofVec2f * undistorted) const {
+			if (this->identity) {
+				std::copy(distorted, distorted + count, undistorted);
+				return;
+			}
+
+			std::call_once(this->lutBuilt, [this]() {
+				this->buildLut();
+			});
+
+			const auto maxX = (float) (this->imageSize.width - 1);
+			const auto maxY = (float) (this->imageSize.height - 1);
+			const auto step = (float) RULR_UNDISTORTION_LUT_STEP;
+
+			std::vector<size_t> outside;
+			for (size_t i = 0; i < count; i++) {
+				const auto & point = distorted[i];
+				if (!(point.x >= 0.0f && point.y >= 0.0f && point.x <= maxX && point.y <= maxY)) {
+					outside.push_back(i);
+					continue;
+				}
+
+				const auto gridX = point.x / step;
+				const auto gridY = point.y / step;
+				const auto column = std::min((int) gridX, this->lutColumns - 2);
+				const auto row = std::min((int) gridY, this->lutRows - 2);
+				const auto fractionX = gridX - (float) column;
+				const auto fractionY = gridY - (float) row;
+
+				const auto topLeft = &this->lut[row * this->lutColumns + column];
+				const auto bottomLeft = topLeft + this->lutColumns;
+				const auto top = topLeft[0] + (topLeft[1] - topLeft[0]) * fractionX;
+				const auto bottom = bottomLeft[0] + (bottomLeft[1] - bottomLeft[0]) * fractionX;
+				undistorted[i] = top + (bottom - top) * fractionY;
+			}
+
+			if (!outside.empty()) {
+				std::vector<ofVec2f> outsideDistorted, outsideUndistorted(outside.size());
+				for (auto index : outside) {
+					outsideDistorted.push_back(distorted[index]);
+				}
+				this->undistortPointsExactly(outsideDistorted.data(), outsideDistorted.size(), outsideUndistorted.data());
+				for (size_t i = 0; i < outside.size(); i++) {
+					undistorted[outside[i]] = outsideUndistorted[i];
+				}
+			}
+		}
+
+		//----------
+		void Undistortion::undistortPoints(const std::vector<ofVec2f> & distorted, std::vector<ofVec2f> & undistorted) const {
+			undistorted.resize(distorted.size());
+
+			//build the table before spreading the work, rather than inside a worker
+			if (!this->identity) {
+				std::call_once(this->lutBuilt, [this]() {
+					this->buildLut();
+				});
+			}
+			parallelFor(distorted.size(), [&](size_t begin, size_t end) {
+				this->undistortPoints(distorted.data() + begin, end - begin, undistorted.data() + begin);
+			}, 65536);
+		}
+
+		//----------
+		void Undistortion::buildMaps() const {
+			cv::initUndistortRectifyMap(this->cameraMatrix, this->distortionCoefficients, cv::Mat(), this->cameraMatrix, this->imageSize, CV_16SC2, this->map1, this->map2);
+		}
+
+		//----------
+		void Undistortion::buildLut() const {
+			//the grid covers the image, so its last row and column may lie just beyond it
+			this->lutColumns = (this->imageSize.width - 1) / RULR_UNDISTORTION_LUT_STEP + 2;
+			this->lutRows = (this->imageSize.height - 1) / RULR_UNDISTORTION_LUT_STEP + 2;
+
+			std::vector<ofVec2f> gridPoints;
+			gridPoints.reserve(this->lutColumns * this->lutRows);
+			for (int j = 0; j < this->lutRows; j++) {
+				for (int i = 0; i < this->lutColumns; i++) {
+					gridPoints.push_back(ofVec2f(i * RULR_UNDISTORTION_LUT_STEP, j * RULR_UNDISTORTION_LUT_STEP));
+				}
+			}
+
+			this->lut.resize(gridPoints.size());
+			parallelFor(gridPoints.size(), [this, &gridPoints](size_t begin, size_t end) {
+				this->undistortPointsExactly(gridPoints.data() + begin, end - begin, this->lut.data() + begin);
+			}, 16384);
+		}
+
+		//----------
+		void Undistortion::undistortPointsExactly(const ofVec2f * distorted, size_t count, ofVec2f * undistorted) const {
+			if (count == 0) {
+				return;
+			}
+			//ofVec2f is laid out as two floats, so we can wrap the arrays without copying
+			const cv::Mat distortedMat((int) count, 1, CV_32FC2, (void*) distorted);
+			cv::Mat undistortedMat((int) count, 1, CV_32FC2, (void*) undistorted);
+			cv::undistortPoints(distortedMat, undistortedMat, this->cameraMatrix, this->distortionCoefficients, cv::noArray(), this->cameraMatrix);
+		}
+	}
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include "ofVec2f.h"
+
+#include <opencv2/core/core.hpp>
+
+#include <mutex>
+#include <vector>
+
+//spacing [px] of the grid of exactly undistorted points which undistortPoints interpolates between
+#define RULR_UNDISTORTION_LUT_STEP 4
+
+namespace ofxRulr {
+	namespace Utils {
+		/**
+		Undistortion tables for one set of intrinsics (camera matrix, distortion coefficients and image size).
+		The fixed point remap tables (for images) and the point lookup table (for pixel coordinates) are each built the first time they are needed.
+		After that they never change, so one Undistortion can be shared and used from any thread.
+		Outputs are in pixel coordinates of the same camera matrix (as cv::undistort / ofxCv::undistortPixelCoordinates).
+		**/
+		class Undistortion {
+		public:
+			Undistortion(const cv::Mat & cameraMatrix, const cv::Mat & distortionCoefficients, const cv::Size & imageSize);
+
+			bool matches(const cv::Mat & cameraMatrix, const cv::Mat & distortionCoefficients, const cv::Size & imageSize) const;
+			bool isIdentity() const; // all distortion coefficients are zero
+
+			///distorted must be the image size. Uses cv::remap with CV_16SC2 tables and bilinear filtering.
+			void undistortImage(const cv::Mat & distorted, cv::Mat & undistorted) const;
+
+			///Bilinear lookup into a grid of exactly undistorted points inside the image. Points outside the image are undistorted exactly.
+			void undistortPoints(const ofVec2f * distorted, size_t count, ofVec2f * undistorted) const;
+			void undistortPoints(const std::vector<ofVec2f> & distorted, std::vector<ofVec2f> & undistorted) const;
+		protected:
+			void buildMaps() const;
+			void buildLut() const;
+			void undistortPointsExactly(const ofVec2f * distorted, size_t count, ofVec2f * undistorted) const;
+
+			cv::Mat cameraMatrix;
+			cv::Mat distortionCoefficients;
+			cv::Size imageSize;
+			bool identity;
+
+			mutable std::once_flag mapsBuilt;
+			mutable cv::Mat map1, map2;
+
+			mutable std::once_flag lutBuilt;
+			mutable std::vector<ofVec2f> lut;
+			mutable int lutColumns;
+			mutable int lutRows;
+		};
+	}
+}
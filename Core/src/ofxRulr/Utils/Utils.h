@@ -1,20 +1,20 @@
-#pragma once
-
-#include "ofxSingleton.h"
-
-#include "ofSoundPlayer.h"
-
-namespace ofxRulr {
-	namespace Utils {
-		class Assets : public ofxSingleton::Singleton<Assets> {
-		public:
-			Assets();
-
-			ofSoundPlayer failSound;
-			ofSoundPlayer successSound;
-		};
-
-		void playSuccessSound();
-		void playFailSound();
-	}
+#pragma once
+
+#include "ofxSingleton.h"
+
+#include "ofSoundPlayer.h"
+
+namespace ofxRulr {
+	namespace Utils {
+		class Assets : public ofxSingleton::Singleton<Assets> {
+		public:
+			Assets();
+
+			ofSoundPlayer failSound;
+			ofSoundPlayer successSound;
+		};
+
+		void playSuccessSound();
+		void playFailSound();
+	}
 }
\ No newline at end of file
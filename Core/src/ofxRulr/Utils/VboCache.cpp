@@ -0,0 +1,114 @@
+#include "VboCache.h"
+
+#include "ofGLUtils.h"
+
+namespace ofxRulr {
+	namespace Utils {
+		//----------
+		VboCache::Entry::Entry() {
+			this->mode = OF_PRIMITIVE_POINTS;
+			this->vertexCount = 0;
+			this->indexCount = 0;
+			this->version = 0;
+		}
+
+		//----------
+		void VboCache::Entry::draw() const {
+			if (this->vertexCount == 0) {
+				return;
+			}
+			const auto glMode = ofGetGLPrimitiveMode(this->mode);
+			if (this->indexCount > 0) {
+				this->vbo.drawElements(glMode, this->indexCount);
+			}
+			else {
+				this->vbo.draw(glMode, 0, this->vertexCount);
+			}
+		}
+
+		//----------
+		void VboCache::Entry::drawVertices() const {
+			if (this->vertexCount == 0) {
+				return;
+			}
+			this->vbo.draw(GL_POINTS, 0, this->vertexCount);
+		}
+
+		//----------
+		int VboCache::Entry::getVertexCount() const {
+			return this->vertexCount;
+		}
+
+		//----------
+		unsigned int VboCache::Entry::getVersion() const {
+			return this->version;
+		}
+
+		//----------
+		void VboCache::Entry::upload(const ofMesh & mesh) {
+			this->vbo.clear();
+			this->mode = mesh.getMode();
+			this->vertexCount = mesh.getNumVertices();
+			this->indexCount = mesh.getNumIndices();
+			if (this->vertexCount > 0) {
+				this->vbo.setMesh(mesh, GL_STATIC_DRAW);
+			}
+		}
+
+		//----------
+		VboCache & VboCache::X() {
+			static VboCache instance;
+			return instance;
+		}
+
+		//----------
+		const VboCache::Entry & VboCache::get(const void * owner, const std::string & name, unsigned int version, const std::function<void(ofMesh &)> & build) {
+			auto & entry = this->getEntry(owner, name, version);
+			if (entry.version != version) {
+				ofMesh mesh;
+				build(mesh);
+				entry.upload(mesh);
+				entry.version = version;
+			}
+			return entry;
+		}
+
+		//----------
+		const VboCache::Entry & VboCache::get(const void * owner, const std::string & name, unsigned int version, const ofMesh & mesh) {
+			auto & entry = this->getEntry(owner, name, version);
+			if (entry.version != version) {
+				entry.upload(mesh);
+				entry.version = version;
+			}
+			return entry;
+		}
+
+		//----------
+		void VboCache::release(const void * owner) {
+			auto it = this->entries.lower_bound(std::make_pair(owner, std::string()));
+			while (it != this->entries.end() && it->first.first == owner) {
+				it = this->entries.erase(it);
+			}
+		}
+
+		//----------
+		void VboCache::release(const void * owner, const std::string & name) {
+			this->entries.erase(std::make_pair(owner, name));
+		}
+
+		//----------
+		size_t VboCache::getEntryCount() const {
+			return this->entries.size();
+		}
+
+		//----------
+		VboCache::Entry & VboCache::getEntry(const void * owner, const std::string & name, unsigned int version) {
+			auto & entry = this->entries[std::make_pair(owner, name)];
+			if (!entry) {
+				entry = std::make_shared<Entry>();
+				entry->version = version + 1; // make sure we upload the first time
+			}
+			return *entry;
+		}
+	}
+}
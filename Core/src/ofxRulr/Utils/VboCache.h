@@ -0,0 +1,60 @@
+#pragma once
+
+#include "ofVbo.h"
+#include "ofMesh.h"
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+
+namespace ofxRulr {
+	namespace Utils {
+		/**
+		Retained GPU copies of geometry which nodes draw every frame, e.g. in drawWorld.
+		Each entry is keyed by its owner (normally the node) and a name, and carries the version of the content it was built from.
+		The build function is only called (and the data only uploaded) when the version passed in differs from the stored one,
+		so the world view, the stencil and any other views all draw from the same upload.
+		The CPU side mesh is discarded after upload. Only plain vertex buffer objects are used, so this also runs under Mesa's software rasteriser.
+		**/
+		class VboCache {
+		public:
+			class Entry {
+			public:
+				Entry();
+
+				void draw() const;
+				void drawVertices() const;
+
+				int getVertexCount() const;
+				unsigned int getVersion() const;
+			protected:
+				friend VboCache;
+				void upload(const ofMesh &);
+
+				ofVbo vbo;
+				ofPrimitiveMode mode;
+				int vertexCount;
+				int indexCount;
+				unsigned int version;
+			};
+
+			static VboCache & X();
+
+			///Returns the entry for this owner and name, calling build to refill it first if its version differs from version
+			const Entry & get(const void * owner, const std::string & name, unsigned int version, const std::function<void(ofMesh &)> & build);
+			///Returns the entry for this owner and name, uploading mesh first if its version differs from version. Use this for meshes the owner keeps anyway.
+			const Entry & get(const void * owner, const std::string & name, unsigned int version, const ofMesh & mesh);
+			///Releases all entries of an owner (called automatically when a node is destroyed)
+			void release(const void * owner);
+			///Releases one entry of an owner
+			void release(const void * owner, const std::string & name);
+
+			size_t getEntryCount() const;
+		protected:
+			Entry & getEntry(const void * owner, const std::string & name, unsigned int version);
+
+			std::map<std::pair<const void *, std::string>, std::shared_ptr<Entry>> entries;
+		};
+	}
+}
@@ -0,0 +1,336 @@
+#include "VoxelGrid.h"
+
+#include "ofxRulr/Exception.h"
+#include "ofxRulr/Utils/Parallel.h"
+
+#include "ofMesh.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <mutex>
+
+#define RULR_VOXEL_GRID_AXIS_BITS 21
+#define RULR_VOXEL_GRID_AXIS_OFFSET (1 << (RULR_VOXEL_GRID_AXIS_BITS - 1))
+
+namespace ofxRulr {
+	namespace Utils {
+		//----------
+		VoxelGrid::VoxelGrid() {
+			this->clear();
+		}
+
+		//----------
+		void VoxelGrid::build(const std::vector<ofVec3f> & points, float voxelSize) {
+			this->clear();
+			if (voxelSize <= 0.0f) {
+				throw(Exception("VoxelGrid needs a voxel size greater than 0"));
+			}
+			if (points.size() > (size_t)std::numeric_limits<uint32_t>::max()) {
+				throw(Exception("VoxelGrid supports up to 2^32 points"));
+			}
+
+			this->points = &points;
+			this->voxelSize = voxelSize;
+
+			const auto count = points.size();
+			if (count == 0) {
+				return;
+			}
+
+			//key every point by its voxel
+			std::vector<std::pair<uint64_t, uint32_t>> keyed(count);
+			parallelFor(count, [&](size_t begin, size_t end) {
+				int x, y, z;
+				for (size_t i = begin; i < end; i++) {
+					this->getVoxel(points[i], x, y, z);
+					keyed[i] = std::make_pair(this->getKey(x, y, z), (uint32_t)i);
+				}
+			});
+
+			//sort a slice per thread, then merge the slices pairwise
+			const auto sliceCount = (size_t)std::max(getThreadCount(), 1);
+			const auto sliceSize = (count + sliceCount - 1) / sliceCount;
+			parallelFor(sliceCount, [&](size_t begin, size_t end) {
+				for (size_t slice = begin; slice < end; slice++) {
+					const auto sliceBegin = std::min(slice * sliceSize, count);
+					const auto sliceEnd = std::min(sliceBegin + sliceSize, count);
+					std::sort(keyed.begin() + sliceBegin, keyed.begin() + sliceEnd);
+				}
+			}, 1);
+			for (size_t width = sliceSize; width < count; width *= 2) {
+				const auto mergeCount = (count + width * 2 - 1) / (width * 2);
+				parallelFor(mergeCount, [&](size_t begin, size_t end) {
+					for (size_t merge = begin; merge < end; merge++) {
+						const auto mergeBegin = merge * width * 2;
+						const auto mergeMiddle = std::min(mergeBegin + width, count);
+						const auto mergeEnd = std::min(mergeBegin + width * 2, count);
+						if (mergeMiddle < mergeEnd) {
+							std::inplace_merge(keyed.begin() + mergeBegin, keyed.begin() + mergeMiddle, keyed.begin() + mergeEnd);
+						}
+					}
+				}, 1);
+			}
+
+			//split into cells
+			this->pointIndices.resize(count);
+			parallelFor(count, [&](size_t begin, size_t end) {
+				for (size_t i = begin; i < end; i++) {
+					this->pointIndices[i] = keyed[i].second;
+				}
+			});
+			for (size_t i = 0; i < count; i++) {
+				if (i == 0 || keyed[i].first != keyed[i - 1].first) {
+					Cell cell;
+					cell.key = keyed[i].first;
+					cell.begin = (uint32_t)i;
+					cell.count = 0;
+					this->cells.push_back(cell);
+				}
+				this->cells.back().count++;
+			}
+
+			this->cellLookup.reserve(this->cells.size());
+			for (size_t i = 0; i < this->cells.size(); i++) {
+				this->cellLookup[this->cells[i].key] = (uint32_t)i;
+			}
+		}
+
+		//----------
+		void VoxelGrid::clear() {
+			this->points = nullptr;
+			this->voxelSize = 0.0f;
+			this->cells.clear();
+			this->pointIndices.clear();
+			this->cellLookup.clear();
+		}
+
+		//----------
+		bool VoxelGrid::empty() const {
+			return this->cells.empty();
+		}
+
+		//----------
+		float VoxelGrid::getVoxelSize() const {
+			return this->voxelSize;
+		}
+
+		//----------
+		const std::vector<VoxelGrid::Cell> & VoxelGrid::getCells() const {
+			return this->cells;
+		}
+
+		//----------
+		const std::vector<uint32_t> & VoxelGrid::getPointIndices() const {
+			return this->pointIndices;
+		}
+
+		//----------
+		void VoxelGrid::findInRadius(const ofVec3f & center, float radius, std::vector<uint32_t> & results) const {
+			if (this->empty()) {
+				return;
+			}
+
+			int minX, minY, minZ, maxX, maxY, maxZ;
+			this->getVoxel(center - ofVec3f(radius), minX, minY, minZ);
+			this->getVoxel(center + ofVec3f(radius), maxX, maxY, maxZ);
+
+			const auto & points = *this->points;
+			const auto radiusSquared = radius * radius;
+			for (int z = minZ; z <= maxZ; z++) {
+				for (int y = minY; y <= maxY; y++) {
+					for (int x = minX; x <= maxX; x++) {
+						auto findCell = this->cellLookup.find(this->getKey(x, y, z));
+						if (findCell == this->cellLookup.end()) {
+							continue;
+						}
+						const auto & cell = this->cells[findCell->second];
+						for (uint32_t i = cell.begin; i < cell.begin + cell.count; i++) {
+							const auto index = this->pointIndices[i];
+							if (points[index].squareDistance(center) <= radiusSquared) {
+								results.push_back(index);
+							}
+						}
+					}
+				}
+			}
+		}
+
+		//----------
+		void VoxelGrid::downsample(const ofMesh & input, ofMesh & output) const {
+			const auto count = input.getNumVertices();
+			if (!this->points || this->points->size() != count) {
+				throw(Exception("VoxelGrid was not built from this mesh"));
+			}
+
+			const auto hasColors = input.getNumColors() == count;
+			const auto hasTexCoords = input.getNumTexCoords() == count;
+			const auto inputVertices = input.getVerticesPointer();
+			const auto inputColors = input.getColorsPointer();
+			const auto inputTexCoords = input.getTexCoordsPointer();
+
+			std::vector<ofVec3f> vertices(this->cells.size());
+			std::vector<ofFloatColor> colors(hasColors ? this->cells.size() : 0);
+			std::vector<ofVec2f> texCoords(hasTexCoords ? this->cells.size() : 0);
+
+			parallelFor(this->cells.size(), [&](size_t begin, size_t end) {
+				for (size_t cellIndex = begin; cellIndex < end; cellIndex++) {
+					const auto & cell = this->cells[cellIndex];
+					ofVec3f vertex;
+					ofFloatColor color(0.0f, 0.0f, 0.0f, 0.0f);
+					ofVec2f texCoord;
+					for (uint32_t i = cell.begin; i < cell.begin + cell.count; i++) {
+						const auto index = this->pointIndices[i];
+						vertex += inputVertices[index];
+						if (hasColors) {
+							const auto & inputColor = inputColors[index];
+							color.r += inputColor.r;
+							color.g += inputColor.g;
+							color.b += inputColor.b;
+							color.a += inputColor.a;
+						}
+						if (hasTexCoords) {
+							texCoord += inputTexCoords[index];
+						}
+					}
+
+					const auto scale = 1.0f / (float)cell.count;
+					vertices[cellIndex] = vertex * scale;
+					if (hasColors) {
+						colors[cellIndex] = ofFloatColor(color.r * scale, color.g * scale, color.b * scale, color.a * scale);
+					}
+					if (hasTexCoords) {
+						texCoords[cellIndex] = texCoord * scale;
+					}
+				}
+			}, 16384);
+
+			output.clear();
+			output.setMode(OF_PRIMITIVE_POINTS);
+			output.getVertices().swap(vertices);
+			output.getColors().swap(colors);
+			output.getTexCoords().swap(texCoords);
+		}
+
+		//----------
+		std::vector<uint8_t> VoxelGrid::findStatisticalOutliers(int neighbourCount, float standardDeviations) const {
+			if (neighbourCount < 1) {
+				throw(Exception("Statistical outlier removal needs at least 1 neighbour"));
+			}
+
+			if (!this->points) {
+				return std::vector<uint8_t>();
+			}
+
+			const auto & points = *this->points;
+			const auto count = points.size();
+			const auto infinity = std::numeric_limits<float>::infinity();
+			const auto searchRadiusSquared = this->voxelSize * this->voxelSize;
+
+			//mean distance from each point to its nearest neighbours
+			std::vector<float> meanDistances(count, infinity);
+			parallelFor(count, [&](size_t begin, size_t end) {
+				std::vector<float> distancesSquared;
+				int x, y, z;
+				for (size_t pointIndex = begin; pointIndex < end; pointIndex++) {
+					const auto & point = points[pointIndex];
+					this->getVoxel(point, x, y, z);
+
+					distancesSquared.clear();
+					for (int dz = -1; dz <= 1; dz++) {
+						for (int dy = -1; dy <= 1; dy++) {
+							for (int dx = -1; dx <= 1; dx++) {
+								auto findCell = this->cellLookup.find(this->getKey(x + dx, y + dy, z + dz));
+								if (findCell == this->cellLookup.end()) {
+									continue;
+								}
+								const auto & cell = this->cells[findCell->second];
+								for (uint32_t i = cell.begin; i < cell.begin + cell.count; i++) {
+									const auto index = this->pointIndices[i];
+									if (index == pointIndex) {
+										continue;
+									}
+									const auto distanceSquared = points[index].squareDistance(point);
+									if (distanceSquared <= searchRadiusSquared) {
+										distancesSquared.push_back(distanceSquared);
+									}
+								}
+							}
+						}
+					}
+
+					if (distancesSquared.empty()) {
+						continue;
+					}
+					const auto nearestCount = std::min((size_t)neighbourCount, distancesSquared.size());
+					std::nth_element(distancesSquared.begin(), distancesSquared.begin() + (nearestCount - 1), distancesSquared.end());
+					float sum = 0.0f;
+					for (size_t i = 0; i < nearestCount; i++) {
+						sum += sqrt(distancesSquared[i]);
+					}
+					meanDistances[pointIndex] = sum / (float)nearestCount;
+				}
+			}, 16384);
+
+			//statistics of the mean distances over all points which have neighbours
+			std::mutex accumulateLock;
+			double sum = 0.0, sumSquared = 0.0;
+			size_t finiteCount = 0;
+			parallelFor(count, [&](size_t begin, size_t end) {
+				double localSum = 0.0, localSumSquared = 0.0;
+				size_t localCount = 0;
+				for (size_t i = begin; i < end; i++) {
+					if (meanDistances[i] != infinity) {
+						localSum += meanDistances[i];
+						localSumSquared += meanDistances[i] * meanDistances[i];
+						localCount++;
+					}
+				}
+				std::lock_guard<std::mutex> lock(accumulateLock);
+				sum += localSum;
+				sumSquared += localSumSquared;
+				finiteCount += localCount;
+			}, 65536);
+
+			std::vector<uint8_t> isOutlier(count, 1);
+			if (finiteCount > 0) {
+				const auto mean = sum / (double)finiteCount;
+				const auto variance = std::max(sumSquared / (double)finiteCount - mean * mean, 0.0);
+				const auto threshold = (float)(mean + standardDeviations * sqrt(variance));
+				parallelFor(count, [&](size_t begin, size_t end) {
+					for (size_t i = begin; i < end; i++) {
+						isOutlier[i] = meanDistances[i] > threshold;
+					}
+				}, 65536);
+			}
+			return isOutlier;
+		}
+
+		//----------
+		uint64_t VoxelGrid::getKey(int x, int y, int z) const {
+			const uint64_t mask = (1 << RULR_VOXEL_GRID_AXIS_BITS) - 1;
+			return ((uint64_t)(x + RULR_VOXEL_GRID_AXIS_OFFSET) & mask)
+				| (((uint64_t)(y + RULR_VOXEL_GRID_AXIS_OFFSET) & mask) << RULR_VOXEL_GRID_AXIS_BITS)
+				| (((uint64_t)(z + RULR_VOXEL_GRID_AXIS_OFFSET) & mask) << (RULR_VOXEL_GRID_AXIS_BITS * 2));
+		}
+
+		//----------
+		void VoxelGrid::getVoxel(const ofVec3f & point, int & x, int & y, int & z) const {
+			//clamp to the range of the key (this also catches NaN)
+			auto toVoxel = [this](float value) {
+				const double limit = RULR_VOXEL_GRID_AXIS_OFFSET - 2;
+				auto voxel = floor((double)value / (double)this->voxelSize);
+				if (!(voxel >= -limit)) {
+					voxel = -limit;
+				}
+				else if (voxel > limit) {
+					voxel = limit;
+				}
+				return (int)voxel;
+			};
+			x = toVoxel(point.x);
+			y = toVoxel(point.y);
+			z = toVoxel(point.z);
+		}
+	}
+}
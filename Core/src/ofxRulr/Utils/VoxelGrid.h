@@ -0,0 +1,60 @@
+#pragma once
+
+#include "ofVec3f.h"
+
+#include <stdint.h>
+#include <unordered_map>
+#include <vector>
+
+class ofMesh;
+
+namespace ofxRulr {
+	namespace Utils {
+		/**
+		Sparse voxel hash over a set of points. Points are bucketed into cubic voxels of a fixed size,
+		sorted by voxel, and the occupied voxels are looked up through a hash map.
+		The grid keeps a pointer to the points it was built from, so they must outlive it (or until clear).
+		Building, downsampling and outlier detection run across all cores.
+		**/
+		class VoxelGrid {
+		public:
+			struct Cell {
+				uint64_t key;
+				uint32_t begin; // into getPointIndices()
+				uint32_t count;
+			};
+
+			VoxelGrid();
+
+			void build(const std::vector<ofVec3f> & points, float voxelSize);
+			void clear();
+			bool empty() const;
+
+			float getVoxelSize() const;
+			const std::vector<Cell> & getCells() const;
+			///Indices into the points, ordered so that each cell's points are contiguous
+			const std::vector<uint32_t> & getPointIndices() const;
+
+			///Appends the indices of all points within radius of center
+			void findInRadius(const ofVec3f & center, float radius, std::vector<uint32_t> & results) const;
+
+			///One vertex per occupied voxel, at the mean position (and mean color / texture coordinate) of its points.
+			///input must be the mesh whose vertices the grid was built from.
+			void downsample(const ofMesh & input, ofMesh & output) const;
+
+			///Flags points whose mean distance to their nearest neighbours is more than standardDeviations above the mean of all points.
+			///Neighbours are searched for within one voxel, so points with no neighbours in that range are always flagged.
+			std::vector<uint8_t> findStatisticalOutliers(int neighbourCount, float standardDeviations) const;
+		protected:
+			uint64_t getKey(int x, int y, int z) const;
+			void getVoxel(const ofVec3f & point, int & x, int & y, int & z) const;
+
+			const std::vector<ofVec3f> * points;
+			float voxelSize;
+
+			std::vector<Cell> cells;
+			std::vector<uint32_t> pointIndices;
+			std::unordered_map<uint64_t, uint32_t> cellLookup;
+		};
+	}
+}
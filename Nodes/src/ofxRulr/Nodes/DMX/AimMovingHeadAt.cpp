@@ -76,14 +76,14 @@ namespace ofxRulr {
 						//get either the raw position or the predicted position
 						ofVec3f aimFor;
 						if(this->steveJobs.enabled) {
-							aimFor = this->doASteveJobs(target->getPosition());
+							aimFor = this->doASteveJobs(target->getWorldPosition());
 						}
 						else {
-							aimFor = target->getPosition();
+							aimFor = target->getWorldPosition();
 						}
 
 						//calculate the position offset in target coords
-						const auto objectRotation = target->getRotationQuat();
+						const auto objectRotation = target->getWorldRotationQuat();
 						const auto offset = this->getObjectPositionOffset() * objectRotation;
 
 						//perform the lookAt
@@ -0,0 +1,55 @@
+#include "ArtNet.h"
+
+#define ARTNET_HEADER_SIZE 18
+#define ARTNET_OP_OUTPUT 0x5000
+#define ARTNET_PROTOCOL_VERSION 14
+
+namespace ofxRulr {
+	namespace Nodes {
+		namespace DMX {
+			//----------
+			ArtNet::ArtNet() {
+
+			}
+
+			//----------
+			ArtNet::~ArtNet() {
+				this->stopOutputThread();
+			}
+
+			//----------
+			string ArtNet::getTypeName() const {
+				return "DMX::ArtNet";
+			}
+
+			//----------
+			size_t ArtNet::getPacketSize() const {
+				return ARTNET_HEADER_SIZE + 512;
+			}
+
+			//----------
+			void ArtNet::writePacket(uint16_t universeNumber, const Value * channels, uint8_t sequence, uint8_t * packet) const {
+				memcpy(packet, "Art-Net\0", 8);
+				packet[8] = ARTNET_OP_OUTPUT & 0xff; // op code lsb first
+				packet[9] = ARTNET_OP_OUTPUT >> 8;
+				packet[10] = 0; // protocol version msb first
+				packet[11] = ARTNET_PROTOCOL_VERSION;
+				packet[12] = sequence % 255 + 1; // 0 would disable sequencing
+				packet[13] = 0; // physical port
+				packet[14] = universeNumber & 0xff; // sub-net and universe
+				packet[15] = (universeNumber >> 8) & 0x7f; // net
+				packet[16] = 512 >> 8; // length msb first
+				packet[17] = 512 & 0xff;
+				memcpy(packet + ARTNET_HEADER_SIZE, channels + 1, 512);
+			}
+
+			//----------
+			Poco::Net::SocketAddress ArtNet::getDestination(uint16_t) const {
+				const auto address = this->hasDestinationAddress
+					? this->destinationAddress
+					: Poco::Net::IPAddress::broadcast();
+				return Poco::Net::SocketAddress(address, RULR_ARTNET_PORT);
+			}
+		}
+	}
+}
@@ -0,0 +1,23 @@
+#pragma once
+
+#include "NetworkTransmit.h"
+
+#define RULR_ARTNET_PORT 6454
+
+namespace ofxRulr {
+	namespace Nodes {
+		namespace DMX {
+			///Sends universes as Art-Net ArtDmx packets. With no address set, packets are broadcast.
+			class ArtNet : public NetworkTransmit {
+			public:
+				ArtNet();
+				~ArtNet();
+				string getTypeName() const override;
+			protected:
+				size_t getPacketSize() const override;
+				void writePacket(uint16_t universeNumber, const Value * channels, uint8_t sequence, uint8_t * packet) const override;
+				Poco::Net::SocketAddress getDestination(uint16_t universeNumber) const override;
+			};
+		}
+	}
+}
@@ -60,33 +60,41 @@ namespace ofxRulr {
 
 			//----------
 			void Fixture::update() {
-				//calculate DMX
-				vector<DMX::Value> output;
-				for (int i = 0; i < this->channels.size(); i++) {
-					auto channel = this->channels[i];
+				//count the channels we output (up to the first disabled channel)
+				size_t channelCount = 0;
+				for (const auto & channel : this->channels) {
 					if (channel->enabled.get() == false) {
-						//break on first disabled channel
 						break;
 					}
-					auto & generator = channel->generateValue;
-					if (generator) {
-						auto value = generator();
-						channel->value.set(value);
-					}
-					output.push_back(this->channels[i]->value);
+					channelCount++;
 				}
-				
-				//transmit DMX
+
+				//find the universe we write into
+				shared_ptr<Transmit::Universe> universe;
 				auto transmit = this->getInput<DMX::Transmit>();
 				if (transmit) {
-					const auto & universes = transmit->getUniverses();
-					auto universe = transmit->getUniverse(this->universeIndex.get());
-					if (universe) {
-						universe->setChannels(this->channelIndex.get(), &output[0], output.size());
-					}
-					else {
+					universe = transmit->getUniverse(this->universeIndex.get());
+					if (!universe) {
 						RULR_ERROR << "Universe index " << this->universeIndex << " is out of bounds for this sender";
 					}
+					else if (this->channelIndex.get() + channelCount > 513) {
+						RULR_ERROR << "ofxRulr::Nodes::DMX::Fixture : Channel range " << this->channelIndex.get() << "->" << (this->channelIndex.get() + channelCount) << " is invalid";
+						universe.reset();
+					}
+				}
+
+				//calculate DMX straight into the universe. parameters (and their listeners) and universe channels are only touched when the value changes
+				for (size_t i = 0; i < channelCount; i++) {
+					auto & channel = * this->channels[i];
+					if (channel.generateValue) {
+						auto value = channel.generateValue();
+						if (channel.value.get() != value) {
+							channel.value.set(value);
+						}
+					}
+					if (universe) {
+						universe->setChannel(this->channelIndex.get() + i, (DMX::Value) channel.value.get());
+					}
 				}
 			}
 
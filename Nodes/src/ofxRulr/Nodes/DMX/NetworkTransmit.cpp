@@ -0,0 +1,189 @@
+#include "NetworkTransmit.h"
+
+#include "ofxCvGui/Widgets/EditableValue.h"
+#include "ofxCvGui/Widgets/LiveValue.h"
+#include "ofxCvGui/Widgets/Title.h"
+
+using namespace ofxCvGui;
+
+namespace ofxRulr {
+	namespace Nodes {
+		namespace DMX {
+			//----------
+			NetworkTransmit::NetworkTransmit() :
+			hasDestinationAddress(false),
+			firstUniverseOutput(0),
+			keepAliveIntervalOutput(1.0f),
+			packetsSent(0) {
+				RULR_NODE_INIT_LISTENER;
+			}
+
+			//----------
+			NetworkTransmit::~NetworkTransmit() {
+				this->stopOutputThread();
+				this->disconnect();
+			}
+
+			//----------
+			void NetworkTransmit::init() {
+				RULR_NODE_UPDATE_LISTENER;
+				RULR_NODE_SERIALIZATION_LISTENERS;
+				RULR_NODE_INSPECTOR_LISTENER;
+
+				this->universeCount.set("Universe count", 1, 1, 1024);
+				this->firstUniverse.set("First universe", 0, 0, 32767);
+				this->address.set("Address", "");
+				this->keepAliveInterval.set("Keep alive interval [s]", 1.0f, 0.1f, 10.0f);
+
+				this->connect();
+			}
+
+			//----------
+			void NetworkTransmit::update() {
+				if (this->universeCount.get() != this->getUniverseCount()) {
+					this->setUniverseCount(ofClamp(this->universeCount.get(), this->universeCount.getMin(), this->universeCount.getMax()));
+				}
+				this->firstUniverseOutput = this->firstUniverse.get();
+				this->keepAliveIntervalOutput = this->keepAliveInterval.get();
+			}
+
+			//----------
+			void NetworkTransmit::serialize(Json::Value & json) {
+				Utils::Serializable::serialize(this->universeCount, json);
+				Utils::Serializable::serialize(this->firstUniverse, json);
+				Utils::Serializable::serialize(this->address, json);
+				Utils::Serializable::serialize(this->keepAliveInterval, json);
+			}
+
+			//----------
+			void NetworkTransmit::deserialize(const Json::Value & json) {
+				Utils::Serializable::deserialize(this->universeCount, json);
+				Utils::Serializable::deserialize(this->firstUniverse, json);
+				Utils::Serializable::deserialize(this->address, json);
+				Utils::Serializable::deserialize(this->keepAliveInterval, json);
+				this->connect();
+			}
+
+			//----------
+			uint64_t NetworkTransmit::getPacketsSent() const {
+				return this->packetsSent;
+			}
+
+			//----------
+			void NetworkTransmit::populateInspector(ofxCvGui::ElementGroupPtr inspector) {
+				inspector->add(Widgets::Title::make("Network", Widgets::Title::Level::H2));
+				inspector->add(Widgets::EditableValue<int>::make(this->universeCount));
+				inspector->add(Widgets::EditableValue<int>::make(this->firstUniverse));
+
+				auto addressWidget = Widgets::EditableValue<string>::make(this->address);
+				addressWidget->onEditValue += [this](string &) {
+					this->connect();
+				};
+				inspector->add(addressWidget);
+
+				inspector->add(Widgets::EditableValue<float>::make(this->keepAliveInterval));
+				inspector->add(Widgets::LiveValue<string>::make("Packets sent", [this]() {
+					return ofToString(this->getPacketsSent());
+				}));
+			}
+
+			//----------
+			void NetworkTransmit::connect() {
+				this->disconnect();
+
+				//the output thread mustn't see the socket until it's ready
+				lock_guard<mutex> lock(this->outputLock);
+				try {
+					this->hasDestinationAddress = !this->address.get().empty();
+					if (this->hasDestinationAddress) {
+						this->destinationAddress = Poco::Net::IPAddress(this->address.get());
+					}
+
+					auto socket = make_shared<Poco::Net::DatagramSocket>(Poco::Net::IPAddress::IPv4);
+					socket->setBroadcast(true);
+					this->socket = socket;
+				}
+				RULR_CATCH_ALL_TO_ALERT;
+			}
+
+			//----------
+			void NetworkTransmit::disconnect() {
+				lock_guard<mutex> lock(this->outputLock);
+				if (this->socket) {
+					this->socket->close();
+					this->socket.reset();
+				}
+
+				//destinations and sequences start again with the next socket
+				this->universeStates.clear();
+				this->batch.clear();
+				this->batchUniverses.clear();
+			}
+
+			//----------
+			void NetworkTransmit::sendUniverse(UniverseIndex universeIndex, const Value * channels) {
+				if (!this->socket) {
+					return;
+				}
+
+				if (universeIndex >= this->universeStates.size()) {
+					UniverseState universeState;
+					universeState.sent = false;
+					universeState.sequence = 0;
+					universeState.universeNumber = 0;
+					this->universeStates.resize(universeIndex + 1, universeState);
+				}
+				auto & universeState = this->universeStates[universeIndex];
+
+				//only send what has changed, plus a keep alive for each universe now and again
+				const auto now = chrono::steady_clock::now();
+				const auto universeNumber = (uint16_t) (this->firstUniverseOutput + universeIndex);
+				const auto moved = !universeState.sent || universeState.universeNumber != universeNumber;
+				const auto changed = moved || memcmp(universeState.sentChannels, channels, 513) != 0;
+				const auto keepAliveDue = chrono::duration<float>(now - universeState.sendTime).count() >= this->keepAliveIntervalOutput;
+				if (!changed && !keepAliveDue) {
+					return;
+				}
+
+				if (moved) {
+					universeState.universeNumber = universeNumber;
+					universeState.destination = this->getDestination(universeNumber);
+				}
+				memcpy(universeState.sentChannels, channels, 513);
+				universeState.sent = true;
+				universeState.sendTime = now;
+
+				//the batch keeps its capacity between passes
+				const auto packetSize = this->getPacketSize();
+				const auto offset = this->batch.size();
+				this->batch.resize(offset + packetSize);
+				this->writePacket(universeNumber, channels, universeState.sequence++, this->batch.data() + offset);
+				this->batchUniverses.push_back(universeIndex);
+			}
+
+			//----------
+			void NetworkTransmit::flush() {
+				if (this->socket) {
+					const auto packetSize = this->getPacketSize();
+					for (size_t i = 0; i < this->batchUniverses.size(); i++) {
+						const auto & destination = this->universeStates[this->batchUniverses[i]].destination;
+						try {
+							this->socket->sendTo(this->batch.data() + i * packetSize, (int) packetSize, destination);
+							this->packetsSent++;
+						}
+						catch (const Poco::Exception & e) {
+							//e.g. the network is down. what didn't go out will be sent again on the next pass
+							ofLogWarning("NetworkTransmit") << e.displayText();
+							for (auto j = i; j < this->batchUniverses.size(); j++) {
+								this->universeStates[this->batchUniverses[j]].sent = false;
+							}
+							break;
+						}
+					}
+				}
+				this->batch.clear();
+				this->batchUniverses.clear();
+			}
+		}
+	}
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include "Transmit.h"
+
+#include "Poco/Net/DatagramSocket.h"
+#include "Poco/Net/IPAddress.h"
+#include "Poco/Net/SocketAddress.h"
+
+#include <chrono>
+
+namespace ofxRulr {
+	namespace Nodes {
+		namespace DMX {
+			/**
+			Base for transmitters which send each universe as a UDP packet (e.g. Art-Net, sACN).
+			All universes go out from one socket. On each pass of the output thread, the packets for universes
+			whose channels have changed (or which are due a keep alive) are written into one buffer and then sent back to back.
+			**/
+			class NetworkTransmit : public DMX::Transmit {
+			public:
+				NetworkTransmit();
+				virtual ~NetworkTransmit();
+				void init();
+				void update();
+
+				void serialize(Json::Value &);
+				void deserialize(const Json::Value &);
+
+				uint64_t getPacketsSent() const;
+			protected:
+				void populateInspector(ofxCvGui::ElementGroupPtr);
+
+				void connect();
+				void disconnect();
+
+				void sendUniverse(UniverseIndex, const Value * channels) override;
+				void flush() override;
+
+				///Bytes in one packet of this protocol
+				virtual size_t getPacketSize() const = 0;
+				///Write a complete packet for this universe number (first universe + universe index) into packet
+				virtual void writePacket(uint16_t universeNumber, const Value * channels, uint8_t sequence, uint8_t * packet) const = 0;
+				///Where to send this universe number. hasDestinationAddress is true if the address parameter isn't empty
+				virtual Poco::Net::SocketAddress getDestination(uint16_t universeNumber) const = 0;
+
+				ofParameter<int> universeCount;
+				ofParameter<int> firstUniverse;
+				ofParameter<string> address; // can be left empty if the protocol has a default (e.g. multicast)
+				ofParameter<float> keepAliveInterval;
+
+				//set in connect() whilst holding outputLock, which also clears universeStates
+				shared_ptr<Poco::Net::DatagramSocket> socket;
+				Poco::Net::IPAddress destinationAddress;
+				bool hasDestinationAddress;
+
+				//mirrors of the parameters for the output thread
+				atomic<int> firstUniverseOutput;
+				atomic<float> keepAliveIntervalOutput;
+
+				//used only on the output thread
+				struct UniverseState {
+					Value sentChannels[513];
+					bool sent;
+					uint8_t sequence;
+					chrono::steady_clock::time_point sendTime;
+					uint16_t universeNumber;
+					Poco::Net::SocketAddress destination; // for universeNumber
+				};
+				vector<UniverseState> universeStates;
+				vector<uint8_t> batch; // packets waiting for flush
+				vector<UniverseIndex> batchUniverses;
+				atomic<uint64_t> packetsSent;
+			};
+		}
+	}
+}
@@ -0,0 +1,143 @@
+#include "SACN.h"
+
+#include "ofxCvGui/Widgets/Slider.h"
+#include "ofxCvGui/Widgets/Title.h"
+
+#include <random>
+
+//byte offsets of each layer of a full (512 slot) data packet
+#define SACN_ROOT_LAYER 16
+#define SACN_FRAMING_LAYER 38
+#define SACN_DMP_LAYER 115
+#define SACN_PACKET_SIZE 638
+#define SACN_SOURCE_NAME "ofxRulr"
+
+using namespace ofxCvGui;
+
+namespace ofxRulr {
+	namespace Nodes {
+		namespace DMX {
+			//----------
+			static void writeFlagsAndLength(uint8_t * destination, size_t layerOffset) {
+				const auto length = (uint16_t) (SACN_PACKET_SIZE - layerOffset);
+				destination[0] = 0x70 | (length >> 8);
+				destination[1] = length & 0xff;
+			}
+
+			//----------
+			SACN::SACN() :
+			priorityOutput(100) {
+				RULR_NODE_INIT_LISTENER;
+
+				random_device randomDevice;
+				for (auto & byte : this->cid) {
+					byte = (uint8_t) randomDevice();
+				}
+			}
+
+			//----------
+			SACN::~SACN() {
+				this->stopOutputThread();
+			}
+
+			//----------
+			void SACN::init() {
+				RULR_NODE_UPDATE_LISTENER;
+				RULR_NODE_SERIALIZATION_LISTENERS;
+				RULR_NODE_INSPECTOR_LISTENER;
+
+				this->priority.set("Priority", 100, 0, 200);
+
+				//universe 0 is reserved in sACN
+				this->firstUniverse.set("First universe", 1, 1, 63999);
+			}
+
+			//----------
+			void SACN::update() {
+				this->priorityOutput = (uint8_t) ofClamp(this->priority.get(), 0, 200);
+			}
+
+			//----------
+			string SACN::getTypeName() const {
+				return "DMX::SACN";
+			}
+
+			//----------
+			void SACN::serialize(Json::Value & json) {
+				Utils::Serializable::serialize(this->priority, json);
+
+				string cidString;
+				for (auto byte : this->cid) {
+					cidString += ofToHex(byte);
+				}
+				json["cid"] = cidString;
+			}
+
+			//----------
+			void SACN::deserialize(const Json::Value & json) {
+				Utils::Serializable::deserialize(this->priority, json);
+
+				const auto cidString = json["cid"].asString();
+				if (cidString.size() == sizeof(this->cid) * 2) {
+					lock_guard<mutex> lock(this->outputLock);
+					for (int i = 0; i < sizeof(this->cid); i++) {
+						this->cid[i] = (uint8_t) ofHexToInt(cidString.substr(i * 2, 2));
+					}
+				}
+			}
+
+			//----------
+			void SACN::populateInspector(ofxCvGui::ElementGroupPtr inspector) {
+				inspector->add(Widgets::Title::make("sACN", Widgets::Title::Level::H2));
+				inspector->add(Widgets::Slider::make(this->priority));
+			}
+
+			//----------
+			size_t SACN::getPacketSize() const {
+				return SACN_PACKET_SIZE;
+			}
+
+			//----------
+			void SACN::writePacket(uint16_t universeNumber, const Value * channels, uint8_t sequence, uint8_t * packet) const {
+				memset(packet, 0, SACN_PACKET_SIZE);
+
+				//root layer
+				packet[1] = 0x10; // preamble size
+				memcpy(packet + 4, "ASC-E1.17\0\0\0", 12);
+				writeFlagsAndLength(packet + SACN_ROOT_LAYER, SACN_ROOT_LAYER);
+				packet[21] = 0x04; // VECTOR_ROOT_E131_DATA
+				memcpy(packet + 22, this->cid, 16);
+
+				//framing layer
+				writeFlagsAndLength(packet + SACN_FRAMING_LAYER, SACN_FRAMING_LAYER);
+				packet[43] = 0x02; // VECTOR_E131_DATA_PACKET
+				memcpy(packet + 44, SACN_SOURCE_NAME, sizeof(SACN_SOURCE_NAME)); // 64 bytes, null terminated
+				packet[108] = this->priorityOutput;
+				packet[111] = sequence;
+				packet[113] = universeNumber >> 8;
+				packet[114] = universeNumber & 0xff;
+
+				//DMP layer
+				writeFlagsAndLength(packet + SACN_DMP_LAYER, SACN_DMP_LAYER);
+				packet[117] = 0x02; // VECTOR_DMP_SET_PROPERTY
+				packet[118] = 0xa1; // address and data type
+				packet[122] = 0x01; // address increment
+				packet[123] = 513 >> 8; // property value count
+				packet[124] = 513 & 0xff;
+				packet[125] = 0; // start code
+				memcpy(packet + 126, channels + 1, 512);
+			}
+
+			//----------
+			Poco::Net::SocketAddress SACN::getDestination(uint16_t universeNumber) const {
+				if (this->hasDestinationAddress) {
+					return Poco::Net::SocketAddress(this->destinationAddress, RULR_SACN_PORT);
+				}
+				else {
+					const auto multicastAddress = "239.255." + ofToString(universeNumber >> 8) + "." + ofToString(universeNumber & 0xff);
+					return Poco::Net::SocketAddress(multicastAddress, RULR_SACN_PORT);
+				}
+			}
+		}
+	}
+}
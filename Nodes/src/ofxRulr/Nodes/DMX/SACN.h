@@ -0,0 +1,35 @@
+#pragma once
+
+#include "NetworkTransmit.h"
+
+#define RULR_SACN_PORT 5568
+
+namespace ofxRulr {
+	namespace Nodes {
+		namespace DMX {
+			///Sends universes as sACN (ANSI E1.31) data packets. With no address set, each universe goes to its multicast group.
+			class SACN : public NetworkTransmit {
+			public:
+				SACN();
+				~SACN();
+				void init();
+				void update();
+				string getTypeName() const override;
+
+				void serialize(Json::Value &);
+				void deserialize(const Json::Value &);
+			protected:
+				void populateInspector(ofxCvGui::ElementGroupPtr);
+
+				size_t getPacketSize() const override;
+				void writePacket(uint16_t universeNumber, const Value * channels, uint8_t sequence, uint8_t * packet) const override;
+				Poco::Net::SocketAddress getDestination(uint16_t universeNumber) const override;
+
+				ofParameter<int> priority;
+				atomic<uint8_t> priorityOutput;
+
+				uint8_t cid[16]; // identifies this source to receivers, kept with the patch
+			};
+		}
+	}
+}
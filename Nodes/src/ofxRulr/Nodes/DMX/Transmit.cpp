@@ -2,8 +2,12 @@
 #include "ofxCvGui/Panels/Scroll.h"
 #include "ofxCvGui/Widgets/Title.h"
 #include "ofxCvGui/Widgets/Toggle.h"
+#include "ofxCvGui/Widgets/Slider.h"
+#include "ofxCvGui/Widgets/LiveValue.h"
 #include "ofxCvGui/Utils/Utils.h"
 
+#include <chrono>
+
 using namespace ofxCvGui;
 
 namespace ofxRulr {
@@ -12,7 +16,10 @@ namespace ofxRulr {
 #pragma mark Transmit::Universe
 			//----------
 			Transmit::Universe::Universe() {
-				this->clearChannels();
+				memset(this->values, 0, 513);
+				this->changedBegin = 0;
+				this->changedEnd = 513;
+				this->publish();
 				this->previewDirty = true;
 				this->preview.allocate(32, 16, GL_LUMINANCE);
 				this->preview.setTextureMinMagFilter(GL_NEAREST, GL_NEAREST);
@@ -24,20 +31,19 @@ namespace ofxRulr {
 				if (channel > 512) {
 					RULR_ERROR << "ofxRulr::Nodes::DMX::Transmit : Channel index " << (int)(channel) << " is invalid";
 				}
-				else {
+				else if (this->values[channel] != value) {
 					this->values[channel] = value;
-					this->previewDirty = true;
+					this->markChanged(channel, channel + 1);
 				}
 			}
 
 			//----------
-			void Transmit::Universe::setChannels(ChannelIndex channelOffset, Value * values, ChannelIndex count) {
-				if (channelOffset + count > 512) {
+			void Transmit::Universe::setChannels(ChannelIndex channelOffset, const Value * values, ChannelIndex count) {
+				if (channelOffset + count > 513) {
 					RULR_ERROR << "ofxRulr::Nodes::DMX::Transmit : Channel range " << (int)(channelOffset) << "->" << (int) (channelOffset + count) << " is invalid";
 				}
 				else {
-					memcpy(this->values + channelOffset, values, count);
-					this->previewDirty = true;
+					this->writeChannels(channelOffset, values, count);
 				}
 			}
 
@@ -57,39 +63,100 @@ namespace ofxRulr {
 
 			//----------
 			void Transmit::Universe::clearChannels() {
-				memset(this->values, 0, 513);
+				static const Value zeros[513] = { 0 };
+				this->writeChannels(0, zeros, 513);
+			}
+
+			//----------
+			void Transmit::Universe::publish() {
+				if (this->changedBegin >= this->changedEnd) {
+					return;
+				}
+
+				lock_guard<mutex> lock(this->publishedValuesLock);
+				memcpy(this->publishedValues + this->changedBegin, this->values + this->changedBegin, this->changedEnd - this->changedBegin);
+				this->changedBegin = 513;
+				this->changedEnd = 0;
+			}
+
+			//----------
+			void Transmit::Universe::getPublishedChannels(Value * channels) const {
+				lock_guard<mutex> lock(this->publishedValuesLock);
+				memcpy(channels, this->publishedValues, 513);
+			}
+
+			//----------
+			void Transmit::Universe::writeChannels(ChannelIndex channelOffset, const Value * values, ChannelIndex count) {
+				//find the span which actually differs, and only write that
+				auto destination = this->values + channelOffset;
+				ChannelIndex begin = 0;
+				while (begin < count && destination[begin] == values[begin]) {
+					begin++;
+				}
+				if (begin == count) {
+					return;
+				}
+				auto end = count;
+				while (destination[end - 1] == values[end - 1]) {
+					end--;
+				}
+
+				memcpy(destination + begin, values + begin, end - begin);
+				this->markChanged(channelOffset + begin, channelOffset + end);
+			}
+
+			//----------
+			void Transmit::Universe::markChanged(ChannelIndex begin, ChannelIndex end) {
+				this->changedBegin = min(this->changedBegin, begin);
+				this->changedEnd = max(this->changedEnd, end);
 				this->previewDirty = true;
 			}
 
 #pragma mark Transmit
 			//----------
-			Transmit::Transmit() {
+			Transmit::Transmit() :
+			outputClosing(false),
+			outputPeriod(1.0f / 44.0f),
+			outputRate(0.0f) {
 				RULR_NODE_INIT_LISTENER;
 				RULR_NODE_UPDATE_LISTENER;
 				RULR_NODE_INSPECTOR_LISTENER;
 				RULR_NODE_SERIALIZATION_LISTENERS;
 			}
 
+			//----------
+			Transmit::~Transmit() {
+				this->stopOutputThread();
+			}
+
 			//----------
 			void Transmit::init() {
 				this->view = make_shared<Panels::Scroll>();
 				this->setUniverseCount(1);
+				this->refreshRate.set("Refresh rate [Hz]", 44.0f, 1.0f, 44.0f);
 				this->firstFrame = true;
 			}
 
 			//----------
 			void Transmit::update() {
+				this->outputPeriod = 1.0f / ofClamp(this->refreshRate.get(), this->refreshRate.getMin(), this->refreshRate.getMax());
+
+				//this frame's values go out together, at the output thread's own pace
+				for (const auto & universe : this->universes) {
+					if (universe->blackoutEnabled) {
+						universe->clearChannels();
+					}
+					universe->publish();
+				}
+
 				if (this->firstFrame) {
 					//don't send on first frame
 					this->firstFrame = false;
 				}
-				else {
-					for (int i = 0; i < this->universes.size(); i++) {
-						if (this->universes[i]->blackoutEnabled) {
-							this->universes[i]->clearChannels();
-						}
-						this->sendUniverse(i, this->universes[i]);
-					}
+				else if (!this->outputThread.joinable()) {
+					this->outputThread = thread([this]() {
+						this->outputThreadLoop();
+					});
 				}
 			}
 
@@ -105,6 +172,8 @@ namespace ofxRulr {
 
 			//----------
 			void Transmit::serialize(Json::Value & json) {
+				Utils::Serializable::serialize(this->refreshRate, json);
+
 				auto & jsonUniverses = json["universes"];
 				for (int i = 0; i < this->universes.size(); i++) {
 					auto & jsonUniverse = jsonUniverses[ofToString(i)];
@@ -114,6 +183,8 @@ namespace ofxRulr {
 
 			//----------
 			void Transmit::deserialize(const Json::Value & json) {
+				Utils::Serializable::deserialize(this->refreshRate, json);
+
 				const auto & jsonUniverses = json["universes"];
 				for (int i = 0; i < this->universes.size(); i++) {
 					const auto & jsonUniverse = json[ofToString(i)];
@@ -123,6 +194,11 @@ namespace ofxRulr {
 
 			//----------
 			void Transmit::populateInspector(ofxCvGui::ElementGroupPtr inspector) {
+				inspector->add(Widgets::Slider::make(this->refreshRate));
+				inspector->add(Widgets::LiveValue<float>::make("Output rate [Hz]", [this]() {
+					return this->getOutputRate();
+				}));
+
 				for (int i = 0; i < this->universes.size(); i++) {
 					inspector->add(Widgets::Title::make("Universe " + ofToString(i)));
 					inspector->add(Widgets::Toggle::make(this->universes[i]->blackoutEnabled));
@@ -150,14 +226,22 @@ namespace ofxRulr {
 				}
 			}
 
+			//----------
+			float Transmit::getOutputRate() const {
+				return this->outputRate;
+			}
+
 			//----------
 			void Transmit::setUniverseCount(UniverseIndex universeCount) {
-				if (this->universes.size() > universeCount) {
-					this->universes.resize(universeCount);
-				}
-				else {
-					while (universeCount > this->universes.size()) {
-						this->universes.push_back(make_shared<Universe>());
+				{
+					lock_guard<mutex> lock(this->universesLock);
+					if (this->universes.size() > universeCount) {
+						this->universes.resize(universeCount);
+					}
+					else {
+						while (universeCount > this->universes.size()) {
+							this->universes.push_back(make_shared<Universe>());
+						}
 					}
 				}
 
@@ -180,6 +264,56 @@ namespace ofxRulr {
 					this->view->add(preview);
 				}
 			}
+
+			//----------
+			void Transmit::stopOutputThread() {
+				{
+					lock_guard<mutex> lock(this->outputLock);
+					this->outputClosing = true;
+				}
+				this->outputCondition.notify_all();
+				if (this->outputThread.joinable()) {
+					this->outputThread.join();
+				}
+			}
+
+			//----------
+			void Transmit::outputThreadLoop() {
+				typedef chrono::steady_clock Clock;
+				Value channels[513];
+				auto nextSend = Clock::now();
+				auto lastSend = nextSend;
+
+				unique_lock<mutex> lock(this->outputLock);
+				while (!this->outputClosing) {
+					vector<shared_ptr<Universe>> universes;
+					{
+						lock_guard<mutex> universesLock(this->universesLock);
+						universes = this->universes;
+					}
+					for (int i = 0; i < universes.size(); i++) {
+						universes[i]->getPublishedChannels(channels);
+						this->sendUniverse(i, channels);
+					}
+					this->flush();
+
+					auto now = Clock::now();
+					const auto interval = chrono::duration<float>(now - lastSend).count();
+					if (interval > 0.0f) {
+						this->outputRate = 1.0f / interval;
+					}
+					lastSend = now;
+
+					//keep a steady cadence, but don't try to catch up on sends we missed
+					nextSend += chrono::duration_cast<Clock::duration>(chrono::duration<float>(this->outputPeriod.load()));
+					if (nextSend < now) {
+						nextSend = now;
+					}
+					this->outputCondition.wait_until(lock, nextSend, [this]() {
+						return this->outputClosing;
+					});
+				}
+			}
 		}
 	}
 }
\ No newline at end of file
@@ -5,6 +5,11 @@
 
 #include "Base.h"
 
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
 namespace ofxRulr {
 	namespace Nodes {
 		namespace DMX {
@@ -13,19 +18,33 @@ namespace ofxRulr {
 				class Universe {
 				public:
 					Universe();
+
+					///Only channels whose values differ are written and marked as changed
 					void setChannel(ChannelIndex channel, Value value);
-					void setChannels(ChannelIndex channelOffset, Value * values, ChannelIndex count);
+					void setChannels(ChannelIndex channelOffset, const Value * values, ChannelIndex count);
 					const Value * getChannels() const;
-					const ofTexture & getTextureReference();
+					const ofTexture & getTextureReference(); // uploads only if a channel has changed since the last call
 					void clearChannels();
+
+					///Copy the channels changed since the last publish (written by fixtures on the main thread) to the buffer which the output thread sends
+					void publish();
+					void getPublishedChannels(Value * channels) const; // 513 values
 					ofParameter<bool> blackoutEnabled;
 				protected:
+					void writeChannels(ChannelIndex channelOffset, const Value * values, ChannelIndex count);
+					void markChanged(ChannelIndex begin, ChannelIndex end);
+
 					Value values[513]; // 0th channel is unused
+					ChannelIndex changedBegin; // channels [changedBegin, changedEnd) have changed since the last publish
+					ChannelIndex changedEnd;
+					Value publishedValues[513];
+					mutable mutex publishedValuesLock;
 					ofTexture preview;
 					bool previewDirty;
 				};
 
 				Transmit();
+				virtual ~Transmit();
 				void init();
 				void update();
 				virtual string getTypeName() const override;
@@ -38,12 +57,34 @@ namespace ofxRulr {
 				UniverseIndex getUniverseCount() const;
 				const vector<shared_ptr<Universe>> & getUniverses() const;
 				shared_ptr<Universe> getUniverse(UniverseIndex universeIndex) const;
+				float getOutputRate() const; // [Hz] as measured on the output thread
 			protected:
 				void setUniverseCount(UniverseIndex);
-				virtual void sendUniverse(UniverseIndex, shared_ptr<Universe>) { }
+
+				///Called on the output thread at the refresh rate, with 513 channels (the 0th is unused).
+				///Implementations should lock outputLock whenever they change what sendUniverse uses (e.g. when reconnecting).
+				virtual void sendUniverse(UniverseIndex, const Value * channels) { }
+
+				///Called on the output thread after sendUniverse has been called for every universe
+				virtual void flush() { }
+
+				///Subclasses which override sendUniverse (or anything that it calls) must call this in their destructor
+				void stopOutputThread();
+				void outputThreadLoop();
+
 				shared_ptr<ofxCvGui::Panels::Scroll> view;
 
 				vector<shared_ptr<Universe>> universes;
+				mutex universesLock; // the output thread reads the list of universes
+
+				ofParameter<float> refreshRate;
+
+				thread outputThread;
+				mutex outputLock; // held by the output thread whilst sending, and guards outputClosing
+				condition_variable outputCondition;
+				bool outputClosing;
+				atomic<float> outputPeriod; // [s] 1 / refreshRate, readable from the output thread
+				atomic<float> outputRate;
 
 				bool firstFrame;
 			};
@@ -1,8 +1,8 @@
-#pragma once
-
-namespace ofxRulr {
-	namespace Nodes {
-		void loadCoreNodes();
-		void loadPluginNodes();
-	}
+#pragma once
+
+namespace ofxRulr {
+	namespace Nodes {
+		void loadCoreNodes();
+		void loadPluginNodes();
+	}
 }
\ No newline at end of file
@@ -1,18 +1,18 @@
-#pragma once
-
-#include "ofxRulr/Nodes/Base.h"
-
-#include "ofParameter.h"
-
-using namespace std;
-
-namespace ofxRulr {
-	namespace Nodes {
-		namespace Item {
-			class Base : public Nodes::Base {
-			public:
-
-			};
-		}
-	}
+#pragma once
+
+#include "ofxRulr/Nodes/Base.h"
+
+#include "ofParameter.h"
+
+using namespace std;
+
+namespace ofxRulr {
+	namespace Nodes {
+		namespace Item {
+			class Base : public Nodes::Base {
+			public:
+
+			};
+		}
+	}
 }
\ No newline at end of file
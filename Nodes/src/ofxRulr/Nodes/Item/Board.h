@@ -3,6 +3,8 @@
 #include "Base.h"
 #include "ofxCvMin.h"
 
+#include "ofxRulr/Utils/ChessboardFinder.h"
+
 namespace ofxRulr {
 	namespace Nodes {
 		namespace Item {
@@ -12,6 +14,7 @@ namespace ofxRulr {
 				void init();
 				string getTypeName() const override;
 				ofxCvGui::PanelPtr getView();
+				Utils::Bounds getWorldBounds() const override;
 
 				void serialize(Json::Value &);
 				void deserialize(const Json::Value &);
@@ -20,6 +23,10 @@ namespace ofxRulr {
 				cv::Size getSize() const;
 				vector<cv::Point3f> getObjectPoints() const;
 
+				///With multi-scale search and useOptimisers enabled, checkerboards are found on a downsampled image and refined at full resolution.
+				///The finder keeps its pyramid and the size of the last detection, so pass one finder per image stream.
+				bool findBoard(cv::Mat, vector<cv::Point2f> & result, Utils::ChessboardFinder &, bool useOptimisers = true) const;
+				///For one-off searches, which have no previous detection to size the search from
 				bool findBoard(cv::Mat, vector<cv::Point2f> & result, bool useOptimisers = true) const;
 			protected:
 				void populateInspector(ofxCvGui::ElementGroupPtr);
@@ -29,6 +36,9 @@ namespace ofxRulr {
 				ofParameter<int> boardType; // 0 = checkerboard, 1 = circles
 				ofParameter<float> sizeX, sizeY;
 				ofParameter<float> spacing;
+				ofParameter<bool> multiScaleSearch;
+				ofParameter<int> searchWidth;
+
 				ofMesh previewMesh;
 			};
 		}
@@ -1,355 +1,521 @@
-#include "Camera.h"
-#include "ofxCvGui.h"
-
-using namespace ofxCvGui;
-using namespace ofxMachineVision;
-using namespace cv;
-
-namespace ofxRulr {
-	namespace Nodes {
-		namespace Item {
-			//----------
-			Camera::Camera() : View(true) {
-				RULR_NODE_INIT_LISTENER;
-			}
-
-			//----------
-			void Camera::init() {
-				RULR_NODE_UPDATE_LISTENER;
-				RULR_NODE_SERIALIZATION_LISTENERS;
-				RULR_NODE_INSPECTOR_LISTENER;
-
-				this->placeholderView = make_shared<Panels::Groups::Grid>();
-
-				this->deviceIndex.set("Device index", 0);
-				this->deviceTypeName.set("Device type name", "uninitialised"); // this should be different from the setDevice("") call below
-
-				this->showSpecification.set("Show specification", false);
-				this->showFocusLine.set("Show focus line", true);
-				this->exposure.set("Exposure [us]", 500.0f, 0.0f, 1000000.0f);
-				this->gain.set("Gain", 0.5f, 0.0f, 1.0f);
-				this->focus.set("Focus ", 0.5f, 0.0f, 1.0f);
-				this->sharpness.set("Sharpness", 0.5f, 0.0f, 1.0f);
-
-				this->exposure.addListener(this, &Camera::exposureCallback);
-				this->gain.addListener(this, &Camera::gainCallback);
-				this->focus.addListener(this, &Camera::focusCallback);
-				this->sharpness.addListener(this, &Camera::sharpnessCallback);
-
-				this->grabber = make_shared<ofxMachineVision::Grabber::Simple>();
-
-				//this sets up the GUI for selecting a device
-				this->setDevice("");
-			}
-
-			//----------
-			string Camera::getTypeName() const {
-				return "Item::Camera";
-			}
-
-			//----------
-			void Camera::update() {
-				this->grabber->update();
-
-				if (this->showFocusLine) {
-					if (this->grabber->isFrameNew()) {
-						auto frame = this->grabber->getFrame();
-						frame->lockForReading();
-						const auto & pixels = frame->getPixels();
-						auto middleRow = pixels.getPixels() + pixels.getWidth() * pixels.getNumChannels() * pixels.getHeight() / 2;
-
-						this->focusLineGraph.clear();
-						this->focusLineGraph.setMode(OF_PRIMITIVE_LINE_STRIP);
-						for (int i = 0; i<pixels.getWidth(); i++) {
-							this->focusLineGraph.addVertex(ofVec3f(i, *middleRow, 0));
-							middleRow += pixels.getNumChannels();
-						}
-						frame->unlock();
-					}
-				}
-			}
-
-			//----------
-			ofxCvGui::PanelPtr Camera::getView() {
-				return this->placeholderView;
-			}
-
-			//----------
-			void Camera::serialize(Json::Value & json) {
-				auto & jsonDevice = json["device"];
-				Utils::Serializable::serialize(this->deviceTypeName, jsonDevice);
-				Utils::Serializable::serialize(this->deviceIndex, jsonDevice);
-				jsonDevice["width"] = this->getWidth();
-				jsonDevice["height"] = this->getHeight();
-
-				auto & jsonSettings = json["properties"];
-				Utils::Serializable::serialize(this->exposure, jsonSettings);
-				Utils::Serializable::serialize(this->gain, jsonSettings);
-				Utils::Serializable::serialize(this->focus, jsonSettings);
-				Utils::Serializable::serialize(this->sharpness, jsonSettings);
-
-				auto & jsonResolution = json["resolution"];
-			}
-
-			//----------
-			void Camera::deserialize(const Json::Value & json) {
-				auto & jsonDevice = json["device"];
-				this->setDeviceIndex(jsonDevice[this->deviceIndex.getName()].asInt());
-				this->setDevice(jsonDevice[this->deviceTypeName.getName()].asString());
-
-				//take in the saved resolution, this will be overwritten when the device is open and running
-				this->viewInObjectSpace.setWidth(jsonDevice["width"].asFloat());
-				this->viewInObjectSpace.setHeight(jsonDevice["height"].asFloat());
-
-				auto & jsonSettings = json["properties"];
-				Utils::Serializable::deserialize(this->exposure, jsonSettings);
-				Utils::Serializable::deserialize(this->gain, jsonSettings);
-				Utils::Serializable::deserialize(this->focus, jsonSettings);
-				Utils::Serializable::deserialize(this->sharpness, jsonSettings);
-
-				this->setAllGrabberProperties();
-			}
-
-			//----------
-			void Camera::setDeviceIndex(int deviceIndex) {
-				if (this->deviceIndex.get() == deviceIndex) {
-					//do nothing
-					return;
-				}
-
-				this->deviceIndex = deviceIndex;
-				if (this->grabber->getIsDeviceOpen()) {
-					//if we have a device open, let's reopen it
-					this->setDevice(this->grabber->getDevice());
-				}
-			}
-
-			//----------
-			void Camera::setDevice(const string & deviceTypeName) {
-				if (this->deviceTypeName.get() == deviceTypeName) {
-					//do nothing
-					return;
-				}
-
-				this->deviceTypeName = deviceTypeName;
-				auto factory = ofxMachineVision::Device::FactoryRegister::X().get(deviceTypeName);
-				shared_ptr<Device::Base> device;
-				if (factory) {
-					device = factory->makeUntyped();
-				}
-				this->setDevice(device); //setting to null is also valid
-			}
-
-			//----------
-			void Camera::setDevice(DevicePtr device) {
-				this->grabber->setDevice(device);
-
-				if (device) {
-					try
-					{
-						this->grabber->open(this->deviceIndex);
-						if (!this->grabber->getIsDeviceOpen()) {
-							throw(ofxRulr::Exception("Cannot open device of type [" + device->getTypeName() + "] at deviceIndex [" + ofToString(this->deviceIndex) + "]"));
-						}
-						this->grabber->startCapture();
-						if (!this->grabber->getIsDeviceOpen()) {
-							throw(ofxRulr::Exception("Cannot start capture on device of type [" + device->getTypeName() + "] at deviceIndex [" + ofToString(this->deviceIndex) + "]"));
-						}
-
-						this->grabber->getFreshFrame(); // get the first frame to initialise the size of the frame
-						auto width = this->grabber->getWidth();
-						auto height = this->grabber->getHeight();
-						if (width != 0 && height != 0) {
-							this->setWidth(width);
-							this->setHeight(height);
-							this->rebuildViewFromParameters(); // size will have changed
-						}
-
-						this->setAllGrabberProperties();
-
-						auto cameraView = ofxCvGui::Builder::makePanel(*this->grabber);
-						cameraView->onDraw += [this](ofxCvGui::DrawArguments & args) {
-							if (this->showSpecification) {
-								stringstream status;
-								status << "Device ID : " << this->getGrabber()->getDeviceID() << endl;
-								status << endl;
-								status << this->getGrabber()->getDeviceSpecification().toString() << endl;
-
-								ofDrawBitmapStringHighlight(status.str(), 30, 90, ofColor(0x46, 200), ofColor::white);
-							}
-						};
-						cameraView->onDrawCropped += [this](Panels::BaseImage::DrawCroppedArguments & args) {
-							if (this->showFocusLine) {
-								ofPushMatrix();
-								ofPushStyle();
-
-								ofTranslate(0, args.drawSize.y / 2.0f);
-								ofSetColor(100, 255, 100);
-								ofLine(0, 0, args.drawSize.x, 0);
-
-								ofTranslate(0, +128);
-								ofScale(1.0f, -1.0f);
-								ofSetColor(0, 0, 0);
-								ofSetLineWidth(2.0f);
-								this->focusLineGraph.draw();
-								ofSetLineWidth(1.0f);
-								ofSetColor(255, 100, 100);
-								this->focusLineGraph.draw();
-
-								ofPopStyle();
-								ofPopMatrix();
-							}
-
-							//crosshair
-							ofPushStyle();
-							ofSetLineWidth(1);
-							ofSetColor(255);
-							ofPushMatrix();
-							ofTranslate(args.drawSize.x / 2.0f, args.drawSize.y / 2.0f);
-							ofLine(-10, 0, 10, 0);
-							ofLine(0, -10, 0, 10);
-							ofPopMatrix();
-							ofPopStyle();
-						};
-
-						this->placeholderView->clear();
-						this->placeholderView->add(cameraView);
-					}
-					RULR_CATCH_ALL_TO({
-						this->deviceTypeName = "";
-						ofSystemAlertDialog(e.what());
-					});
-				}
-				else {
-					//there is no device, and we want to setup a view to select the device
-					auto cameraSelectorView = make_shared<Panels::Scroll>();
-					cameraSelectorView->add(Widgets::EditableValue<int>::make(this->deviceIndex));
-					cameraSelectorView->add(Widgets::Title::make("Select device type:", Widgets::Title::Level::H3));
-
-					auto & factories = ofxMachineVision::Device::FactoryRegister::X();
-					for (auto factory : factories) {
-						auto makeButton = Widgets::Button::make(factory.first, [this, factory]() {
-							this->setDevice(factory.first);
-						});
-						cameraSelectorView->add(makeButton);
-					}
-
-					this->placeholderView->clear();
-					this->placeholderView->add(cameraSelectorView);
-				}
-			}
-
-			//----------
-			void Camera::clearDevice() {
-				this->setDevice(DevicePtr());
-				this->deviceTypeName.set("uninitialised");
-			}
-
-			//----------
-			void Camera::reopenDevice() {
-				this->setDevice(this->getGrabber()->getDevice());
-			}
-
-			//----------
-			shared_ptr<Grabber::Simple> Camera::getGrabber() {
-				return this->grabber;
-			}
-
-			//----------
-			shared_ptr<ofxMachineVision::Frame> Camera::getFreshFrame() {
-				if (!this->grabber) {
-					return nullptr;
-				}
-				else {
-					return this->grabber->getFreshFrame();
-				}
-			}
-
-			//----------
-			void Camera::populateInspector(ElementGroupPtr inspector) {
-				inspector->add(Widgets::Toggle::make(this->showSpecification));
-				inspector->add(Widgets::Toggle::make(this->showFocusLine));
-
-				inspector->add(Widgets::Title::make("Device", Widgets::Title::H2));
-				inspector->add(Widgets::LiveValue<string>::make("Device Type", [this]() {
-					return this->deviceTypeName;
-				}));
-				auto deviceIndexWidget = Widgets::EditableValue<int>::make("Device Index", [this]() {
-					return this->deviceIndex;
-				}, [this](string & deviceIndexSelection) {
-					this->deviceIndex = ofToInt(deviceIndexSelection);
-					this->reopenDevice();
-				});
-				inspector->add(deviceIndexWidget);
-				inspector->add(Widgets::Button::make("Clear device", [this]() {
-					this->clearDevice();
-				}));
-				inspector->add(Widgets::LiveValueHistory::make("Fps [Hz]", [this]() {
-					return this->grabber->getFps();
-				}, true));
-
-				inspector->add(Widgets::Title::make("Properties", Widgets::Title::H2));
-				auto grabber = this->getGrabber();
-				if (grabber) {
-					if (grabber->getDeviceSpecification().supports(ofxMachineVision::Feature::Feature_Exposure)) {
-						auto exposureSlider = Widgets::Slider::make(this->exposure);
-						exposureSlider->addIntValidator();
-						inspector->add(exposureSlider);
-					}
-					if (grabber->getDeviceSpecification().supports(ofxMachineVision::Feature::Feature_Gain)) {
-						inspector->add(Widgets::Slider::make(this->gain));
-					}
-					if (grabber->getDeviceSpecification().supports(ofxMachineVision::Feature::Feature_Focus)) {
-						inspector->add(Widgets::Slider::make(this->focus));
-					}
-					if (grabber->getDeviceSpecification().supports(ofxMachineVision::Feature::Feature_Sharpness)) {
-						inspector->add(Widgets::Slider::make(this->sharpness));
-					}
-					if (grabber->getDeviceSpecification().supports(ofxMachineVision::Feature::Feature_OneShot)) {
-						inspector->add(MAKE(Widgets::Button, "Take Photo", [this]() {
-							this->getGrabber()->singleShot();
-						}));
-					}
-				}
-			}
-
-			//----------
-			void Camera::setAllGrabberProperties() {
-				auto deviceSpecification = this->grabber->getDeviceSpecification();
-
-				if (deviceSpecification.supports(Feature::Feature_Exposure)) {
-					this->grabber->setExposure(this->exposure);
-				}
-				if (deviceSpecification.supports(Feature::Feature_Gain)) {
-					this->grabber->setGain(this->gain);
-				}
-				if (deviceSpecification.supports(Feature::Feature_Focus)) {
-					this->grabber->setFocus(this->focus);
-				}
-				if (deviceSpecification.supports(Feature::Feature_Sharpness)) {
-					this->grabber->setSharpness(this->sharpness);
-				}
-			}
-
-			//----------
-			void Camera::exposureCallback(float & value) {
-				this->grabber->setExposure(value);
-			}
-
-			//----------
-			void Camera::gainCallback(float & value) {
-				this->grabber->setGain(value);
-			}
-
-			//----------
-			void Camera::focusCallback(float & value) {
-				this->grabber->setFocus(value);
-			}
-
-			//----------
-			void Camera::sharpnessCallback(float & value) {
-				this->grabber->setSharpness(value);
-			}
-		}
-	}
+#include "Camera.h"
+#include "ofxCvGui.h"
+
+using namespace ofxCvGui;
+using namespace ofxMachineVision;
+using namespace cv;
+
+namespace ofxRulr {
+	namespace Nodes {
+		namespace Item {
+#pragma mark DerivedFrame
+			//----------
+			Camera::DerivedFrame::DerivedFrame(Utils::FrameRing::FramePtr frame) :
+			frame(frame),
+			focusMetric(0.0f),
+			focusMetricValid(false) {
+			}
+
+			//----------
+			Utils::FrameRing::FramePtr Camera::DerivedFrame::getFrame() const {
+				return this->frame;
+			}
+
+			//----------
+			cv::Mat Camera::DerivedFrame::getGrayscale() {
+				lock_guard<mutex> lock(this->imagesLock);
+				return this->getGrayscaleUnlocked();
+			}
+
+			//----------
+			cv::Mat Camera::DerivedFrame::getPyramidLevel(int level) {
+				lock_guard<mutex> lock(this->imagesLock);
+				return this->getPyramidLevelUnlocked(level);
+			}
+
+			//----------
+			cv::Mat Camera::DerivedFrame::getUndistorted(shared_ptr<const Utils::Undistortion> undistortion) {
+				lock_guard<mutex> lock(this->imagesLock);
+
+				//a View makes new tables whenever its intrinsics change, so the pointer identifies the intrinsics
+				if (this->undistorted.empty() || this->undistortedWith != undistortion) {
+					//assign a new image rather than writing into the old one, in case somebody still holds it
+					cv::Mat undistorted;
+					undistortion->undistortImage(this->frame->getMat(), undistorted);
+					this->undistorted = undistorted;
+					this->undistortedWith = undistortion;
+				}
+				return this->undistorted;
+			}
+
+			//----------
+			float Camera::DerivedFrame::getFocusMetric() {
+				lock_guard<mutex> lock(this->imagesLock);
+				if (!this->focusMetricValid) {
+					auto image = this->getPyramidLevelUnlocked(RULR_CAMERA_FOCUS_METRIC_LEVEL);
+					if (!image.empty()) {
+						cv::Mat laplacian;
+						cv::Laplacian(image, laplacian, CV_32F);
+						cv::Scalar mean, standardDeviation;
+						cv::meanStdDev(laplacian, mean, standardDeviation);
+						this->focusMetric = (float) (standardDeviation[0] * standardDeviation[0]);
+					}
+					this->focusMetricValid = true;
+				}
+				return this->focusMetric;
+			}
+
+			//----------
+			cv::Mat Camera::DerivedFrame::getGrayscaleUnlocked() {
+				if (this->grayscale.empty()) {
+					auto image = this->frame->getMat();
+					switch (image.channels()) {
+					case 3:
+						cv::cvtColor(image, this->grayscale, CV_RGB2GRAY);
+						break;
+					case 4:
+						cv::cvtColor(image, this->grayscale, CV_RGBA2GRAY);
+						break;
+					default:
+						//the frame is already read only, so share it
+						this->grayscale = image;
+						break;
+					}
+				}
+				return this->grayscale;
+			}
+
+			//----------
+			cv::Mat Camera::DerivedFrame::getPyramidLevelUnlocked(int level) {
+				if (this->pyramid.empty()) {
+					this->pyramid.push_back(this->getGrayscaleUnlocked());
+				}
+				while ((int) this->pyramid.size() <= level) {
+					const auto & previous = this->pyramid.back();
+					if (previous.cols < 2 || previous.rows < 2) {
+						break;
+					}
+					cv::Mat next;
+					cv::pyrDown(previous, next);
+					this->pyramid.push_back(next);
+				}
+				return this->pyramid[min(level, (int) this->pyramid.size() - 1)];
+			}
+
+#pragma mark Camera
+			//----------
+			Camera::Camera() :
+			View(true),
+			frameRing(RULR_CAMERA_FRAME_RING_SIZE),
+			lastDeviceFrameIndex(-1),
+			focusMetric(0.0f) {
+				RULR_NODE_INIT_LISTENER;
+			}
+
+			//----------
+			void Camera::init() {
+				RULR_NODE_UPDATE_LISTENER;
+				RULR_NODE_SERIALIZATION_LISTENERS;
+				RULR_NODE_INSPECTOR_LISTENER;
+
+				this->placeholderView = make_shared<Panels::Groups::Grid>();
+
+				this->deviceIndex.set("Device index", 0);
+				this->deviceTypeName.set("Device type name", "uninitialised"); // this should be different from the setDevice("") call below
+
+				this->showSpecification.set("Show specification", false);
+				this->showFocusLine.set("Show focus line", true);
+				this->exposure.set("Exposure [us]", 500.0f, 0.0f, 1000000.0f);
+				this->gain.set("Gain", 0.5f, 0.0f, 1.0f);
+				this->focus.set("Focus ", 0.5f, 0.0f, 1.0f);
+				this->sharpness.set("Sharpness", 0.5f, 0.0f, 1.0f);
+
+				this->exposure.addListener(this, &Camera::exposureCallback);
+				this->gain.addListener(this, &Camera::gainCallback);
+				this->focus.addListener(this, &Camera::focusCallback);
+				this->sharpness.addListener(this, &Camera::sharpnessCallback);
+
+				this->grabber = make_shared<ofxMachineVision::Grabber::Simple>();
+
+				//this sets up the GUI for selecting a device
+				this->setDevice("");
+			}
+
+			//----------
+			string Camera::getTypeName() const {
+				return "Item::Camera";
+			}
+
+			//----------
+			void Camera::update() {
+				this->grabber->update();
+
+				if (this->grabber->isFrameNew()) {
+					auto frame = this->receiveFrame(this->grabber->getFrame());
+
+					if (this->showFocusLine && frame) {
+						auto derivedFrame = this->getDerivedFrame(frame);
+						auto grayscale = derivedFrame->getGrayscale();
+						auto middleRow = grayscale.ptr<uchar>(grayscale.rows / 2);
+
+						this->focusLineGraph.clear();
+						this->focusLineGraph.setMode(OF_PRIMITIVE_LINE_STRIP);
+						for (int i = 0; i<grayscale.cols; i++) {
+							this->focusLineGraph.addVertex(ofVec3f(i, middleRow[i], 0));
+						}
+						this->focusMetric = derivedFrame->getFocusMetric();
+					}
+				}
+			}
+
+			//----------
+			ofxCvGui::PanelPtr Camera::getView() {
+				return this->placeholderView;
+			}
+
+			//----------
+			void Camera::serialize(Json::Value & json) {
+				auto & jsonDevice = json["device"];
+				Utils::Serializable::serialize(this->deviceTypeName, jsonDevice);
+				Utils::Serializable::serialize(this->deviceIndex, jsonDevice);
+				jsonDevice["width"] = this->getWidth();
+				jsonDevice["height"] = this->getHeight();
+
+				auto & jsonSettings = json["properties"];
+				Utils::Serializable::serialize(this->exposure, jsonSettings);
+				Utils::Serializable::serialize(this->gain, jsonSettings);
+				Utils::Serializable::serialize(this->focus, jsonSettings);
+				Utils::Serializable::serialize(this->sharpness, jsonSettings);
+
+				auto & jsonResolution = json["resolution"];
+			}
+
+			//----------
+			void Camera::deserialize(const Json::Value & json) {
+				auto & jsonDevice = json["device"];
+				this->setDeviceIndex(jsonDevice[this->deviceIndex.getName()].asInt());
+				this->setDevice(jsonDevice[this->deviceTypeName.getName()].asString());
+
+				//take in the saved resolution, this will be overwritten when the device is open and running
+				this->viewInObjectSpace.setWidth(jsonDevice["width"].asFloat());
+				this->viewInObjectSpace.setHeight(jsonDevice["height"].asFloat());
+
+				auto & jsonSettings = json["properties"];
+				Utils::Serializable::deserialize(this->exposure, jsonSettings);
+				Utils::Serializable::deserialize(this->gain, jsonSettings);
+				Utils::Serializable::deserialize(this->focus, jsonSettings);
+				Utils::Serializable::deserialize(this->sharpness, jsonSettings);
+
+				this->setAllGrabberProperties();
+			}
+
+			//----------
+			void Camera::setDeviceIndex(int deviceIndex) {
+				if (this->deviceIndex.get() == deviceIndex) {
+					//do nothing
+					return;
+				}
+
+				this->deviceIndex = deviceIndex;
+				if (this->grabber->getIsDeviceOpen()) {
+					//if we have a device open, let's reopen it
+					this->setDevice(this->grabber->getDevice());
+				}
+			}
+
+			//----------
+			void Camera::setDevice(const string & deviceTypeName) {
+				if (this->deviceTypeName.get() == deviceTypeName) {
+					//do nothing
+					return;
+				}
+
+				this->deviceTypeName = deviceTypeName;
+				auto factory = ofxMachineVision::Device::FactoryRegister::X().get(deviceTypeName);
+				shared_ptr<Device::Base> device;
+				if (factory) {
+					device = factory->makeUntyped();
+				}
+				this->setDevice(device); //setting to null is also valid
+			}
+
+			//----------
+			void Camera::setDevice(DevicePtr device) {
+				this->grabber->setDevice(device);
+				this->frameRing.clear();
+				this->lastDeviceFrameIndex = -1;
+				{
+					lock_guard<mutex> lock(this->derivedFramesLock);
+					this->derivedFrames.clear();
+				}
+
+				if (device) {
+					try
+					{
+						this->grabber->open(this->deviceIndex);
+						if (!this->grabber->getIsDeviceOpen()) {
+							throw(ofxRulr::Exception("Cannot open device of type [" + device->getTypeName() + "] at deviceIndex [" + ofToString(this->deviceIndex) + "]"));
+						}
+						this->grabber->startCapture();
+						if (!this->grabber->getIsDeviceOpen()) {
+							throw(ofxRulr::Exception("Cannot start capture on device of type [" + device->getTypeName() + "] at deviceIndex [" + ofToString(this->deviceIndex) + "]"));
+						}
+
+						this->getFreshFrame(); // get the first frame to initialise the size of the frame
+						auto width = this->grabber->getWidth();
+						auto height = this->grabber->getHeight();
+						if (width != 0 && height != 0) {
+							this->beginUpdate();
+							this->setWidth(width);
+							this->setHeight(height);
+							this->commitUpdate();
+						}
+
+						this->setAllGrabberProperties();
+
+						auto cameraView = ofxCvGui::Builder::makePanel(*this->grabber);
+						cameraView->onDraw += [this](ofxCvGui::DrawArguments & args) {
+							if (this->showSpecification) {
+								stringstream status;
+								status << "Device ID : " << this->getGrabber()->getDeviceID() << endl;
+								status << endl;
+								status << this->getGrabber()->getDeviceSpecification().toString() << endl;
+
+								ofDrawBitmapStringHighlight(status.str(), 30, 90, ofColor(0x46, 200), ofColor::white);
+							}
+						};
+						cameraView->onDrawCropped += [this](Panels::BaseImage::DrawCroppedArguments & args) {
+							if (this->showFocusLine) {
+								ofPushMatrix();
+								ofPushStyle();
+
+								ofTranslate(0, args.drawSize.y / 2.0f);
+								ofSetColor(100, 255, 100);
+								ofLine(0, 0, args.drawSize.x, 0);
+
+								ofTranslate(0, +128);
+								ofScale(1.0f, -1.0f);
+								ofSetColor(0, 0, 0);
+								ofSetLineWidth(2.0f);
+								this->focusLineGraph.draw();
+								ofSetLineWidth(1.0f);
+								ofSetColor(255, 100, 100);
+								this->focusLineGraph.draw();
+
+								ofPopStyle();
+								ofPopMatrix();
+							}
+
+							//crosshair
+							ofPushStyle();
+							ofSetLineWidth(1);
+							ofSetColor(255);
+							ofPushMatrix();
+							ofTranslate(args.drawSize.x / 2.0f, args.drawSize.y / 2.0f);
+							ofLine(-10, 0, 10, 0);
+							ofLine(0, -10, 0, 10);
+							ofPopMatrix();
+							ofPopStyle();
+						};
+
+						this->placeholderView->clear();
+						this->placeholderView->add(cameraView);
+					}
+					RULR_CATCH_ALL_TO({
+						this->deviceTypeName = "";
+						ofSystemAlertDialog(e.what());
+					});
+				}
+				else {
+					//there is no device, and we want to setup a view to select the device
+					auto cameraSelectorView = make_shared<Panels::Scroll>();
+					cameraSelectorView->add(Widgets::EditableValue<int>::make(this->deviceIndex));
+					cameraSelectorView->add(Widgets::Title::make("Select device type:", Widgets::Title::Level::H3));
+
+					auto & factories = ofxMachineVision::Device::FactoryRegister::X();
+					for (auto factory : factories) {
+						auto makeButton = Widgets::Button::make(factory.first, [this, factory]() {
+							this->setDevice(factory.first);
+						});
+						cameraSelectorView->add(makeButton);
+					}
+
+					this->placeholderView->clear();
+					this->placeholderView->add(cameraSelectorView);
+				}
+			}
+
+			//----------
+			void Camera::clearDevice() {
+				this->setDevice(DevicePtr());
+				this->deviceTypeName.set("uninitialised");
+			}
+
+			//----------
+			void Camera::reopenDevice() {
+				this->setDevice(this->getGrabber()->getDevice());
+			}
+
+			//----------
+			shared_ptr<Grabber::Simple> Camera::getGrabber() {
+				return this->grabber;
+			}
+
+			//----------
+			Utils::FrameRing::FramePtr Camera::getFreshFrame() {
+				if (!this->grabber) {
+					return nullptr;
+				}
+				else {
+					return this->receiveFrame(this->grabber->getFreshFrame());
+				}
+			}
+
+			//----------
+			Utils::FrameRing::FramePtr Camera::getFrame() const {
+				return this->frameRing.getLatestFrame();
+			}
+
+			//----------
+			const Utils::FrameRing & Camera::getFrameRing() const {
+				return this->frameRing;
+			}
+
+			//----------
+			shared_ptr<Camera::DerivedFrame> Camera::getDerivedFrame(Utils::FrameRing::FramePtr frame) {
+				if (!frame) {
+					frame = this->getFrame();
+					if (!frame) {
+						return nullptr;
+					}
+				}
+
+				lock_guard<mutex> lock(this->derivedFramesLock);
+				auto findFrame = this->derivedFrames.find(frame->getFrameIndex());
+				if (findFrame != this->derivedFrames.end()) {
+					return findFrame->second;
+				}
+
+				auto derivedFrame = make_shared<DerivedFrame>(frame);
+				this->derivedFrames.emplace(frame->getFrameIndex(), derivedFrame);
+
+				//only keep as many as the ring does (anybody still using an older one keeps it alive)
+				while (this->derivedFrames.size() > this->frameRing.getSize()) {
+					this->derivedFrames.erase(this->derivedFrames.begin());
+				}
+				return derivedFrame;
+			}
+
+			//----------
+			Utils::FrameRing::FramePtr Camera::receiveFrame(shared_ptr<ofxMachineVision::Frame> deviceFrame) {
+				if (!deviceFrame) {
+					return nullptr;
+				}
+
+				//the grabber hands out one frame which the device thread writes into, so this is the only copy we make
+				deviceFrame->lockForReading();
+				Utils::FrameRing::FramePtr frame;
+				if (deviceFrame->getFrameIndex() == this->lastDeviceFrameIndex) {
+					//already received (e.g. by getFreshFrame() before update())
+					frame = this->frameRing.getLatestFrame();
+				}
+				else if (deviceFrame->getPixels().isAllocated()) {
+					frame = this->frameRing.push(deviceFrame->getPixels());
+					this->lastDeviceFrameIndex = deviceFrame->getFrameIndex();
+				}
+				deviceFrame->unlock();
+
+				return frame;
+			}
+
+			//----------
+			void Camera::populateInspector(ElementGroupPtr inspector) {
+				inspector->add(Widgets::Toggle::make(this->showSpecification));
+				inspector->add(Widgets::Toggle::make(this->showFocusLine));
+				inspector->add(Widgets::LiveValueHistory::make("Focus metric", [this]() {
+					return this->focusMetric;
+				}, true));
+
+				inspector->add(Widgets::Title::make("Device", Widgets::Title::H2));
+				inspector->add(Widgets::LiveValue<string>::make("Device Type", [this]() {
+					return this->deviceTypeName;
+				}));
+				auto deviceIndexWidget = Widgets::EditableValue<int>::make("Device Index", [this]() {
+					return this->deviceIndex;
+				}, [this](string & deviceIndexSelection) {
+					this->deviceIndex = ofToInt(deviceIndexSelection);
+					this->reopenDevice();
+				});
+				inspector->add(deviceIndexWidget);
+				inspector->add(Widgets::Button::make("Clear device", [this]() {
+					this->clearDevice();
+				}));
+				inspector->add(Widgets::LiveValueHistory::make("Fps [Hz]", [this]() {
+					return this->grabber->getFps();
+				}, true));
+
+				inspector->add(Widgets::Title::make("Properties", Widgets::Title::H2));
+				auto grabber = this->getGrabber();
+				if (grabber) {
+					if (grabber->getDeviceSpecification().supports(ofxMachineVision::Feature::Feature_Exposure)) {
+						auto exposureSlider = Widgets::Slider::make(this->exposure);
+						exposureSlider->addIntValidator();
+						inspector->add(exposureSlider);
+					}
+					if (grabber->getDeviceSpecification().supports(ofxMachineVision::Feature::Feature_Gain)) {
+						inspector->add(Widgets::Slider::make(this->gain));
+					}
+					if (grabber->getDeviceSpecification().supports(ofxMachineVision::Feature::Feature_Focus)) {
+						inspector->add(Widgets::Slider::make(this->focus));
+					}
+					if (grabber->getDeviceSpecification().supports(ofxMachineVision::Feature::Feature_Sharpness)) {
+						inspector->add(Widgets::Slider::make(this->sharpness));
+					}
+					if (grabber->getDeviceSpecification().supports(ofxMachineVision::Feature::Feature_OneShot)) {
+						inspector->add(MAKE(Widgets::Button, "Take Photo", [this]() {
+							this->getGrabber()->singleShot();
+						}));
+					}
+				}
+			}
+
+			//----------
+			void Camera::setAllGrabberProperties() {
+				auto deviceSpecification = this->grabber->getDeviceSpecification();
+
+				if (deviceSpecification.supports(Feature::Feature_Exposure)) {
+					this->grabber->setExposure(this->exposure);
+				}
+				if (deviceSpecification.supports(Feature::Feature_Gain)) {
+					this->grabber->setGain(this->gain);
+				}
+				if (deviceSpecification.supports(Feature::Feature_Focus)) {
+					this->grabber->setFocus(this->focus);
+				}
+				if (deviceSpecification.supports(Feature::Feature_Sharpness)) {
+					this->grabber->setSharpness(this->sharpness);
+				}
+			}
+
+			//----------
+			void Camera::exposureCallback(float & value) {
+				this->grabber->setExposure(value);
+			}
+
+			//----------
+			void Camera::gainCallback(float & value) {
+				this->grabber->setGain(value);
+			}
+
+			//----------
+			void Camera::focusCallback(float & value) {
+				this->grabber->setFocus(value);
+			}
+
+			//----------
+			void Camera::sharpnessCallback(float & value) {
+				this->grabber->setSharpness(value);
+			}
+		}
+	}
 }
\ No newline at end of file
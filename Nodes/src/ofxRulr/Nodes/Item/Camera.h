@@ -1,63 +1,109 @@
-#pragma once
-
-#include "View.h"
-#include "ofxMachineVision.h"
-#include "ofxCvGui/Panels/Groups/Grid.h"
-
-#include "ofxCvMin.h"
-#include "ofxRay.h"
-
-#define RULR_CAMERA_DISTORTION_COEFFICIENT_COUNT 4
-
-namespace ofxRulr {
-	namespace Nodes {
-		namespace Item {
-			class Camera : public View {
-			public:
-				Camera();
-
-				void init();
-				string getTypeName() const override;
-				void update();
-				ofxCvGui::PanelPtr getView() override;
-
-				void serialize(Json::Value &);
-				void deserialize(const Json::Value &);
-
-				void setDeviceIndex(int);
-				void setDevice(const string & deviceTypeName);
-				void setDevice(ofxMachineVision::DevicePtr);
-				void clearDevice();
-				void reopenDevice();
-				shared_ptr<ofxMachineVision::Grabber::Simple> getGrabber();
-
-				shared_ptr<ofxMachineVision::Frame> getFreshFrame();
-			protected:
-				void populateInspector(ofxCvGui::ElementGroupPtr);
-				void setAllGrabberProperties();
-
-				void exposureCallback(float &);
-				void gainCallback(float &);
-				void focusCallback(float &);
-				void sharpnessCallback(float &);
-
-				shared_ptr<ofxCvGui::Panels::Groups::Grid> placeholderView;
-
-				shared_ptr<ofxMachineVision::Grabber::Simple> grabber;
-
-				ofParameter<int> deviceIndex;
-				ofParameter<string> deviceTypeName;
-
-				ofParameter<bool> showSpecification;
-				ofParameter<bool> showFocusLine;
-
-				ofParameter<float> exposure;
-				ofParameter<float> gain;
-				ofParameter<float> focus;
-				ofParameter<float> sharpness;
-
-				ofMesh focusLineGraph;
-			};
-		}
-	}
+#pragma once
+
+#include "View.h"
+#include "ofxMachineVision.h"
+#include "ofxCvGui/Panels/Groups/Grid.h"
+#include "ofxRulr/Utils/FrameRing.h"
+
+#include "ofxCvMin.h"
+#include "ofxRay.h"
+
+#define RULR_CAMERA_DISTORTION_COEFFICIENT_COUNT 4
+#define RULR_CAMERA_FRAME_RING_SIZE 4
+#define RULR_CAMERA_FOCUS_METRIC_LEVEL 1
+
+namespace ofxRulr {
+	namespace Nodes {
+		namespace Item {
+			class Camera : public View {
+			public:
+				/**
+				Images derived from one frame, each computed the first time it is asked for and then shared by every consumer of that frame.
+				Safe to use from any thread. The returned images are read only.
+				**/
+				class DerivedFrame {
+				public:
+					DerivedFrame(Utils::FrameRing::FramePtr);
+
+					Utils::FrameRing::FramePtr getFrame() const;
+
+					cv::Mat getGrayscale();
+					cv::Mat getPyramidLevel(int level); // level 0 is the grayscale image, each level is half the size of the one before
+					cv::Mat getUndistorted(shared_ptr<const Utils::Undistortion>); // e.g. from Camera::getUndistortion(). Recomputed if the tables differ from the last call
+					float getFocusMetric(); // variance of the Laplacian of pyramid level RULR_CAMERA_FOCUS_METRIC_LEVEL, higher is sharper
+				protected:
+					cv::Mat getGrayscaleUnlocked();
+					cv::Mat getPyramidLevelUnlocked(int level);
+
+					Utils::FrameRing::FramePtr frame;
+					mutex imagesLock;
+
+					cv::Mat grayscale;
+					vector<cv::Mat> pyramid;
+					cv::Mat undistorted;
+					shared_ptr<const Utils::Undistortion> undistortedWith;
+					float focusMetric;
+					bool focusMetricValid;
+				};
+
+				Camera();
+
+				void init();
+				string getTypeName() const override;
+				void update();
+				ofxCvGui::PanelPtr getView() override;
+
+				void serialize(Json::Value &);
+				void deserialize(const Json::Value &);
+
+				void setDeviceIndex(int);
+				void setDevice(const string & deviceTypeName);
+				void setDevice(ofxMachineVision::DevicePtr);
+				void clearDevice();
+				void reopenDevice();
+				shared_ptr<ofxMachineVision::Grabber::Simple> getGrabber();
+
+				///Waits for the device to deliver a new frame, and returns it from the frame ring
+				Utils::FrameRing::FramePtr getFreshFrame();
+
+				///The latest frame received in update() or getFreshFrame(). Frames are read only and can be held (on any thread) without copying.
+				Utils::FrameRing::FramePtr getFrame() const;
+				const Utils::FrameRing & getFrameRing() const;
+
+				///Derived images for this frame (or the latest frame), shared with every other caller asking for the same frame
+				shared_ptr<DerivedFrame> getDerivedFrame(Utils::FrameRing::FramePtr frame = nullptr);
+			protected:
+				Utils::FrameRing::FramePtr receiveFrame(shared_ptr<ofxMachineVision::Frame>);
+				void populateInspector(ofxCvGui::ElementGroupPtr);
+				void setAllGrabberProperties();
+
+				void exposureCallback(float &);
+				void gainCallback(float &);
+				void focusCallback(float &);
+				void sharpnessCallback(float &);
+
+				shared_ptr<ofxCvGui::Panels::Groups::Grid> placeholderView;
+
+				shared_ptr<ofxMachineVision::Grabber::Simple> grabber;
+				Utils::FrameRing frameRing;
+				long lastDeviceFrameIndex;
+				map<uint64_t, shared_ptr<DerivedFrame>> derivedFrames;
+				mutex derivedFramesLock;
+
+				ofParameter<int> deviceIndex;
+				ofParameter<string> deviceTypeName;
+
+				ofParameter<bool> showSpecification;
+				ofParameter<bool> showFocusLine;
+
+				ofParameter<float> exposure;
+				ofParameter<float> gain;
+				ofParameter<float> focus;
+				ofParameter<float> sharpness;
+
+				ofMesh focusLineGraph;
+				float focusMetric;
+			};
+		}
+	}
 }
\ No newline at end of file
@@ -98,6 +98,22 @@ namespace ofxRulr {
 				ofPopMatrix();
 			}
 
+			//----------
+			Utils::Bounds Model::getWorldBounds() const {
+				if (this->modelLoader->getMeshCount() == 0) {
+					return Utils::Bounds();
+				}
+
+				//the same transform as drawWorld, with the loader's own transform applied first
+				const auto scale = this->inputUnitScale.get();
+				const auto transform = this->modelLoader->getModelMatrix() * ofMatrix4x4::newScaleMatrix(
+					this->flipX ? -scale : scale,
+					this->flipY ? -scale : scale,
+					this->flipZ ? -scale : scale);
+				Utils::Bounds sceneBounds(this->modelLoader->getSceneMin(), this->modelLoader->getSceneMax());
+				return sceneBounds.getTransformed(transform);
+			}
+
 			//----------
 			void Model::serialize(Json::Value & json) {
 				Utils::Serializable::serialize(this->filename, json);
@@ -1,46 +1,75 @@
-#pragma once
-
-#include "ofxRulr/Nodes/Base.h"
-#include "ofxCvMin/src/ofxCvMin.h"
-
-namespace ofxRulr {
-	namespace Nodes {
-		namespace Item {
-			class RigidBody : public virtual Nodes::Base {
-			public:
-				RigidBody();
-				virtual string getTypeName() const override;
-				void init();
-				void drawWorld() override;
-				virtual void drawObject() { }
-
-				void serialize(Json::Value &);
-				void deserialize(const Json::Value &);
-				void populateInspector(ofxCvGui::ElementGroupPtr);
-
-				ofMatrix4x4 getTransform() const;
-				ofVec3f getPosition() const;
-				ofQuaternion getRotationQuat() const;
-				ofVec3f getRotationEuler() const;
-
-				void setTransform(const ofMatrix4x4 &);
-				void setPosition(const ofVec3f &);
-				void setRotationEuler(const ofVec3f &);
-				void setExtrinsics(cv::Mat rotation, cv::Mat translation, bool inverse = false);
-				void clearTransform();
-
-				ofxLiquidEvent<void> onTransformChange;
-			protected:
-				void exportRigidBodyMatrix();
-
-				ofParameter<float> translation[3];
-				ofParameter<float> rotationEuler[3];
-
-			private:
-			};
-
-			ofVec3f toEuler(const ofQuaternion &);
-			ofQuaternion toQuaternion(const ofVec3f & degrees);
-		}
-	}
+#pragma once
+
+#include "ofxRulr/Nodes/Base.h"
+#include "ofxCvMin/src/ofxCvMin.h"
+
+#include <mutex>
+
+namespace ofxRulr {
+	namespace Nodes {
+		namespace Item {
+			class RigidBody : public virtual Nodes::Base {
+			public:
+				RigidBody();
+				virtual string getTypeName() const override;
+				void init();
+				void drawWorld() override;
+				virtual void drawObject() { }
+				Utils::Bounds getWorldBounds() const override;
+				///Extent of what drawObject draws, in object space. Default covers the axes drawn by drawWorld
+				virtual Utils::Bounds getObjectBounds() const;
+
+				void serialize(Json::Value &);
+				void deserialize(const Json::Value &);
+				void populateInspector(ofxCvGui::ElementGroupPtr);
+
+				///Object to world space (i.e. including the parent's transform if a parent is connected). Cached until something changes.
+				///Safe to call from other threads.
+				ofMatrix4x4 getTransform() const;
+				///World to object space. Cached alongside getTransform.
+				ofMatrix4x4 getTransformInverse() const;
+				///Object to parent space (the translation and rotation parameters)
+				ofMatrix4x4 getLocalTransform() const;
+				ofVec3f getPosition() const; // parent space
+				ofQuaternion getRotationQuat() const; // parent space
+				ofVec3f getRotationEuler() const; // parent space
+				ofVec3f getWorldPosition() const;
+				ofQuaternion getWorldRotationQuat() const;
+
+				void setTransform(const ofMatrix4x4 &); // world space
+				void setPosition(const ofVec3f &); // parent space
+				void setRotationEuler(const ofVec3f &); // parent space
+				void setExtrinsics(cv::Mat rotation, cv::Mat translation, bool inverse = false);
+				void clearTransform();
+
+				shared_ptr<RigidBody> getParent() const;
+
+				///Fires whenever the transform (or a parent's transform) changes. setTransform and friends fire it once, after all parameters are set.
+				ofxLiquidEvent<void> onTransformChange;
+			protected:
+				void exportRigidBodyMatrix();
+				void markTransformDirty();
+				void callbackTransformParameterChange(float &);
+
+				ofParameter<float> translation[3];
+				ofParameter<float> rotationEuler[3];
+
+				weak_ptr<RigidBody> parent;
+				bool updatingParameters; // whilst we set several parameters at once, we notify only at the end
+				bool notifyingTransformChange; // guards against cycles of parents
+
+				//the cache. recursive since a cycle of parents comes back to us whilst we rebuild
+				mutable recursive_mutex transformLock;
+				mutable ofMatrix4x4 transform;
+				mutable ofMatrix4x4 transformInverse;
+				mutable bool transformDirty;
+				mutable bool rebuildingTransform; // guards against cycles of parents
+
+			private:
+			};
+
+			ofVec3f toEuler(const ofQuaternion &);
+			ofQuaternion toQuaternion(const ofVec3f & degrees);
+		}
+	}
 }
\ No newline at end of file
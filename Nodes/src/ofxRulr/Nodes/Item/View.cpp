@@ -1,319 +1,563 @@
-#include "View.h"
-
-#include "ofxCvGui/Widgets/Button.h"
-#include "ofxCvGui/Widgets/Spacer.h"
-#include "ofxCvGui/Widgets/Slider.h"
-#include "ofxCvGui/Widgets/Title.h"
-#include "ofxCvGui/Widgets/LiveValue.h"
-#include "ofxCvGui/Widgets/EditableValue.h"
-
-using namespace ofxCvGui;
-using namespace cv;
-
-namespace ofxRulr {
-	namespace Nodes {
-		namespace Item {
-			//---------
-			View::View(bool hasDistortion) : hasDistortion(hasDistortion) {
-				RULR_NODE_INIT_LISTENER;
-				this->testCamera = nullptr;
-			}
-
-			//---------
-			string View::getTypeName() const {
-				return "Item::View";
-			}
-
-			//---------
-			void View::init() {
-				RULR_NODE_UPDATE_LISTENER;
-				RULR_NODE_SERIALIZATION_LISTENERS;
-				RULR_NODE_INSPECTOR_LISTENER;
-
-				this->onTransformChange += [this]() {
-					this->rebuildViewFromParameters();
-				};
-
-				this->focalLengthX.set("Focal Length X", 1024.0f, 1.0f, 50000.0f);
-				this->focalLengthY.set("Focal Length Y", 1024.0f, 1.0f, 50000.0f);
-				this->principalPointX.set("Center Of Projection X", 512.0f, -10000.0f, 10000.0f);
-				this->principalPointY.set("Center Of Projection Y", 512.0f, -10000.0f, 10000.0f);
-				for (int i = 0; i<RULR_VIEW_DISTORTION_COEFFICIENT_COUNT; i++) {
-					this->distortion[i].set("Distortion K" + ofToString(i + 1), 0.0f, -1000.0f, 1000.0f);
-				}
-
-				this->focalLengthX.addListener(this, &View::parameterCallback);
-				this->focalLengthY.addListener(this, &View::parameterCallback);
-				this->principalPointX.addListener(this, &View::parameterCallback);
-				this->principalPointX.addListener(this, &View::parameterCallback);
-				for (int i = 0; i<RULR_VIEW_DISTORTION_COEFFICIENT_COUNT; i++) {
-					this->distortion[i].addListener(this, &View::parameterCallback);
-				}
-
-				this->viewInObjectSpace.setDefaultFar(20.0f);
-				this->viewInObjectSpace.color = this->getColor();
-
-				this->rebuildViewFromParameters();
-			}
-
-			//---------
-			void View::update() {
-
-			}
-
-			//----------
-			void View::drawObject() {
-				this->viewInObjectSpace.draw();
-
-				if (this->testCamera) {
-					this->testCamera->draw();
-				}
-			}
-
-			//---------
-			void View::serialize(Json::Value & json) {
-				auto & jsonCalibration = json["calibration"];
-				Utils::Serializable::serialize(this->focalLengthX, jsonCalibration);
-				Utils::Serializable::serialize(this->focalLengthY, jsonCalibration);
-				Utils::Serializable::serialize(this->principalPointX, jsonCalibration);
-				Utils::Serializable::serialize(this->principalPointY, jsonCalibration);
-
-				auto & jsonResolution = json["resolution"];
-				jsonResolution["width"] = this->viewInObjectSpace.getWidth();
-				jsonResolution["height"] = this->viewInObjectSpace.getWidth();
-
-				auto & jsonDistortion = jsonCalibration["distortion"];
-				for (int i = 0; i<RULR_VIEW_DISTORTION_COEFFICIENT_COUNT; i++) {
-					Utils::Serializable::serialize(this->distortion[i], jsonDistortion);
-				}
-			}
-
-			//---------
-			void View::deserialize(const Json::Value & json) {
-				const auto & jsonCalibration = json["calibration"];
-				Utils::Serializable::deserialize(this->focalLengthX, jsonCalibration);
-				Utils::Serializable::deserialize(this->focalLengthY, jsonCalibration);
-				Utils::Serializable::deserialize(this->principalPointX, jsonCalibration);
-				Utils::Serializable::deserialize(this->principalPointY, jsonCalibration);
-
-				const auto & jsonResolution = json["resolution"];
-				if (!jsonResolution.isNull()) {
-					this->setWidth(jsonResolution["width"].asFloat());
-					this->setWidth(jsonResolution["height"].asFloat());
-				}
-				else {
-					this->setWidth(1024);
-					this->setHeight(768);
-				}
-
-				auto & jsonDistortion = jsonCalibration["distortion"];
-				for (int i = 0; i<RULR_VIEW_DISTORTION_COEFFICIENT_COUNT; i++) {
-					Utils::Serializable::deserialize(this->distortion[i], jsonDistortion);
-				}
-			}
-
-			//---------
-			void View::populateInspector(ofxCvGui::ElementGroupPtr inspector) {
-				inspector->add(Widgets::Title::make("View", Widgets::Title::Level::H2));
-				inspector->add(make_shared<Widgets::LiveValue<string>>("Resolution", [this](){
-					string msg;
-					msg = ofToString((int)this->getWidth()) + ", " + ofToString((int)this->getHeight());
-					return msg;
-				}));
-
-				inspector->add(Widgets::Title::make("Camera matrix", Widgets::Title::Level::H3));
-				auto addCameraMatrixParameter = [this, inspector](ofParameter<float> & parameter) {
-					auto slider = Widgets::Slider::make(parameter);
-					slider->onValueChange += [this](ofParameter<float> &) {
-						this->rebuildViewFromParameters();
-					};
-					inspector->add(slider);
-				};
-
-				addCameraMatrixParameter(this->focalLengthX);
-				addCameraMatrixParameter(this->focalLengthY);
-				addCameraMatrixParameter(this->principalPointX);
-				addCameraMatrixParameter(this->principalPointY);
-
-				inspector->add(Widgets::EditableValue<float>::make("Throw ratio X", [this]() {
-					return this->viewInObjectSpace.getThrowRatio();
-				}, [this](string newValueString) {
-					auto newThrowRatio = ofToFloat(newValueString);
-					if (newThrowRatio > 0.0f) {
-						auto pixelAspectRatio = this->focalLengthY / this->focalLengthX;
-						this->focalLengthX = this->getWidth() * newThrowRatio;
-						this->focalLengthY = this->focalLengthX / pixelAspectRatio;
-						this->rebuildViewFromParameters();
-					}
-				}));
-				inspector->add(Widgets::EditableValue<float>::make("Pixel aspect ratio", [this]() {
-					return this->focalLengthY / this->focalLengthX;
-				}, [this](string newValueString) {
-					auto newPixelAspectRatio = ofToFloat(newValueString);
-					if (newPixelAspectRatio > 0.0f) {
-						this->focalLengthY = this->focalLengthX / newPixelAspectRatio;
-						this->rebuildViewFromParameters();
-					}
-				}));
-
-				inspector->add(Widgets::EditableValue<ofVec2f>::make("Lens offset", [this]() {
-					return this->getViewInObjectSpace().getLensOffset();
-				}, [this](string newValueString) {
-					auto newValueStrings = ofSplitString(newValueString, ",");
-					if (newValueStrings.size() == 2) {
-						this->principalPointX = ofMap(ofToFloat(newValueStrings[0]), +0.5f, -0.5f, 0, this->getWidth());
-						this->principalPointY = ofMap(ofToFloat(newValueStrings[1]), -0.5f, +0.5f, 0, this->getHeight());
-						this->rebuildViewFromParameters();
-					}
-				}));
-
-				if (this->hasDistortion) {
-					inspector->add(Widgets::Spacer::make());
-
-					inspector->add(Widgets::Title::make("Distortion coefficients", Widgets::Title::Level::H3));
-					for (int i = 0; i<RULR_VIEW_DISTORTION_COEFFICIENT_COUNT; i++) {
-						inspector->add(Widgets::Slider::make(this->distortion[i]));
-					}
-				}
-
-				inspector->add(Widgets::Spacer::make());
-
-				inspector->add(Widgets::Button::make("Export View matrix...", [this]() {
-					try {
-						this->exportViewMatrix();
-					}
-					RULR_CATCH_ALL_TO_ALERT
-				}));
-
-				inspector->add(Widgets::Button::make("Export ofxRay::Camera...", [this]() {
-					try {
-						this->exportRayCamera();
-					}
-					RULR_CATCH_ALL_TO_ALERT
-				}));
-
-				inspector->add(make_shared<Widgets::Spacer>());
-			}
-
-			//----------
-			void View::setWidth(float width) {
-				this->viewInObjectSpace.setWidth(width);
-				this->rebuildViewFromParameters();
-			}
-
-			//----------
-			void View::setHeight(float height) {
-				this->viewInObjectSpace.setHeight(height);
-				this->rebuildViewFromParameters();
-			}
-
-			//----------
-			float View::getWidth() const {
-				return this->viewInObjectSpace.getWidth();
-			}
-
-			//----------
-			float View::getHeight() const {
-				return this->viewInObjectSpace.getHeight();
-			}
-
-			//----------
-			void View::setIntrinsics(cv::Mat cameraMatrix, cv::Mat distortionCoefficients) {
-				this->focalLengthX = cameraMatrix.at<double>(0, 0);
-				this->focalLengthY = cameraMatrix.at<double>(1, 1);
-				this->principalPointX = cameraMatrix.at<double>(0, 2);
-				this->principalPointY = cameraMatrix.at<double>(1, 2);
-				for (int i = 0; i<RULR_VIEW_DISTORTION_COEFFICIENT_COUNT; i++) {
-					this->distortion[i] = distortionCoefficients.at<double>(i);
-				}
-				this->rebuildViewFromParameters();
-			}
-
-			//----------
-			void View::setProjection(const ofMatrix4x4 & projection) {
-				ofLogWarning("View::setProjection") << "Calls to this function will only change cached objects (not parameters). Use this function for debug purposes only.";
-				this->viewInObjectSpace.setProjection(projection);
-			}
-
-			//----------
-			cv::Size View::getSize() const {
-				return cv::Size(this->getWidth(), this->getHeight());
-			}
-
-			//----------
-			Mat View::getCameraMatrix() const {
-				Mat cameraMatrix = Mat::eye(3, 3, CV_64F);
-				cameraMatrix.at<double>(0, 0) = this->focalLengthX;
-				cameraMatrix.at<double>(1, 1) = this->focalLengthY;
-				cameraMatrix.at<double>(0, 2) = this->principalPointX;
-				cameraMatrix.at<double>(1, 2) = this->principalPointY;
-				return cameraMatrix;
-			}
-
-			//----------
-			Mat View::getDistortionCoefficients() const {
-				Mat distortionCoefficients = Mat::zeros(RULR_VIEW_DISTORTION_COEFFICIENT_COUNT, 1, CV_64F);
-				for (int i = 0; i<RULR_VIEW_DISTORTION_COEFFICIENT_COUNT; i++) {
-					distortionCoefficients.at<double>(i) = this->distortion[i];
-				}
-				return distortionCoefficients;
-			}
-
-			//----------
-			const ofxRay::Camera & View::getViewInObjectSpace() const {
-				return this->viewInObjectSpace;
-			}
-
-			//----------
-			ofxRay::Camera View::getViewInWorldSpace() const {
-				auto viewInWorldSpace = this->viewInObjectSpace;
-
-				const auto viewInverse = this->getTransform();
-				viewInWorldSpace.setView(viewInverse.getInverse());
-
-				return viewInWorldSpace;
-			}
-
-			//----------
-			void View::rebuildViewFromParameters() {
-				auto projection = ofxCv::makeProjectionMatrix(this->getCameraMatrix(), this->getSize());
-				this->viewInObjectSpace.setProjection(projection);
-
-				if (this->hasDistortion) {
-					auto distortionVector = vector<float>(RULR_VIEW_DISTORTION_COEFFICIENT_COUNT);
-					for (int i = 0; i < RULR_VIEW_DISTORTION_COEFFICIENT_COUNT; i++) {
-						distortionVector[i] = this->distortion[i].get();
-					}
-					this->viewInObjectSpace.distortion = distortionVector;
-				}
-			}
-
-			//----------
-			void View::exportViewMatrix() {
-				const auto matrix = this->getViewInObjectSpace().getClippedProjectionMatrix();
-				auto result = ofSystemSaveDialog(this->getName() + "-Projection.mat", "Export View matrix");
-				if (result.bSuccess) {
-					ofstream fileout(ofToDataPath(result.filePath), ios::out);
-					fileout.write((char*)& matrix, sizeof(matrix));
-					fileout.close();
-				}
-			}
-
-			//----------
-			void View::exportRayCamera() {
-				const auto view = this->getViewInWorldSpace();
-				auto result = ofSystemSaveDialog(this->getName() + ".ofxRayCamera", "Export ofxRay::Camera");
-				if (result.bSuccess) {
-					ofstream fileout(ofToDataPath(result.filePath), ios::out);
-					fileout << view;
-					fileout.close();
-				}
-			}
-
-			//---------
-			void View::parameterCallback(float &) {
-				this->rebuildViewFromParameters();
-			}
-		}
-	}
+#include "View.h"
+
+#include "ofxRulr/Utils/Parallel.h"
+
+#include "ofxCvGui/Widgets/Button.h"
+#include "ofxCvGui/Widgets/Spacer.h"
+#include "ofxCvGui/Widgets/Slider.h"
+#include "ofxCvGui/Widgets/Title.h"
+#include "ofxCvGui/Widgets/LiveValue.h"
+#include "ofxCvGui/Widgets/EditableValue.h"
+
+using namespace ofxCvGui;
+using namespace cv;
+
+#define RULR_VIEW_BATCH_SIZE 4096
+
+namespace ofxRulr {
+	namespace Nodes {
+		namespace Item {
+#pragma mark BatchTransform
+			//---------
+			View::BatchTransform::BatchTransform(const View & view) {
+				const auto viewInWorldSpace = view.getViewInWorldSpace();
+				this->viewProjection = viewInWorldSpace.getViewMatrix() * viewInWorldSpace.getClippedProjectionMatrix();
+				this->viewProjectionInverse = this->viewProjection.getInverse();
+				this->width = view.getWidth();
+				this->height = view.getHeight();
+
+				const auto cameraMatrix = view.getCameraMatrix();
+				this->focalLengthX = cameraMatrix.at<double>(0, 0);
+				this->focalLengthY = cameraMatrix.at<double>(1, 1);
+				this->principalPointX = cameraMatrix.at<double>(0, 2);
+				this->principalPointY = cameraMatrix.at<double>(1, 2);
+
+				this->undistortion = view.getUndistortion();
+				const auto distortionCoefficients = view.getDistortionCoefficients();
+				const auto hasDistortion = !this->undistortion->isIdentity();
+				this->k1 = hasDistortion ? distortionCoefficients.at<double>(0) : 0.0f;
+				this->k2 = hasDistortion ? distortionCoefficients.at<double>(1) : 0.0f;
+				this->p1 = hasDistortion ? distortionCoefficients.at<double>(2) : 0.0f;
+				this->p2 = hasDistortion ? distortionCoefficients.at<double>(3) : 0.0f;
+			}
+
+			//---------
+			void View::BatchTransform::project(const float * x, const float * y, const float * z, size_t count, float * u, float * v) const {
+				//with row vectors, clip space coordinate j is the dot product of the point with column j
+				const auto & m = this->viewProjection;
+				const float m00 = m(0, 0), m10 = m(1, 0), m20 = m(2, 0), m30 = m(3, 0);
+				const float m01 = m(0, 1), m11 = m(1, 1), m21 = m(2, 1), m31 = m(3, 1);
+				const float m03 = m(0, 3), m13 = m(1, 3), m23 = m(2, 3), m33 = m(3, 3);
+				const auto halfWidth = this->width * 0.5f;
+				const auto halfHeight = this->height * 0.5f;
+				const auto notANumber = numeric_limits<float>::quiet_NaN();
+
+				//undistorted pixels
+				for (size_t i = 0; i < count; i++) {
+					const auto clipX = x[i] * m00 + y[i] * m10 + z[i] * m20 + m30;
+					const auto clipY = x[i] * m01 + y[i] * m11 + z[i] * m21 + m31;
+					const auto clipW = x[i] * m03 + y[i] * m13 + z[i] * m23 + m33;
+					const auto inverseW = 1.0f / clipW;
+					const auto inFront = clipW > 0.0f;
+					u[i] = inFront ? (clipX * inverseW + 1.0f) * halfWidth : notANumber;
+					v[i] = inFront ? (1.0f - clipY * inverseW) * halfHeight : notANumber;
+				}
+
+				if (this->undistortion->isIdentity()) {
+					return;
+				}
+
+				//apply the distortion model (as cv::projectPoints) in normalised image coordinates
+				const auto fx = this->focalLengthX, fy = this->focalLengthY;
+				const auto cx = this->principalPointX, cy = this->principalPointY;
+				const auto k1 = this->k1, k2 = this->k2, p1 = this->p1, p2 = this->p2;
+				for (size_t i = 0; i < count; i++) {
+					const auto xn = (u[i] - cx) / fx;
+					const auto yn = (v[i] - cy) / fy;
+					const auto xy = xn * yn;
+					const auto r2 = xn * xn + yn * yn;
+					const auto radial = 1.0f + r2 * (k1 + r2 * k2);
+					const auto xd = xn * radial + 2.0f * p1 * xy + p2 * (r2 + 2.0f * xn * xn);
+					const auto yd = yn * radial + p1 * (r2 + 2.0f * yn * yn) + 2.0f * p2 * xy;
+					u[i] = xd * fx + cx;
+					v[i] = yd * fy + cy;
+				}
+			}
+
+			//---------
+			void View::BatchTransform::unproject(const ofVec2f * pixels, size_t count, float * sx, float * sy, float * sz, float * tx, float * ty, float * tz) const {
+				vector<ofVec2f> undistorted;
+				if (!this->undistortion->isIdentity()) {
+					undistorted.resize(count);
+					this->undistortion->undistortPoints(pixels, count, undistorted.data());
+					pixels = undistorted.data();
+				}
+
+				//the near (z = -1) and far (z = +1) points in normalised device coordinates, through the inverse view projection
+				const auto & m = this->viewProjectionInverse;
+				const float m00 = m(0, 0), m10 = m(1, 0), m20 = m(2, 0), m30 = m(3, 0);
+				const float m01 = m(0, 1), m11 = m(1, 1), m21 = m(2, 1), m31 = m(3, 1);
+				const float m02 = m(0, 2), m12 = m(1, 2), m22 = m(2, 2), m32 = m(3, 2);
+				const float m03 = m(0, 3), m13 = m(1, 3), m23 = m(2, 3), m33 = m(3, 3);
+				const auto toNormalisedX = 2.0f / this->width;
+				const auto toNormalisedY = 2.0f / this->height;
+
+				for (size_t i = 0; i < count; i++) {
+					const auto x = pixels[i].x * toNormalisedX - 1.0f;
+					const auto y = 1.0f - pixels[i].y * toNormalisedY;
+
+					const auto baseX = x * m00 + y * m10 + m30;
+					const auto baseY = x * m01 + y * m11 + m31;
+					const auto baseZ = x * m02 + y * m12 + m32;
+					const auto baseW = x * m03 + y * m13 + m33;
+
+					const auto inverseNearW = 1.0f / (baseW - m23);
+					const auto nearX = (baseX - m20) * inverseNearW;
+					const auto nearY = (baseY - m21) * inverseNearW;
+					const auto nearZ = (baseZ - m22) * inverseNearW;
+
+					const auto inverseFarW = 1.0f / (baseW + m23);
+					const auto farX = (baseX + m20) * inverseFarW;
+					const auto farY = (baseY + m21) * inverseFarW;
+					const auto farZ = (baseZ + m22) * inverseFarW;
+
+					sx[i] = nearX;
+					sy[i] = nearY;
+					sz[i] = nearZ;
+					tx[i] = farX - nearX;
+					ty[i] = farY - nearY;
+					tz[i] = farZ - nearZ;
+				}
+			}
+
+			//---------
+			void View::BatchTransform::project(const vector<ofVec3f> & worldPoints, vector<ofVec2f> & pixels, bool parallel) const {
+				pixels.resize(worldPoints.size());
+				auto projectRange = [&](size_t begin, size_t end) {
+					const auto size = end - begin;
+					vector<float> scratch(size * 5);
+					auto x = scratch.data(), y = x + size, z = y + size, u = z + size, v = u + size;
+					for (size_t i = 0; i < size; i++) {
+						const auto & worldPoint = worldPoints[begin + i];
+						x[i] = worldPoint.x;
+						y[i] = worldPoint.y;
+						z[i] = worldPoint.z;
+					}
+					this->project(x, y, z, size, u, v);
+					for (size_t i = 0; i < size; i++) {
+						pixels[begin + i] = ofVec2f(u[i], v[i]);
+					}
+				};
+				if (parallel) {
+					Utils::parallelFor(worldPoints.size(), projectRange, RULR_VIEW_BATCH_SIZE);
+				}
+				else {
+					for (size_t begin = 0; begin < worldPoints.size(); begin += RULR_VIEW_BATCH_SIZE) {
+						projectRange(begin, min(begin + RULR_VIEW_BATCH_SIZE, worldPoints.size()));
+					}
+				}
+			}
+
+			//---------
+			void View::BatchTransform::unproject(const vector<ofVec2f> & pixels, vector<ofVec3f> & starts, vector<ofVec3f> & transmissions, bool parallel) const {
+				starts.resize(pixels.size());
+				transmissions.resize(pixels.size());
+				auto unprojectRange = [&](size_t begin, size_t end) {
+					const auto size = end - begin;
+					vector<float> scratch(size * 6);
+					auto sx = scratch.data(), sy = sx + size, sz = sy + size;
+					auto tx = sz + size, ty = tx + size, tz = ty + size;
+					this->unproject(pixels.data() + begin, size, sx, sy, sz, tx, ty, tz);
+					for (size_t i = 0; i < size; i++) {
+						starts[begin + i] = ofVec3f(sx[i], sy[i], sz[i]);
+						transmissions[begin + i] = ofVec3f(tx[i], ty[i], tz[i]);
+					}
+				};
+				if (parallel) {
+					Utils::parallelFor(pixels.size(), unprojectRange, RULR_VIEW_BATCH_SIZE);
+				}
+				else {
+					for (size_t begin = 0; begin < pixels.size(); begin += RULR_VIEW_BATCH_SIZE) {
+						unprojectRange(begin, min(begin + RULR_VIEW_BATCH_SIZE, pixels.size()));
+					}
+				}
+			}
+
+#pragma mark View
+			//---------
+			View::View(bool hasDistortion) :
+			hasDistortion(hasDistortion),
+			updateDepth(0),
+			rebuildPending(false) {
+				RULR_NODE_INIT_LISTENER;
+				this->testCamera = nullptr;
+			}
+
+			//---------
+			string View::getTypeName() const {
+				return "Item::View";
+			}
+
+			//---------
+			void View::init() {
+				RULR_NODE_UPDATE_LISTENER;
+				RULR_NODE_SERIALIZATION_LISTENERS;
+				RULR_NODE_INSPECTOR_LISTENER;
+
+				this->focalLengthX.set("Focal Length X", 1024.0f, 1.0f, 50000.0f);
+				this->focalLengthY.set("Focal Length Y", 1024.0f, 1.0f, 50000.0f);
+				this->principalPointX.set("Center Of Projection X", 512.0f, -10000.0f, 10000.0f);
+				this->principalPointY.set("Center Of Projection Y", 512.0f, -10000.0f, 10000.0f);
+				for (int i = 0; i<RULR_VIEW_DISTORTION_COEFFICIENT_COUNT; i++) {
+					this->distortion[i].set("Distortion K" + ofToString(i + 1), 0.0f, -1000.0f, 1000.0f);
+				}
+
+				this->focalLengthX.addListener(this, &View::parameterCallback);
+				this->focalLengthY.addListener(this, &View::parameterCallback);
+				this->principalPointX.addListener(this, &View::parameterCallback);
+				this->principalPointY.addListener(this, &View::parameterCallback);
+				for (int i = 0; i<RULR_VIEW_DISTORTION_COEFFICIENT_COUNT; i++) {
+					this->distortion[i].addListener(this, &View::parameterCallback);
+				}
+
+				this->viewInObjectSpace.setDefaultFar(20.0f);
+				this->viewInObjectSpace.color = this->getColor();
+
+				this->rebuildViewFromParameters();
+			}
+
+			//---------
+			void View::update() {
+
+			}
+
+			//----------
+			void View::drawObject() {
+				this->viewInObjectSpace.draw();
+
+				if (this->testCamera) {
+					this->testCamera->draw();
+				}
+			}
+
+			//----------
+			Utils::Bounds View::getObjectBounds() const {
+				if (this->testCamera) {
+					return Utils::Bounds::everywhere();
+				}
+
+				auto bounds = RigidBody::getObjectBounds();
+
+				//corners of the drawn frustum
+				const auto & view = this->getViewInObjectSpace();
+				const auto inverseViewProjection = (view.getViewMatrix() * view.getClippedProjectionMatrix()).getInverse();
+				for (int i = 0; i < 8; i++) {
+					const ofVec3f corner(i & 1 ? 1.0f : -1.0f, i & 2 ? 1.0f : -1.0f, i & 4 ? 1.0f : -1.0f);
+					bounds.add(corner * inverseViewProjection);
+				}
+				return bounds;
+			}
+
+			//---------
+			void View::serialize(Json::Value & json) {
+				auto & jsonCalibration = json["calibration"];
+				Utils::Serializable::serialize(this->focalLengthX, jsonCalibration);
+				Utils::Serializable::serialize(this->focalLengthY, jsonCalibration);
+				Utils::Serializable::serialize(this->principalPointX, jsonCalibration);
+				Utils::Serializable::serialize(this->principalPointY, jsonCalibration);
+
+				auto & jsonResolution = json["resolution"];
+				jsonResolution["width"] = this->viewInObjectSpace.getWidth();
+				jsonResolution["height"] = this->viewInObjectSpace.getWidth();
+
+				auto & jsonDistortion = jsonCalibration["distortion"];
+				for (int i = 0; i<RULR_VIEW_DISTORTION_COEFFICIENT_COUNT; i++) {
+					Utils::Serializable::serialize(this->distortion[i], jsonDistortion);
+				}
+			}
+
+			//---------
+			void View::deserialize(const Json::Value & json) {
+				this->beginUpdate();
+
+				const auto & jsonCalibration = json["calibration"];
+				Utils::Serializable::deserialize(this->focalLengthX, jsonCalibration);
+				Utils::Serializable::deserialize(this->focalLengthY, jsonCalibration);
+				Utils::Serializable::deserialize(this->principalPointX, jsonCalibration);
+				Utils::Serializable::deserialize(this->principalPointY, jsonCalibration);
+
+				const auto & jsonResolution = json["resolution"];
+				if (!jsonResolution.isNull()) {
+					this->setWidth(jsonResolution["width"].asFloat());
+					this->setWidth(jsonResolution["height"].asFloat());
+				}
+				else {
+					this->setWidth(1024);
+					this->setHeight(768);
+				}
+
+				auto & jsonDistortion = jsonCalibration["distortion"];
+				for (int i = 0; i<RULR_VIEW_DISTORTION_COEFFICIENT_COUNT; i++) {
+					Utils::Serializable::deserialize(this->distortion[i], jsonDistortion);
+				}
+
+				this->commitUpdate();
+			}
+
+			//---------
+			void View::populateInspector(ofxCvGui::ElementGroupPtr inspector) {
+				inspector->add(Widgets::Title::make("View", Widgets::Title::Level::H2));
+				inspector->add(make_shared<Widgets::LiveValue<string>>("Resolution", [this](){
+					string msg;
+					msg = ofToString((int)this->getWidth()) + ", " + ofToString((int)this->getHeight());
+					return msg;
+				}));
+
+				inspector->add(Widgets::Title::make("Camera matrix", Widgets::Title::Level::H3));
+				//the parameter listeners rebuild the view when these change
+				inspector->add(Widgets::Slider::make(this->focalLengthX));
+				inspector->add(Widgets::Slider::make(this->focalLengthY));
+				inspector->add(Widgets::Slider::make(this->principalPointX));
+				inspector->add(Widgets::Slider::make(this->principalPointY));
+
+				inspector->add(Widgets::EditableValue<float>::make("Throw ratio X", [this]() {
+					return this->viewInObjectSpace.getThrowRatio();
+				}, [this](string newValueString) {
+					auto newThrowRatio = ofToFloat(newValueString);
+					if (newThrowRatio > 0.0f) {
+						auto pixelAspectRatio = this->focalLengthY / this->focalLengthX;
+						this->beginUpdate();
+						this->focalLengthX = this->getWidth() * newThrowRatio;
+						this->focalLengthY = this->focalLengthX / pixelAspectRatio;
+						this->commitUpdate();
+					}
+				}));
+				inspector->add(Widgets::EditableValue<float>::make("Pixel aspect ratio", [this]() {
+					return this->focalLengthY / this->focalLengthX;
+				}, [this](string newValueString) {
+					auto newPixelAspectRatio = ofToFloat(newValueString);
+					if (newPixelAspectRatio > 0.0f) {
+						this->focalLengthY = this->focalLengthX / newPixelAspectRatio;
+					}
+				}));
+
+				inspector->add(Widgets::EditableValue<ofVec2f>::make("Lens offset", [this]() {
+					return this->getViewInObjectSpace().getLensOffset();
+				}, [this](string newValueString) {
+					auto newValueStrings = ofSplitString(newValueString, ",");
+					if (newValueStrings.size() == 2) {
+						this->beginUpdate();
+						this->principalPointX = ofMap(ofToFloat(newValueStrings[0]), +0.5f, -0.5f, 0, this->getWidth());
+						this->principalPointY = ofMap(ofToFloat(newValueStrings[1]), -0.5f, +0.5f, 0, this->getHeight());
+						this->commitUpdate();
+					}
+				}));
+
+				if (this->hasDistortion) {
+					inspector->add(Widgets::Spacer::make());
+
+					inspector->add(Widgets::Title::make("Distortion coefficients", Widgets::Title::Level::H3));
+					for (int i = 0; i<RULR_VIEW_DISTORTION_COEFFICIENT_COUNT; i++) {
+						inspector->add(Widgets::Slider::make(this->distortion[i]));
+					}
+				}
+
+				inspector->add(Widgets::Spacer::make());
+
+				inspector->add(Widgets::Button::make("Export View matrix...", [this]() {
+					try {
+						this->exportViewMatrix();
+					}
+					RULR_CATCH_ALL_TO_ALERT
+				}));
+
+				inspector->add(Widgets::Button::make("Export ofxRay::Camera...", [this]() {
+					try {
+						this->exportRayCamera();
+					}
+					RULR_CATCH_ALL_TO_ALERT
+				}));
+
+				inspector->add(make_shared<Widgets::Spacer>());
+			}
+
+			//----------
+			void View::setWidth(float width) {
+				this->viewInObjectSpace.setWidth(width);
+				this->rebuildViewFromParameters();
+			}
+
+			//----------
+			void View::setHeight(float height) {
+				this->viewInObjectSpace.setHeight(height);
+				this->rebuildViewFromParameters();
+			}
+
+			//----------
+			float View::getWidth() const {
+				return this->viewInObjectSpace.getWidth();
+			}
+
+			//----------
+			float View::getHeight() const {
+				return this->viewInObjectSpace.getHeight();
+			}
+
+			//----------
+			void View::setIntrinsics(cv::Mat cameraMatrix, cv::Mat distortionCoefficients) {
+				this->beginUpdate();
+				this->focalLengthX = cameraMatrix.at<double>(0, 0);
+				this->focalLengthY = cameraMatrix.at<double>(1, 1);
+				this->principalPointX = cameraMatrix.at<double>(0, 2);
+				this->principalPointY = cameraMatrix.at<double>(1, 2);
+				for (int i = 0; i<RULR_VIEW_DISTORTION_COEFFICIENT_COUNT; i++) {
+					this->distortion[i] = distortionCoefficients.at<double>(i);
+				}
+				this->commitUpdate();
+			}
+
+			//----------
+			void View::setProjection(const ofMatrix4x4 & projection) {
+				ofLogWarning("View::setProjection") << "Calls to this function will only change cached objects (not parameters). Use this function for debug purposes only.";
+				this->viewInObjectSpace.setProjection(projection);
+			}
+
+			//----------
+			void View::beginUpdate() {
+				this->updateDepth++;
+			}
+
+			//----------
+			void View::commitUpdate() {
+				if (this->updateDepth == 0) {
+					ofLogWarning("View::commitUpdate") << "commitUpdate() called without beginUpdate()";
+					return;
+				}
+				this->updateDepth--;
+				if (this->updateDepth == 0 && this->rebuildPending) {
+					this->rebuildViewFromParameters();
+				}
+			}
+
+			//----------
+			cv::Size View::getSize() const {
+				return cv::Size(this->getWidth(), this->getHeight());
+			}
+
+			//----------
+			Mat View::getCameraMatrix() const {
+				return this->cameraMatrix;
+			}
+
+			//----------
+			Mat View::getDistortionCoefficients() const {
+				return this->distortionCoefficients;
+			}
+
+			//----------
+			const ofxRay::Camera & View::getViewInObjectSpace() const {
+				return this->viewInObjectSpace;
+			}
+
+			//----------
+			ofxRay::Camera View::getViewInWorldSpace() const {
+				auto viewInWorldSpace = this->viewInObjectSpace;
+				viewInWorldSpace.setView(this->getTransformInverse());
+
+				return viewInWorldSpace;
+			}
+
+			//----------
+			shared_ptr<const Utils::Undistortion> View::getUndistortion() const {
+				const auto cameraMatrix = this->getCameraMatrix();
+				const Mat distortionCoefficients = this->hasDistortion
+					? this->getDistortionCoefficients()
+					: Mat(Mat::zeros(RULR_VIEW_DISTORTION_COEFFICIENT_COUNT, 1, CV_64F));
+				const auto size = this->getSize();
+
+				lock_guard<mutex> lock(this->undistortionLock);
+				if (!this->undistortion || !this->undistortion->matches(cameraMatrix, distortionCoefficients, size)) {
+					//anybody still holding the previous tables keeps them
+					this->undistortion = make_shared<Utils::Undistortion>(cameraMatrix, distortionCoefficients, size);
+				}
+				return this->undistortion;
+			}
+
+			//----------
+			void View::undistortImage(const cv::Mat & distorted, cv::Mat & undistorted) const {
+				this->getUndistortion()->undistortImage(distorted, undistorted);
+			}
+
+			//----------
+			void View::undistortPoints(const vector<ofVec2f> & distorted, vector<ofVec2f> & undistorted) const {
+				this->getUndistortion()->undistortPoints(distorted, undistorted);
+			}
+
+			//----------
+			View::BatchTransform View::getBatchTransform() const {
+				return BatchTransform(*this);
+			}
+
+			//----------
+			void View::rebuildViewFromParameters() {
+				if (this->updateDepth > 0) {
+					this->rebuildPending = true;
+					return;
+				}
+				this->rebuildPending = false;
+
+				//make new matrices rather than writing into the old ones, since they may be held by others
+				Mat cameraMatrix = Mat::eye(3, 3, CV_64F);
+				cameraMatrix.at<double>(0, 0) = this->focalLengthX;
+				cameraMatrix.at<double>(1, 1) = this->focalLengthY;
+				cameraMatrix.at<double>(0, 2) = this->principalPointX;
+				cameraMatrix.at<double>(1, 2) = this->principalPointY;
+				this->cameraMatrix = cameraMatrix;
+
+				Mat distortionCoefficients = Mat::zeros(RULR_VIEW_DISTORTION_COEFFICIENT_COUNT, 1, CV_64F);
+				for (int i = 0; i<RULR_VIEW_DISTORTION_COEFFICIENT_COUNT; i++) {
+					distortionCoefficients.at<double>(i) = this->distortion[i];
+				}
+				this->distortionCoefficients = distortionCoefficients;
+
+				auto projection = ofxCv::makeProjectionMatrix(this->cameraMatrix, this->getSize());
+				this->viewInObjectSpace.setProjection(projection);
+
+				if (this->hasDistortion) {
+					auto distortionVector = vector<float>(RULR_VIEW_DISTORTION_COEFFICIENT_COUNT);
+					for (int i = 0; i < RULR_VIEW_DISTORTION_COEFFICIENT_COUNT; i++) {
+						distortionVector[i] = this->distortion[i].get();
+					}
+					this->viewInObjectSpace.distortion = distortionVector;
+				}
+			}
+
+			//----------
+			void View::exportViewMatrix() {
+				const auto matrix = this->getViewInObjectSpace().getClippedProjectionMatrix();
+				auto result = ofSystemSaveDialog(this->getName() + "-Projection.mat", "Export View matrix");
+				if (result.bSuccess) {
+					ofstream fileout(ofToDataPath(result.filePath), ios::out);
+					fileout.write((char*)& matrix, sizeof(matrix));
+					fileout.close();
+				}
+			}
+
+			//----------
+			void View::exportRayCamera() {
+				const auto view = this->getViewInWorldSpace();
+				auto result = ofSystemSaveDialog(this->getName() + ".ofxRayCamera", "Export ofxRay::Camera");
+				if (result.bSuccess) {
+					ofstream fileout(ofToDataPath(result.filePath), ios::out);
+					fileout << view;
+					fileout.close();
+				}
+			}
+
+			//---------
+			void View::parameterCallback(float &) {
+				this->rebuildViewFromParameters();
+			}
+		}
+	}
 }
\ No newline at end of file
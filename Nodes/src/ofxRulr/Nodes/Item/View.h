@@ -1,64 +1,117 @@
-#pragma once
-
-#include "RigidBody.h"
-
-#include "../../../addons/ofxRay/src/ofxRay.h"
-#include <opencv2/calib3d/calib3d.hpp>
-
-#define RULR_VIEW_DISTORTION_COEFFICIENT_COUNT 4
-#define RULR_VIEW_CALIBRATION_FLAGS CV_CALIB_FIX_K5 | CV_CALIB_FIX_K6 | CV_CALIB_ZERO_TANGENT_DIST
-namespace ofxRulr {
-	namespace Nodes {
-		namespace Item {
-			class View : public RigidBody {
-			public:
-				View(bool hasDistortion = true);
-				virtual string getTypeName() const override;
-
-				void init();
-				void update();
-				void drawObject() override;
-
-				void setDistortionEnabled(bool);
-				bool getDistortionEnabled() const;
-
-				void setWidth(float);
-				void setHeight(float);
-				float getWidth() const;
-				float getHeight() const;
-
-				void setIntrinsics(cv::Mat cameraMatrix, cv::Mat distortionCoefficients = cv::Mat::zeros(RULR_VIEW_DISTORTION_COEFFICIENT_COUNT, 1, CV_64F));
-				void setProjection(const ofMatrix4x4 &);
-
-				cv::Size getSize() const;
-				cv::Mat getCameraMatrix() const;
-				virtual bool getHasDistortion() const { return this->hasDistortion; };
-				cv::Mat getDistortionCoefficients() const;
-
-				const ofxRay::Camera & getViewInObjectSpace() const;
-				ofxRay::Camera getViewInWorldSpace() const;
-			protected:
-				void rebuildViewFromParameters();
-
-				void exportViewMatrix();
-				void exportRayCamera();
-
-				ofParameter<float> focalLengthX, focalLengthY;
-				ofParameter<float> principalPointX, principalPointY;
-
-				const bool hasDistortion;
-				ofParameter<float> distortion[RULR_VIEW_DISTORTION_COEFFICIENT_COUNT];
-
-				//Versions of this view as an ofxRay::Camera in world space and object space
-				ofxRay::Camera viewInObjectSpace;
-			private:
-				void parameterCallback(float &);
-				void serialize(Json::Value &);
-				void deserialize(const Json::Value &);
-				void populateInspector(ofxCvGui::ElementGroupPtr);
-
-				ofxRay::Camera * testCamera;
-			};
-		}
-	}
+#pragma once
+
+#include "RigidBody.h"
+#include "ofxRulr/Utils/Undistortion.h"
+
+#include "../../../addons/ofxRay/src/ofxRay.h"
+#include <opencv2/calib3d/calib3d.hpp>
+
+#define RULR_VIEW_DISTORTION_COEFFICIENT_COUNT 4
+#define RULR_VIEW_CALIBRATION_FLAGS CV_CALIB_FIX_K5 | CV_CALIB_FIX_K6 | CV_CALIB_ZERO_TANGENT_DIST
+#define RULR_VIEW_CALIBRATION_NO_DISTORTION_FLAGS (CV_CALIB_FIX_K1 | CV_CALIB_FIX_K2 | CV_CALIB_FIX_K3 | CV_CALIB_FIX_K4 | CV_CALIB_FIX_K5 | CV_CALIB_FIX_K6 | CV_CALIB_ZERO_TANGENT_DIST)
+namespace ofxRulr {
+	namespace Nodes {
+		namespace Item {
+			class View : public RigidBody {
+			public:
+				/**
+				Projects world points to pixels, and unprojects pixels to world space rays, in batches.
+				Works from a snapshot of the view (transform, projection and undistortion tables) taken at construction, so it is safe to use from any thread.
+				The kernels take and give structures of arrays, and their inner loops are branch free so that the compiler vectorises them.
+				**/
+				class BatchTransform {
+				public:
+					BatchTransform(const View &);
+
+					///World space points to (distorted) pixel coordinates. Points behind the view come out as NaN.
+					void project(const float * x, const float * y, const float * z, size_t count, float * u, float * v) const;
+
+					///(Distorted) pixel coordinates to world space rays, which start on the near plane (s) and reach the far plane at s + t.
+					void unproject(const ofVec2f * pixels, size_t count, float * sx, float * sy, float * sz, float * tx, float * ty, float * tz) const;
+
+					///Whole array versions, split across threads if parallel is true
+					void project(const vector<ofVec3f> & worldPoints, vector<ofVec2f> & pixels, bool parallel = true) const;
+					void unproject(const vector<ofVec2f> & pixels, vector<ofVec3f> & starts, vector<ofVec3f> & transmissions, bool parallel = true) const;
+				protected:
+					ofMatrix4x4 viewProjection;
+					ofMatrix4x4 viewProjectionInverse;
+					float width, height;
+					float focalLengthX, focalLengthY;
+					float principalPointX, principalPointY;
+					float k1, k2, p1, p2;
+					shared_ptr<const Utils::Undistortion> undistortion;
+				};
+
+				View(bool hasDistortion = true);
+				virtual string getTypeName() const override;
+
+				void init();
+				void update();
+				void drawObject() override;
+				Utils::Bounds getObjectBounds() const override;
+
+				void setDistortionEnabled(bool);
+				bool getDistortionEnabled() const;
+
+				void setWidth(float);
+				void setHeight(float);
+				float getWidth() const;
+				float getHeight() const;
+
+				void setIntrinsics(cv::Mat cameraMatrix, cv::Mat distortionCoefficients = cv::Mat::zeros(RULR_VIEW_DISTORTION_COEFFICIENT_COUNT, 1, CV_64F));
+				void setProjection(const ofMatrix4x4 &);
+
+				///Changes to the size and intrinsics between beginUpdate() and commitUpdate() cause one rebuild of the view, at commit.
+				///Transactions can be nested, the rebuild happens when the outermost one commits.
+				void beginUpdate();
+				void commitUpdate();
+
+				cv::Size getSize() const;
+
+				///These are shared and read only (they are replaced rather than written to when the intrinsics change), so clone them before writing into them.
+				cv::Mat getCameraMatrix() const;
+				virtual bool getHasDistortion() const { return this->hasDistortion; };
+				cv::Mat getDistortionCoefficients() const;
+
+				const ofxRay::Camera & getViewInObjectSpace() const;
+				ofxRay::Camera getViewInWorldSpace() const;
+
+				///Undistortion tables for the current intrinsics. These are rebuilt only when the intrinsics or size change, and can be held and used from any thread.
+				shared_ptr<const Utils::Undistortion> getUndistortion() const;
+				void undistortImage(const cv::Mat & distorted, cv::Mat & undistorted) const;
+				void undistortPoints(const vector<ofVec2f> & distorted, vector<ofVec2f> & undistorted) const; // pixel coordinates in and out
+
+				BatchTransform getBatchTransform() const;
+			protected:
+				void rebuildViewFromParameters();
+
+				void exportViewMatrix();
+				void exportRayCamera();
+
+				ofParameter<float> focalLengthX, focalLengthY;
+				ofParameter<float> principalPointX, principalPointY;
+
+				const bool hasDistortion;
+				ofParameter<float> distortion[RULR_VIEW_DISTORTION_COEFFICIENT_COUNT];
+
+				//Versions of this view as an ofxRay::Camera in world space and object space
+				ofxRay::Camera viewInObjectSpace;
+			private:
+				void parameterCallback(float &);
+				void serialize(Json::Value &);
+				void deserialize(const Json::Value &);
+				void populateInspector(ofxCvGui::ElementGroupPtr);
+
+				ofxRay::Camera * testCamera;
+
+				int updateDepth;
+				bool rebuildPending;
+				cv::Mat cameraMatrix;
+				cv::Mat distortionCoefficients;
+
+				mutable shared_ptr<const Utils::Undistortion> undistortion;
+				mutable mutex undistortionLock;
+			};
+		}
+	}
 }
\ No newline at end of file
@@ -1,16 +1,16 @@
-#pragma once
-
-#include "../Item/Base.h"
-#include "ofxRulr/Nodes/Base.h"
-
-using namespace std;
-
-namespace ofxRulr {
-	namespace Nodes {
-		namespace Procedure {
-			class Base : public Nodes::Base {
-			public:
-			};
-		}
-	}
+#pragma once
+
+#include "../Item/Base.h"
+#include "ofxRulr/Nodes/Base.h"
+
+using namespace std;
+
+namespace ofxRulr {
+	namespace Nodes {
+		namespace Procedure {
+			class Base : public Nodes::Base {
+			public:
+			};
+		}
+	}
 }
\ No newline at end of file
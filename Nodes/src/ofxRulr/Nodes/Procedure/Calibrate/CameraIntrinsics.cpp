@@ -1,250 +1,824 @@
-#include "CameraIntrinsics.h"
-
-#include "../../Item/Board.h"
-#include "../../Item/Camera.h"
-
-#include "ofxRulr/Utils/Utils.h"
-
-#include "ofConstants.h"
-#include "ofxCvGui.h"
-
-using namespace ofxRulr::Graph;
-using namespace ofxRulr::Nodes;
-
-using namespace ofxCvGui;
-
-using namespace ofxCv;
-using namespace cv;
-
-namespace ofxRulr {
-	namespace Nodes {
-		namespace Procedure {
-			namespace Calibrate {
-				//----------
-				CameraIntrinsics::CameraIntrinsics() {
-					RULR_NODE_INIT_LISTENER;
-				}
-
-				//----------
-				void CameraIntrinsics::init() {
-					RULR_NODE_UPDATE_LISTENER;
-					RULR_NODE_SERIALIZATION_LISTENERS;
-					RULR_NODE_INSPECTOR_LISTENER;
-
-					this->addInput(MAKE(Pin<Item::Board>));
-					this->addInput(MAKE(Pin<Item::Camera>));
-
-					this->view = MAKE(ofxCvGui::Panels::Base);
-					this->view->onDraw += [this](DrawArguments & drawArgs) {
-						auto camera = this->getInput<Item::Camera>();
-						if (camera) {
-							auto grabber = camera->getGrabber();
-							if (this->grayscale.isAllocated()) {
-								this->grayscale.draw(drawArgs.localBounds);
-							}
-
-							ofPushMatrix();
-							{
-								ofScale(drawArgs.localBounds.getWidth() / camera->getWidth(), drawArgs.localBounds.getHeight() / camera->getHeight());
-
-								//draw current corners
-								ofxCv::drawCorners(this->currentCorners);
-
-								//draw past corners
-								ofPushStyle();
-								{
-									ofFill();
-									ofSetLineWidth(0.0f);
-									int boardIndex = 0;
-									ofColor boardColor(200, 100, 100);
-									for (auto & board : this->accumulatedCorners) {
-										boardColor.setHue(boardIndex++ * 30 % 360);
-										ofSetColor(boardColor);
-										for (auto & corner : board) {
-											ofCircle(corner, 3.0f);
-										}
-									}
-								}
-								ofPopStyle();
-							}
-							ofPopMatrix();
-
-							if (!this->isBeingInspected()) {
-								ofPushStyle(); 
-								{
-									ofSetColor(255, 100);
-									if (grabber->getDeviceSpecification().supports(ofxMachineVision::Feature::Feature_FreeRun)) {
-										ofxCvGui::Utils::drawText("Select node to enable board finder...", drawArgs.localBounds);
-									}
-								}
-								ofPopStyle();
-							}
-						}
-						
-					};
-
-					this->error.set("Reprojection error", 0.0f, 0.0f, std::numeric_limits<float>::max());
-
-					this->error = 0.0f;
-				}
-
-				//----------
-				string CameraIntrinsics::getTypeName() const {
-					return "Procedure::Calibrate::CameraIntrinsics";
-				}
-
-				//----------
-				ofxCvGui::PanelPtr CameraIntrinsics::getView() {
-					return this->view;
-				}
-
-				//----------
-				void CameraIntrinsics::update() {
-					if (this->isBeingInspected()) {
-						auto camera = this->getInput<Item::Camera>();
-						if (camera) {
-							auto grabber = camera->getGrabber();
-							if (grabber->getDeviceSpecification().supports(ofxMachineVision::Feature::Feature_FreeRun)) {
-								try {
-									this->findBoard();
-								}
-								RULR_CATCH_ALL_TO_ERROR
-							}
-						}
-					}
-				}
-
-				//----------
-				void CameraIntrinsics::serialize(Json::Value & json) {
-					auto & jsonCorners = json["corners"];
-					for (int i = 0; i<this->accumulatedCorners.size(); i++) {
-						for (int j = 0; j<this->accumulatedCorners[i].size(); j++) {
-							jsonCorners[i][j]["x"] = accumulatedCorners[i][j].x;
-							jsonCorners[i][j]["y"] = accumulatedCorners[i][j].y;
-						}
-					}
-					Utils::Serializable::serialize(this->error, json);
-				}
-
-				//----------
-				void CameraIntrinsics::deserialize(const Json::Value & json) {
-					this->accumulatedCorners.clear();
-
-					auto & jsonBoards = json["corners"];
-					for (auto & jsonBoard : jsonBoards) {
-						auto board = vector<ofVec2f>();
-						for (auto & jsonCorner : jsonBoard) {
-							board.push_back(ofVec2f(jsonCorner["x"].asFloat(), jsonCorner["y"].asFloat()));
-						}
-						this->accumulatedCorners.push_back(board);
-					}
-					Utils::Serializable::deserialize(this->error, json);
-				}
-
-				//----------
-				void CameraIntrinsics::populateInspector(ofxCvGui::ElementGroupPtr inspector) {
-					inspector->add(Widgets::Indicator::make("Points found", [this]() {
-						return (Widgets::Indicator::Status) !this->currentCorners.empty();
-					}));
-					inspector->add(Widgets::LiveValue<int>::make("Calibration set count", [this]() {
-						return (int)accumulatedCorners.size();
-					}));
-					inspector->add(Widgets::Button::make("Add board to calibration set", [this]() {
-						auto camera = this->getInput<Item::Camera>();
-						if (camera) {
-							//if it's a DSLR, let's take a single shot and find the board
-							const auto cameraSpecification = camera->getGrabber()->getDeviceSpecification();
-							if (cameraSpecification.supports(ofxMachineVision::Feature::Feature_OneShot) && !cameraSpecification.supports(ofxMachineVision::Feature::Feature_FreeRun)) {
-								//by calling getFreshFrame(), then update(), we should guarantee that the frame 
-								camera->getGrabber()->getFreshFrame();
-								this->findBoard();
-							}
-						}
-						if (this->currentCorners.empty()) {
-							Utils::playFailSound();
-						}
-						else {
-							Utils::playSuccessSound();
-							this->accumulatedCorners.push_back(currentCorners);
-						}
-					}, ' '));
-					inspector->add(Widgets::Button::make("Clear calibration set", [this]() {
-						this->accumulatedCorners.clear();
-					}));
-
-					inspector->add(Widgets::Spacer::make());
-
-					auto calibrateButton = Widgets::Button::make("Calibrate", [this]() {
-						try {
-							this->calibrate();
-						}
-						RULR_CATCH_ALL_TO_ALERT
-					}, OF_KEY_RETURN);
-					calibrateButton->setHeight(100.0f);
-					inspector->add(calibrateButton);
-					inspector->add(Widgets::LiveValue<float>::make("Reprojection error [px]", [this]() {
-						return this->error;
-					}));
-				}
-
-				//----------
-				void CameraIntrinsics::findBoard() {
-					this->throwIfMissingAnyConnection();
-
-					auto camera = this->getInput<Item::Camera>();
-					auto board = this->getInput<Item::Board>();
-
-					auto grabber = camera->getGrabber();
-					auto frame = grabber->getFrame();
-
-					//copy the frame out
-					frame->lockForReading();
-					auto & pixels = frame->getPixels();
-					if (!pixels.isAllocated()) {
-						frame->unlock();
-						throw(Exception("Camera pixels are not allocated. Perhaps we need to wait for a frame?"));
-					}
-					if (this->grayscale.getWidth() != pixels.getWidth() || this->grayscale.getHeight() != pixels.getHeight()) {
-						this->grayscale.allocate(pixels.getWidth(), pixels.getHeight(), OF_IMAGE_GRAYSCALE);
-					}
-					if (pixels.getNumChannels() != 1) {
-						cv::cvtColor(toCv(pixels), toCv(this->grayscale), CV_RGB2GRAY);
-					}
-					else {
-						this->grayscale = pixels;
-					}
-					frame->unlock();
-
-					this->grayscale.update();
-					this->currentCorners.clear();
-
-					board->findBoard(toCv(this->grayscale), toCv(this->currentCorners));
-				}
-				
-				//----------
-				void CameraIntrinsics::calibrate() {
-					this->throwIfMissingAConnection<Item::Camera>();
-					this->throwIfMissingAConnection<Item::Board>();
-
-					if (this->accumulatedCorners.size() == 0) {
-						throw(ofxRulr::Exception("You need to add some board captures before trying to calibrate"));
-					}
-					auto camera = this->getInput<Item::Camera>();
-					auto board = this->getInput<Item::Board>();
-
-					auto objectPointsSet = vector<vector<Point3f>>(this->accumulatedCorners.size(), board->getObjectPoints());
-					auto cameraResolution = cv::Size(camera->getWidth(), camera->getHeight());
-
-					Mat cameraMatrix = Mat::eye(3, 3, CV_64F);
-					Mat distortionCoefficients = Mat::zeros(8, 1, CV_64F);
-
-					vector<Mat> Rotations, Translations;
-					vector<vector<Point2f>> accumulatedCornersCv = toCv(this->accumulatedCorners);
-					auto flags = CV_CALIB_FIX_K6 | CV_CALIB_FIX_K5;
-					this->error = cv::calibrateCamera(objectPointsSet, accumulatedCornersCv, cameraResolution, cameraMatrix, distortionCoefficients, Rotations, Translations, flags);
-					camera->setIntrinsics(cameraMatrix, distortionCoefficients);
-				}
-			}
-		}
-	}
+#include "CameraIntrinsics.h"
+
+#include "../../Item/Board.h"
+#include "../../Item/Camera.h"
+
+#include "ofxRulr/Utils/Utils.h"
+#include "ofxRulr/Utils/Parallel.h"
+#include "ofxRulr/Utils/LensModelSelection.h"
+
+#include "ofConstants.h"
+#include "ofxCvGui.h"
+
+#include <numeric>
+
+#define RULR_CAMERAINTRINSICS_ITERATIONS 30
+#define RULR_CAMERAINTRINSICS_LEAVE_ONE_OUT_ITERATIONS 5
+#define RULR_CAMERAINTRINSICS_MIN_LEAVE_ONE_OUT_VIEWS 5
+
+using namespace ofxRulr::Graph;
+using namespace ofxRulr::Nodes;
+
+using namespace ofxCvGui;
+
+using namespace ofxCv;
+using namespace cv;
+
+namespace ofxRulr {
+	namespace Nodes {
+		namespace Procedure {
+			namespace Calibrate {
+#pragma mark IntrinsicsSolver
+				//----------
+				/**
+				Levenberg-Marquardt refinement of the intrinsics (fx, fy, cx, cy, k1, k2, p1, p2 - the coefficients which Item::View stores)
+				together with the pose of every board, starting from the values it is given.
+				The board poses are eliminated from the normal equations (Schur complement), so each iteration is linear in the number of views.
+				**/
+				class IntrinsicsSolver {
+				public:
+					struct BoardView {
+						const vector<Point2f> * imagePoints;
+						Mat rotation;
+						Mat translation;
+					};
+
+					IntrinsicsSolver(const vector<Point3f> & objectPoints, const Mat & cameraMatrix, const Mat & distortionCoefficients, int flags = 0) :
+						objectPoints(objectPoints) {
+						this->intrinsics[0] = cameraMatrix.at<double>(0, 0);
+						this->intrinsics[1] = cameraMatrix.at<double>(1, 1);
+						this->intrinsics[2] = cameraMatrix.at<double>(0, 2);
+						this->intrinsics[3] = cameraMatrix.at<double>(1, 2);
+						for (int i = 0; i < 4; i++) {
+							this->intrinsics[4 + i] = distortionCoefficients.at<double>(i);
+						}
+
+						//terms which the lens model (calibration flags) holds still
+						const bool fixed[8] = {
+							(flags & CV_CALIB_FIX_FOCAL_LENGTH) != 0,
+							(flags & CV_CALIB_FIX_FOCAL_LENGTH) != 0,
+							(flags & CV_CALIB_FIX_PRINCIPAL_POINT) != 0,
+							(flags & CV_CALIB_FIX_PRINCIPAL_POINT) != 0,
+							(flags & CV_CALIB_FIX_K1) != 0,
+							(flags & CV_CALIB_FIX_K2) != 0,
+							(flags & CV_CALIB_ZERO_TANGENT_DIST) != 0,
+							(flags & CV_CALIB_ZERO_TANGENT_DIST) != 0
+						};
+						std::copy(fixed, fixed + 8, this->fixed);
+					}
+
+					///Adds a board. If the pose is empty, it is found with solvePnP from the current intrinsics
+					void addView(const vector<Point2f> & imagePoints, const Mat & rotation = Mat(), const Mat & translation = Mat()) {
+						BoardView view;
+						view.imagePoints = &imagePoints;
+						if (rotation.empty() || translation.empty()) {
+							cv::solvePnP(this->objectPoints, imagePoints, this->getCameraMatrix(), this->getDistortionCoefficients(), view.rotation, view.translation);
+						}
+						else {
+							view.rotation = rotation.clone();
+							view.translation = translation.clone();
+						}
+						this->views.push_back(view);
+					}
+
+					///Returns the RMS reprojection error over all views [px]
+					float solve(int maxIterations, bool parallel) {
+						const auto viewCount = this->views.size();
+						vector<ViewBlocks> blocks(viewCount);
+						vector<Mat> cInverse(viewCount);
+						vector<BoardView> candidateViews(viewCount);
+						double candidateIntrinsics[8];
+
+						auto cost = this->getCost(this->intrinsics, this->views, parallel);
+						double lambda = 1e-3;
+
+						for (int iteration = 0; iteration < maxIterations; iteration++) {
+							forEachView(viewCount, [&](size_t i) {
+								this->getBlocks(this->views[i], blocks[i]);
+							}, parallel);
+
+							Mat A = Mat::zeros(8, 8, CV_64F);
+							Mat gi = Mat::zeros(8, 1, CV_64F);
+							for (const auto & block : blocks) {
+								A += block.A;
+								gi += block.gi;
+							}
+
+							//fixed terms have no jacobian, so give them a unit diagonal to keep the system solvable (their delta is then 0)
+							for (int i = 0; i < 8; i++) {
+								if (this->fixed[i]) {
+									A.at<double>(i, i) = 1.0;
+								}
+							}
+
+							bool improved = false;
+							bool converged = false;
+							while (!improved && lambda < 1e10) {
+								//reduced (damped) system for the intrinsics
+								Mat S = A + lambda * Mat::diag(A.diag());
+								Mat rhs = -gi;
+								for (size_t i = 0; i < viewCount; i++) {
+									const auto & block = blocks[i];
+									Mat C = block.C + lambda * Mat::diag(block.C.diag());
+									cInverse[i] = C.inv(DECOMP_CHOLESKY);
+									Mat BCInverse = block.B * cInverse[i];
+									S -= BCInverse * block.B.t();
+									rhs += BCInverse * block.ge;
+								}
+
+								Mat deltaIntrinsics;
+								if (!cv::solve(S, rhs, deltaIntrinsics, DECOMP_CHOLESKY)) {
+									lambda *= 10.0;
+									continue;
+								}
+
+								//back substitute for the board poses
+								for (int i = 0; i < 8; i++) {
+									candidateIntrinsics[i] = this->intrinsics[i] + deltaIntrinsics.at<double>(i);
+								}
+								for (size_t i = 0; i < viewCount; i++) {
+									const auto & block = blocks[i];
+									Mat deltaPose = cInverse[i] * (-block.ge - block.B.t() * deltaIntrinsics);
+									candidateViews[i].imagePoints = this->views[i].imagePoints;
+									candidateViews[i].rotation = this->views[i].rotation + deltaPose.rowRange(0, 3);
+									candidateViews[i].translation = this->views[i].translation + deltaPose.rowRange(3, 6);
+								}
+
+								const auto candidateCost = this->getCost(candidateIntrinsics, candidateViews, parallel);
+								if (candidateCost < cost) {
+									converged = cost - candidateCost < 1e-10 * cost;
+									cost = candidateCost;
+									std::copy(candidateIntrinsics, candidateIntrinsics + 8, this->intrinsics);
+									std::swap(this->views, candidateViews);
+									lambda = std::max(lambda / 10.0, 1e-12);
+									improved = true;
+								}
+								else {
+									lambda *= 10.0;
+								}
+							}
+
+							if (!improved || converged) {
+								break;
+							}
+						}
+
+						return sqrt(cost / (double) (this->objectPoints.size() * max<size_t>(viewCount, 1)));
+					}
+
+					///RMS reprojection error of one view with the current values [px]
+					float getViewError(size_t viewIndex) const {
+						return sqrt(this->getViewCost(this->intrinsics, this->views[viewIndex]) / (double) this->objectPoints.size());
+					}
+
+					Mat getCameraMatrix() const {
+						return getCameraMatrix(this->intrinsics);
+					}
+
+					Mat getDistortionCoefficients() const {
+						return getDistortionCoefficients(this->intrinsics);
+					}
+
+					const BoardView & getView(size_t viewIndex) const {
+						return this->views[viewIndex];
+					}
+				protected:
+					struct ViewBlocks {
+						Mat A; // intrinsics x intrinsics
+						Mat B; // intrinsics x pose
+						Mat C; // pose x pose
+						Mat gi;
+						Mat ge;
+					};
+
+					static Mat getCameraMatrix(const double * intrinsics) {
+						Mat cameraMatrix = Mat::eye(3, 3, CV_64F);
+						cameraMatrix.at<double>(0, 0) = intrinsics[0];
+						cameraMatrix.at<double>(1, 1) = intrinsics[1];
+						cameraMatrix.at<double>(0, 2) = intrinsics[2];
+						cameraMatrix.at<double>(1, 2) = intrinsics[3];
+						return cameraMatrix;
+					}
+
+					static Mat getDistortionCoefficients(const double * intrinsics) {
+						return Mat(4, 1, CV_64F, (void *) (intrinsics + 4)).clone();
+					}
+
+					static void forEachView(size_t viewCount, const function<void(size_t)> & action, bool parallel) {
+						if (parallel) {
+							Utils::parallelFor(viewCount, [&action](size_t begin, size_t end) {
+								for (auto i = begin; i < end; i++) {
+									action(i);
+								}
+							}, 1);
+						}
+						else {
+							for (size_t i = 0; i < viewCount; i++) {
+								action(i);
+							}
+						}
+					}
+
+					void getBlocks(const BoardView & view, ViewBlocks & blocks) const {
+						//jacobian columns are rotation (3), translation (3), focal length (2), principal point (2), distortion (4)
+						vector<Point2f> projected;
+						Mat jacobian;
+						cv::projectPoints(this->objectPoints, view.rotation, view.translation, this->getCameraMatrix(), this->getDistortionCoefficients(), projected, jacobian);
+
+						const auto & imagePoints = *view.imagePoints;
+						Mat residuals(projected.size() * 2, 1, CV_64F);
+						for (size_t i = 0; i < projected.size(); i++) {
+							residuals.at<double>(i * 2 + 0) = projected[i].x - imagePoints[i].x;
+							residuals.at<double>(i * 2 + 1) = projected[i].y - imagePoints[i].y;
+						}
+
+						Mat pose = jacobian.colRange(0, 6);
+						Mat intrinsics = jacobian.colRange(6, 14);
+						for (int i = 0; i < 8; i++) {
+							if (this->fixed[i]) {
+								intrinsics.col(i).setTo(0.0);
+							}
+						}
+						blocks.A = intrinsics.t() * intrinsics;
+						blocks.B = intrinsics.t() * pose;
+						blocks.C = pose.t() * pose;
+						blocks.gi = intrinsics.t() * residuals;
+						blocks.ge = pose.t() * residuals;
+					}
+
+					double getViewCost(const double * intrinsics, const BoardView & view) const {
+						vector<Point2f> projected;
+						cv::projectPoints(this->objectPoints, view.rotation, view.translation, getCameraMatrix(intrinsics), getDistortionCoefficients(intrinsics), projected);
+						const auto & imagePoints = *view.imagePoints;
+						double cost = 0.0;
+						for (size_t i = 0; i < projected.size(); i++) {
+							const auto delta = projected[i] - imagePoints[i];
+							cost += delta.dot(delta);
+						}
+						return cost;
+					}
+
+					double getCost(const double * intrinsics, const vector<BoardView> & views, bool parallel) const {
+						vector<double> costs(views.size());
+						forEachView(views.size(), [&](size_t i) {
+							costs[i] = this->getViewCost(intrinsics, views[i]);
+						}, parallel);
+						return std::accumulate(costs.begin(), costs.end(), 0.0);
+					}
+
+					const vector<Point3f> & objectPoints;
+					double intrinsics[8];
+					bool fixed[8];
+					vector<BoardView> views;
+				};
+
+				//----------
+				//Poses a board against the intrinsics (starting from rotation and translation if they are set), and returns its RMS reprojection error [px]
+				float getBoardError(const vector<Point3f> & objectPoints, const vector<Point2f> & imagePoints, const Mat & cameraMatrix, const Mat & distortionCoefficients, Mat & rotation, Mat & translation) {
+					const auto useExtrinsicGuess = !rotation.empty() && !translation.empty();
+					cv::solvePnP(objectPoints, imagePoints, cameraMatrix, distortionCoefficients, rotation, translation, useExtrinsicGuess);
+
+					vector<Point2f> projected;
+					cv::projectPoints(objectPoints, rotation, translation, cameraMatrix, distortionCoefficients, projected);
+					double cost = 0.0;
+					for (size_t i = 0; i < projected.size(); i++) {
+						const auto delta = projected[i] - imagePoints[i];
+						cost += delta.dot(delta);
+					}
+					return sqrt(cost / (double) max<size_t>(projected.size(), 1));
+				}
+
+#pragma mark CameraIntrinsics
+				//----------
+				CameraIntrinsics::CameraIntrinsics() {
+					RULR_NODE_INIT_LISTENER;
+				}
+
+				//----------
+				void CameraIntrinsics::init() {
+					RULR_NODE_UPDATE_LISTENER;
+					RULR_NODE_SERIALIZATION_LISTENERS;
+					RULR_NODE_INSPECTOR_LISTENER;
+
+					this->addInput(MAKE(Pin<Item::Board>));
+					this->addInput(MAKE(Pin<Item::Camera>));
+
+					this->view = MAKE(ofxCvGui::Panels::Base);
+					this->view->onDraw += [this](DrawArguments & drawArgs) {
+						auto camera = this->getInput<Item::Camera>();
+						if (camera) {
+							auto grabber = camera->getGrabber();
+							if (this->grayscale.isAllocated()) {
+								this->grayscale.draw(drawArgs.localBounds);
+							}
+
+							ofPushMatrix();
+							{
+								ofScale(drawArgs.localBounds.getWidth() / camera->getWidth(), drawArgs.localBounds.getHeight() / camera->getHeight());
+
+								//draw current corners
+								ofxCv::drawCorners(this->currentCorners);
+
+								//draw past corners
+								ofPushStyle();
+								{
+									ofFill();
+									ofSetLineWidth(0.0f);
+									int boardIndex = 0;
+									ofColor boardColor(200, 100, 100);
+									for (auto & board : this->accumulatedCorners) {
+										boardColor.setHue(boardIndex * 30 % 360);
+										if (boardIndex < (int) this->viewResults.size() && this->viewResults[boardIndex].rejected) {
+											ofSetColor(100);
+										}
+										else {
+											ofSetColor(boardColor);
+										}
+										for (auto & corner : board) {
+											ofCircle(corner, 3.0f);
+										}
+
+										//per board error from the last calibration
+										if (boardIndex < (int) this->viewResults.size() && !board.empty()) {
+											ofDrawBitmapString(ofToString(this->viewResults[boardIndex].reprojectionError, 2) + "px", board.front());
+										}
+										boardIndex++;
+									}
+								}
+								ofPopStyle();
+							}
+							ofPopMatrix();
+
+							if (!this->isBeingInspected()) {
+								ofPushStyle(); 
+								{
+									ofSetColor(255, 100);
+									if (grabber->getDeviceSpecification().supports(ofxMachineVision::Feature::Feature_FreeRun)) {
+										ofxCvGui::Utils::drawText("Select node to enable board finder...", drawArgs.localBounds);
+									}
+								}
+								ofPopStyle();
+							}
+						}
+						
+					};
+
+					this->error.set("Reprojection error", 0.0f, 0.0f, std::numeric_limits<float>::max());
+
+					this->error = 0.0f;
+
+					this->incremental.set("Incremental", true);
+					this->rejectOutliers.set("Reject outlier boards", true);
+					this->outlierThreshold.set("Outlier threshold [x median]", 3.0f, 1.0f, 20.0f);
+
+					//Item::View stores k1, k2, p1, p2, so by default we fit all of those and nothing further
+					this->crossValidationFolds.set("Cross validation folds", 5, 2, 20);
+					this->lensModelFlags = CV_CALIB_FIX_K3 | CV_CALIB_FIX_K4 | CV_CALIB_FIX_K5 | CV_CALIB_FIX_K6;
+					this->lensModelName = "K1-K2, tangential";
+					this->lensModelCrossValidationError = 0.0f;
+				}
+
+				//----------
+				string CameraIntrinsics::getTypeName() const {
+					return "Procedure::Calibrate::CameraIntrinsics";
+				}
+
+				//----------
+				ofxCvGui::PanelPtr CameraIntrinsics::getView() {
+					return this->view;
+				}
+
+				//----------
+				void CameraIntrinsics::update() {
+					if (this->isBeingInspected()) {
+						auto camera = this->getInput<Item::Camera>();
+						if (camera) {
+							auto grabber = camera->getGrabber();
+							if (grabber->getDeviceSpecification().supports(ofxMachineVision::Feature::Feature_FreeRun)) {
+								try {
+									this->findBoard();
+								}
+								RULR_CATCH_ALL_TO_ERROR
+							}
+						}
+					}
+				}
+
+				//----------
+				void CameraIntrinsics::serialize(Json::Value & json) {
+					auto & jsonCorners = json["corners"];
+					for (int i = 0; i<this->accumulatedCorners.size(); i++) {
+						for (int j = 0; j<this->accumulatedCorners[i].size(); j++) {
+							jsonCorners[i][j]["x"] = accumulatedCorners[i][j].x;
+							jsonCorners[i][j]["y"] = accumulatedCorners[i][j].y;
+						}
+					}
+					Utils::Serializable::serialize(this->error, json);
+
+					auto & jsonViewResults = json["viewResults"];
+					for (int i = 0; i < this->viewResults.size(); i++) {
+						const auto & viewResult = this->viewResults[i];
+						auto & jsonViewResult = jsonViewResults[i];
+						jsonViewResult["reprojectionError"] = viewResult.reprojectionError;
+						jsonViewResult["heldOutError"] = viewResult.heldOutError;
+						jsonViewResult["rejected"] = viewResult.rejected;
+						if (!viewResult.rotation.empty() && !viewResult.translation.empty()) {
+							jsonViewResult["rotation"] << ofVec3f(viewResult.rotation.at<double>(0), viewResult.rotation.at<double>(1), viewResult.rotation.at<double>(2));
+							jsonViewResult["translation"] << ofVec3f(viewResult.translation.at<double>(0), viewResult.translation.at<double>(1), viewResult.translation.at<double>(2));
+						}
+					}
+
+					Utils::Serializable::serialize(this->incremental, json);
+					Utils::Serializable::serialize(this->rejectOutliers, json);
+					Utils::Serializable::serialize(this->outlierThreshold, json);
+
+					Utils::Serializable::serialize(this->crossValidationFolds, json);
+					auto & jsonLensModel = json["lensModel"];
+					jsonLensModel["flags"] = this->lensModelFlags;
+					jsonLensModel["name"] = this->lensModelName;
+					jsonLensModel["crossValidationError"] = this->lensModelCrossValidationError;
+				}
+
+				//----------
+				void CameraIntrinsics::deserialize(const Json::Value & json) {
+					this->accumulatedCorners.clear();
+
+					auto & jsonBoards = json["corners"];
+					for (auto & jsonBoard : jsonBoards) {
+						auto board = vector<ofVec2f>();
+						for (auto & jsonCorner : jsonBoard) {
+							board.push_back(ofVec2f(jsonCorner["x"].asFloat(), jsonCorner["y"].asFloat()));
+						}
+						this->accumulatedCorners.push_back(board);
+					}
+					Utils::Serializable::deserialize(this->error, json);
+
+					this->viewResults.clear();
+					for (const auto & jsonViewResult : json["viewResults"]) {
+						ViewResult viewResult;
+						viewResult.reprojectionError = jsonViewResult["reprojectionError"].asFloat();
+						viewResult.heldOutError = jsonViewResult["heldOutError"].asFloat();
+						viewResult.rejected = jsonViewResult["rejected"].asBool();
+						if (jsonViewResult.isMember("rotation") && jsonViewResult.isMember("translation")) {
+							ofVec3f rotation, translation;
+							jsonViewResult["rotation"] >> rotation;
+							jsonViewResult["translation"] >> translation;
+							viewResult.rotation = (Mat_<double>(3, 1) << rotation.x, rotation.y, rotation.z);
+							viewResult.translation = (Mat_<double>(3, 1) << translation.x, translation.y, translation.z);
+						}
+						this->viewResults.push_back(viewResult);
+					}
+					if (this->viewResults.size() > this->accumulatedCorners.size()) {
+						this->viewResults.clear();
+					}
+
+					Utils::Serializable::deserialize(this->incremental, json);
+					Utils::Serializable::deserialize(this->rejectOutliers, json);
+					Utils::Serializable::deserialize(this->outlierThreshold, json);
+
+					Utils::Serializable::deserialize(this->crossValidationFolds, json);
+					const auto & jsonLensModel = json["lensModel"];
+					if (jsonLensModel.isMember("flags")) {
+						this->lensModelFlags = jsonLensModel["flags"].asInt();
+						this->lensModelName = jsonLensModel["name"].asString();
+						this->lensModelCrossValidationError = jsonLensModel["crossValidationError"].asFloat();
+					}
+				}
+
+				//----------
+				void CameraIntrinsics::populateInspector(ofxCvGui::ElementGroupPtr inspector) {
+					inspector->add(Widgets::Indicator::make("Points found", [this]() {
+						return (Widgets::Indicator::Status) !this->currentCorners.empty();
+					}));
+					inspector->add(Widgets::LiveValue<string>::make("Last board search", [this]() -> string {
+						const auto squareSize = this->chessboardFinder.getLastSquareSize();
+						if (squareSize == 0.0f) {
+							return string("No board found");
+						}
+						auto level = this->chessboardFinder.getLastSearchLevel();
+						return "Level " + ofToString(level) + ", square " + ofToString(squareSize, 1) + "px";
+					}));
+					inspector->add(Widgets::LiveValue<int>::make("Calibration set count", [this]() {
+						return (int)accumulatedCorners.size();
+					}));
+					inspector->add(Widgets::Button::make("Add board to calibration set", [this]() {
+						auto camera = this->getInput<Item::Camera>();
+						if (camera) {
+							//if it's a DSLR, let's take a single shot and find the board
+							const auto cameraSpecification = camera->getGrabber()->getDeviceSpecification();
+							if (cameraSpecification.supports(ofxMachineVision::Feature::Feature_OneShot) && !cameraSpecification.supports(ofxMachineVision::Feature::Feature_FreeRun)) {
+								//by calling getFreshFrame(), the camera's latest frame is the one from this shot
+								camera->getFreshFrame();
+								this->findBoard();
+							}
+						}
+						if (this->currentCorners.empty()) {
+							Utils::playFailSound();
+						}
+						else {
+							Utils::playSuccessSound();
+							this->accumulatedCorners.push_back(currentCorners);
+						}
+					}, ' '));
+					inspector->add(Widgets::Button::make("Clear calibration set", [this]() {
+						this->accumulatedCorners.clear();
+						this->viewResults.clear();
+					}));
+
+					inspector->add(Widgets::Spacer::make());
+
+					auto calibrateButton = Widgets::Button::make("Calibrate", [this]() {
+						try {
+							this->calibrate();
+						}
+						RULR_CATCH_ALL_TO_ALERT
+					}, OF_KEY_RETURN);
+					calibrateButton->setHeight(100.0f);
+					inspector->add(calibrateButton);
+					inspector->add(Widgets::LiveValue<float>::make("Reprojection error [px]", [this]() {
+						return this->error;
+					}));
+					inspector->add(Widgets::LiveValue<string>::make("Worst board", [this]() -> string {
+						auto worst = std::max_element(this->viewResults.begin(), this->viewResults.end(), [](const ViewResult & a, const ViewResult & b) {
+							return (a.rejected ? 0.0f : a.reprojectionError) < (b.rejected ? 0.0f : b.reprojectionError);
+						});
+						if (worst == this->viewResults.end()) {
+							return "";
+						}
+						return "#" + ofToString(worst - this->viewResults.begin()) + " : " + ofToString(worst->reprojectionError, 3) + "px";
+					}));
+					inspector->add(Widgets::LiveValue<int>::make("Boards rejected", [this]() {
+						return (int) std::count_if(this->viewResults.begin(), this->viewResults.end(), [](const ViewResult & viewResult) {
+							return viewResult.rejected;
+						});
+					}));
+
+					inspector->add(Widgets::Spacer::make());
+					inspector->add(Widgets::Toggle::make(this->incremental));
+					inspector->add(Widgets::Toggle::make(this->rejectOutliers));
+					inspector->add(Widgets::Slider::make(this->outlierThreshold));
+
+					inspector->add(Widgets::Title::make("Lens model", Widgets::Title::Level::H3));
+					inspector->add(Widgets::EditableValue<int>::make(this->crossValidationFolds));
+					inspector->add(Widgets::Button::make("Select lens model", [this]() {
+						try {
+							this->selectLensModel();
+						}
+						RULR_CATCH_ALL_TO_ALERT
+					}));
+					inspector->add(Widgets::LiveValue<string>::make("Lens model", [this]() {
+						return this->lensModelName;
+					}));
+					inspector->add(Widgets::LiveValue<float>::make("Cross validation error [px]", [this]() {
+						return this->lensModelCrossValidationError;
+					}));
+				}
+
+				//----------
+				void CameraIntrinsics::findBoard() {
+					this->throwIfMissingAnyConnection();
+
+					auto camera = this->getInput<Item::Camera>();
+					auto board = this->getInput<Item::Board>();
+
+					//the grayscale conversion is shared with anything else looking at this frame
+					auto derivedFrame = camera->getDerivedFrame();
+					if (!derivedFrame) {
+						throw(Exception("Camera has no frame. Perhaps we need to wait for a frame?"));
+					}
+					auto grayscale = derivedFrame->getGrayscale();
+					this->grayscale.setFromPixels(grayscale.data, grayscale.cols, grayscale.rows, OF_IMAGE_GRAYSCALE); // for the preview
+					this->currentCorners.clear();
+
+					board->findBoard(grayscale, toCv(this->currentCorners), this->chessboardFinder);
+				}
+				
+				//----------
+				void CameraIntrinsics::calibrate() {
+					this->throwIfMissingAConnection<Item::Camera>();
+					this->throwIfMissingAConnection<Item::Board>();
+
+					if (this->accumulatedCorners.size() == 0) {
+						throw(ofxRulr::Exception("You need to add some board captures before trying to calibrate"));
+					}
+					auto camera = this->getInput<Item::Camera>();
+					auto board = this->getInput<Item::Board>();
+
+					const auto objectPoints = board->getObjectPoints();
+					const vector<vector<Point2f>> accumulatedCornersCv = toCv(this->accumulatedCorners);
+					const auto viewCount = accumulatedCornersCv.size();
+					for (size_t i = 0; i < viewCount; i++) {
+						if (accumulatedCornersCv[i].size() != objectPoints.size()) {
+							throw(ofxRulr::Exception("Board capture " + ofToString(i) + " has " + ofToString(accumulatedCornersCv[i].size()) + " corners, but the board has " + ofToString(objectPoints.size())));
+						}
+					}
+
+					//boards to fit. When warm starting, boards which were rejected last time stay out (they are tested again below)
+					const auto warmStart = this->incremental && !this->viewResults.empty() && this->viewResults.size() <= viewCount;
+					vector<size_t> fitViews;
+					for (size_t i = 0; i < viewCount; i++) {
+						if (!warmStart || !this->rejectOutliers || i >= this->viewResults.size() || !this->viewResults[i].rejected) {
+							fitViews.push_back(i);
+						}
+					}
+					if (fitViews.empty()) {
+						throw(ofxRulr::Exception("All board captures have been rejected. Clear the calibration set or disable incremental calibration"));
+					}
+
+					unique_ptr<IntrinsicsSolver> solver;
+					if (warmStart) {
+						//start from the current intrinsics and the poses of the last calibration. New boards are posed with solvePnP
+						solver = make_unique<IntrinsicsSolver>(objectPoints, camera->getCameraMatrix(), camera->getDistortionCoefficients(), this->lensModelFlags);
+						for (auto viewIndex : fitViews) {
+							if (viewIndex < this->viewResults.size()) {
+								solver->addView(accumulatedCornersCv[viewIndex], this->viewResults[viewIndex].rotation, this->viewResults[viewIndex].translation);
+							}
+							else {
+								solver->addView(accumulatedCornersCv[viewIndex]);
+							}
+						}
+						solver->solve(RULR_CAMERAINTRINSICS_ITERATIONS, true);
+					}
+					else {
+						auto objectPointsSet = vector<vector<Point3f>>(fitViews.size(), objectPoints);
+						vector<vector<Point2f>> imagePointsSet;
+						for (auto viewIndex : fitViews) {
+							imagePointsSet.push_back(accumulatedCornersCv[viewIndex]);
+						}
+						auto cameraResolution = cv::Size(camera->getWidth(), camera->getHeight());
+
+						Mat cameraMatrix = Mat::eye(3, 3, CV_64F);
+						Mat distortionCoefficients = Mat::zeros(8, 1, CV_64F);
+
+						vector<Mat> rotations, translations;
+						cv::calibrateCamera(objectPointsSet, imagePointsSet, cameraResolution, cameraMatrix, distortionCoefficients, rotations, translations, this->lensModelFlags);
+
+						solver = make_unique<IntrinsicsSolver>(objectPoints, cameraMatrix, distortionCoefficients, this->lensModelFlags);
+						for (size_t i = 0; i < fitViews.size(); i++) {
+							solver->addView(accumulatedCornersCv[fitViews[i]], rotations[i], translations[i]);
+						}
+					}
+
+					//leave one out : refit without each board in parallel, and reject boards which the others don't agree with
+					vector<float> heldOutErrors(viewCount, 0.0f);
+					vector<bool> rejected(viewCount, false);
+					if (this->rejectOutliers && fitViews.size() >= RULR_CAMERAINTRINSICS_MIN_LEAVE_ONE_OUT_VIEWS) {
+						//boards which weren't in the fit are already held out
+						vector<bool> isFitView(viewCount, false);
+						for (auto viewIndex : fitViews) {
+							isFitView[viewIndex] = true;
+						}
+						for (size_t viewIndex = 0; viewIndex < viewCount; viewIndex++) {
+							if (!isFitView[viewIndex]) {
+								Mat rotation, translation;
+								heldOutErrors[viewIndex] = getBoardError(objectPoints, accumulatedCornersCv[viewIndex], solver->getCameraMatrix(), solver->getDistortionCoefficients(), rotation, translation);
+							}
+						}
+
+						Utils::parallelFor(fitViews.size(), [&](size_t begin, size_t end) {
+							for (auto heldOut = begin; heldOut < end; heldOut++) {
+								IntrinsicsSolver leaveOneOut(objectPoints, solver->getCameraMatrix(), solver->getDistortionCoefficients(), this->lensModelFlags);
+								for (size_t i = 0; i < fitViews.size(); i++) {
+									if (i != heldOut) {
+										const auto & view = solver->getView(i);
+										leaveOneOut.addView(*view.imagePoints, view.rotation, view.translation);
+									}
+								}
+								leaveOneOut.solve(RULR_CAMERAINTRINSICS_LEAVE_ONE_OUT_ITERATIONS, false);
+
+								const auto & view = solver->getView(heldOut);
+								auto rotation = view.rotation.clone();
+								auto translation = view.translation.clone();
+								heldOutErrors[fitViews[heldOut]] = getBoardError(objectPoints, *view.imagePoints, leaveOneOut.getCameraMatrix(), leaveOneOut.getDistortionCoefficients(), rotation, translation);
+							}
+						}, 1);
+
+						//threshold relative to the median of the boards we fitted
+						vector<float> fitHeldOutErrors;
+						for (auto viewIndex : fitViews) {
+							fitHeldOutErrors.push_back(heldOutErrors[viewIndex]);
+						}
+						auto median = fitHeldOutErrors.begin() + fitHeldOutErrors.size() / 2;
+						std::nth_element(fitHeldOutErrors.begin(), median, fitHeldOutErrors.end());
+						const auto threshold = *median * this->outlierThreshold;
+
+						vector<size_t> acceptedViews;
+						for (size_t viewIndex = 0; viewIndex < viewCount; viewIndex++) {
+							rejected[viewIndex] = heldOutErrors[viewIndex] > threshold;
+							if (!rejected[viewIndex]) {
+								acceptedViews.push_back(viewIndex);
+							}
+						}
+
+						//refit if the set of boards has changed
+						if (acceptedViews != fitViews && !acceptedViews.empty()) {
+							auto refit = make_unique<IntrinsicsSolver>(objectPoints, solver->getCameraMatrix(), solver->getDistortionCoefficients(), this->lensModelFlags);
+							for (auto viewIndex : acceptedViews) {
+								auto fitIndex = std::find(fitViews.begin(), fitViews.end(), viewIndex);
+								if (fitIndex != fitViews.end()) {
+									const auto & view = solver->getView(fitIndex - fitViews.begin());
+									refit->addView(accumulatedCornersCv[viewIndex], view.rotation, view.translation);
+								}
+								else {
+									refit->addView(accumulatedCornersCv[viewIndex]);
+								}
+							}
+							refit->solve(RULR_CAMERAINTRINSICS_ITERATIONS, true);
+							solver = move(refit);
+							fitViews = acceptedViews;
+						}
+					}
+
+					//per board results. Rejected boards are posed against the final intrinsics so that they can be tested again next time
+					this->viewResults.resize(viewCount);
+					size_t fitIndex = 0;
+					for (size_t viewIndex = 0; viewIndex < viewCount; viewIndex++) {
+						auto & viewResult = this->viewResults[viewIndex];
+						if (fitIndex < fitViews.size() && fitViews[fitIndex] == viewIndex) {
+							const auto & view = solver->getView(fitIndex);
+							viewResult.reprojectionError = solver->getViewError(fitIndex);
+							viewResult.rotation = view.rotation.clone();
+							viewResult.translation = view.translation.clone();
+							fitIndex++;
+						}
+						else {
+							viewResult.reprojectionError = getBoardError(objectPoints, accumulatedCornersCv[viewIndex], solver->getCameraMatrix(), solver->getDistortionCoefficients(), viewResult.rotation, viewResult.translation);
+						}
+						viewResult.heldOutError = heldOutErrors[viewIndex];
+						viewResult.rejected = rejected[viewIndex];
+					}
+
+					this->error = solver->solve(0, false);
+					camera->setIntrinsics(solver->getCameraMatrix(), solver->getDistortionCoefficients());
+				}
+
+				//----------
+				void CameraIntrinsics::selectLensModel() {
+					this->throwIfMissingAConnection<Item::Camera>();
+					this->throwIfMissingAConnection<Item::Board>();
+
+					auto camera = this->getInput<Item::Camera>();
+					auto board = this->getInput<Item::Board>();
+
+					//use the boards which haven't been rejected
+					const auto objectPoints = board->getObjectPoints();
+					const vector<vector<Point2f>> accumulatedCornersCv = toCv(this->accumulatedCorners);
+					const auto viewCount = accumulatedCornersCv.size();
+					vector<size_t> fitViews;
+					vector<vector<Point2f>> imagePointsSet;
+					for (size_t i = 0; i < viewCount; i++) {
+						if (accumulatedCornersCv[i].size() != objectPoints.size()) {
+							throw(ofxRulr::Exception("Board capture " + ofToString(i) + " has " + ofToString(accumulatedCornersCv[i].size()) + " corners, but the board has " + ofToString(objectPoints.size())));
+						}
+						if (i >= this->viewResults.size() || !this->viewResults[i].rejected) {
+							fitViews.push_back(i);
+							imagePointsSet.push_back(accumulatedCornersCv[i]);
+						}
+					}
+					if (fitViews.size() < 2) {
+						throw(ofxRulr::Exception("You need at least 2 board captures to select a lens model"));
+					}
+					const auto objectPointsSet = vector<vector<Point3f>>(fitViews.size(), objectPoints);
+					const auto cameraResolution = cv::Size(camera->getWidth(), camera->getHeight());
+
+					auto results = Utils::LensModelSelection::select(objectPointsSet, imagePointsSet, cameraResolution, Mat::eye(3, 3, CV_64F), Mat(), 0, this->crossValidationFolds);
+					const auto & best = results.front();
+					if (!best.success) {
+						throw(ofxRulr::Exception("No lens model could be fitted : " + best.errorMessage));
+					}
+					for (const auto & result : results) {
+						ofLogNotice("CameraIntrinsics") << result.model.name << " : " << (result.success ? ofToString(result.crossValidationError) + "px" : result.errorMessage);
+					}
+
+					this->lensModelFlags = best.model.flags;
+					this->lensModelName = best.model.name;
+					this->lensModelCrossValidationError = best.crossValidationError;
+					camera->setIntrinsics(best.cameraMatrix, best.distortionCoefficients);
+
+					//keep the poses so that incremental calibration continues from this model
+					IntrinsicsSolver solver(objectPoints, best.cameraMatrix, best.distortionCoefficients, this->lensModelFlags);
+					for (size_t i = 0; i < fitViews.size(); i++) {
+						solver.addView(accumulatedCornersCv[fitViews[i]], best.rotations[i], best.translations[i]);
+					}
+					this->viewResults.resize(viewCount);
+					size_t fitIndex = 0;
+					for (size_t viewIndex = 0; viewIndex < viewCount; viewIndex++) {
+						auto & viewResult = this->viewResults[viewIndex];
+						if (fitIndex < fitViews.size() && fitViews[fitIndex] == viewIndex) {
+							viewResult.reprojectionError = solver.getViewError(fitIndex);
+							viewResult.rotation = best.rotations[fitIndex].clone();
+							viewResult.translation = best.translations[fitIndex].clone();
+							viewResult.heldOutError = 0.0f;
+							viewResult.rejected = false;
+							fitIndex++;
+						}
+						else {
+							viewResult.reprojectionError = getBoardError(objectPoints, accumulatedCornersCv[viewIndex], best.cameraMatrix, best.distortionCoefficients, viewResult.rotation, viewResult.translation);
+						}
+					}
+					this->error = best.fitError;
+				}
+			}
+		}
+	}
 }
\ No newline at end of file
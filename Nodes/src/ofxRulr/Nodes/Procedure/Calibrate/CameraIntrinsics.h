@@ -1,35 +1,57 @@
-#pragma once
-
-#include "../Base.h"
-#include "ofxCvMin.h"
-
-namespace ofxRulr {
-	namespace Nodes {
-		namespace Procedure {
-			namespace Calibrate {
-				class CameraIntrinsics : public Base {
-				public:
-					CameraIntrinsics();
-					void init();
-					string getTypeName() const override;
-					ofxCvGui::PanelPtr getView() override;
-					void update();
-
-					void serialize(Json::Value &);
-					void deserialize(const Json::Value &);
-				protected:
-					void populateInspector(ofxCvGui::ElementGroupPtr);
-					void findBoard();
-					void calibrate();
-
-					ofxCvGui::PanelPtr view;
-					ofImage grayscale;
-
-					vector<ofVec2f> currentCorners;
-					vector<vector<ofVec2f>> accumulatedCorners;
-					ofParameter<float> error;
-				};
-			}
-		}
-	}
+#pragma once
+
+#include "../Base.h"
+#include "ofxCvMin.h"
+
+#include "ofxRulr/Utils/ChessboardFinder.h"
+
+namespace ofxRulr {
+	namespace Nodes {
+		namespace Procedure {
+			namespace Calibrate {
+				class CameraIntrinsics : public Base {
+				public:
+					struct ViewResult {
+						float reprojectionError; // [px] RMS
+						float heldOutError; // [px] RMS when calibrated without this view, or 0 if not tested
+						bool rejected;
+						cv::Mat rotation; // board pose from the last calibration, used to warm start the next one
+						cv::Mat translation;
+					};
+
+					CameraIntrinsics();
+					void init();
+					string getTypeName() const override;
+					ofxCvGui::PanelPtr getView() override;
+					void update();
+
+					void serialize(Json::Value &);
+					void deserialize(const Json::Value &);
+				protected:
+					void populateInspector(ofxCvGui::ElementGroupPtr);
+					void findBoard();
+					void calibrate();
+					void selectLensModel();
+
+					ofxCvGui::PanelPtr view;
+					ofImage grayscale;
+
+					Utils::ChessboardFinder chessboardFinder; // for the camera's stream of frames
+					vector<ofVec2f> currentCorners;
+					vector<vector<ofVec2f>> accumulatedCorners;
+					vector<ViewResult> viewResults; // one per board in accumulatedCorners which has been calibrated
+					ofParameter<float> error;
+
+					ofParameter<bool> incremental;
+					ofParameter<bool> rejectOutliers;
+					ofParameter<float> outlierThreshold;
+
+					ofParameter<int> crossValidationFolds;
+					int lensModelFlags; // calibration flags of the lens model in use
+					string lensModelName;
+					float lensModelCrossValidationError;
+				};
+			}
+		}
+	}
 }
\ No newline at end of file
@@ -1,354 +1,1024 @@
-#include "HomographyFromGraycode.h"
-
-#include "ofxRulr/Exception.h"
-
-#include "../Scan/Graycode.h"
-#include "../../Item/Camera.h"
-#include "ofxCvMin.h"
-
-#include "ofxCvGui/Panels/Image.h"
-#include "ofxCvGui/Widgets/Button.h"
-
-#include "ofxNonLinearFit.h"
-
-using namespace ofxRulr::Nodes;
-using namespace ofxCvGui;
-using namespace ofxCv;
-
-namespace ofxRulr {
-	namespace Nodes {
-		namespace Procedure {
-			namespace Calibrate {
-				//----------
-				HomographyFromGraycode::HomographyFromGraycode() {
-					RULR_NODE_INIT_LISTENER;
-				}
-
-				//----------
-				void HomographyFromGraycode::init() {
-					RULR_NODE_UPDATE_LISTENER;
-					RULR_NODE_SERIALIZATION_LISTENERS;
-					RULR_NODE_INSPECTOR_LISTENER;
-
-					this->grid = ofMesh::plane(1.0f, 1.0f, 11.0f, 11.0f);
-					for (auto & vertex : grid.getVertices()) {
-						vertex += ofVec3f(0.5f, 0.5f, 0.0f);
-					}
-
-					this->addInput(MAKE(Graph::Pin<Scan::Graycode>));
-					this->addInput(MAKE(Graph::Pin<Item::Camera>));
-
-					auto view = MAKE(ofxCvGui::Panels::Image, this->dummy);
-					view->onDrawCropped += [this](ofxCvGui::Panels::BaseImage::DrawCroppedArguments & args) {
-						try {
-							auto graycodeNode = this->getInput<Scan::Graycode>();
-							if (graycodeNode) {
-								auto & dataSet = graycodeNode->getDataSet();
-								if (dataSet.getHasData()) {
-									ofPushMatrix();
-									graycodeNode->getDecoder().draw(0, 0);
-
-									ofMultMatrix(this->cameraToProjector.getInverse());
-									ofScale(dataSet.getPayloadWidth(), dataSet.getPayloadHeight());
-									ofPushStyle();
-									ofNoFill();
-									ofSetLineWidth(1.0f);
-									this->grid.drawWireframe();
-									ofPopStyle();
-									ofPopMatrix();
-								}
-							}
-						}
-						catch (...) {
-
-						}
-					};
-					this->view = view;
-
-					this->undistortFirst.set("Undistort first", false);
-					this->doubleExportSize.set("Double size of exported images", false);
-				}
-
-				//----------
-				string HomographyFromGraycode::getTypeName() const {
-					return "Procedure::Calibrate::HomographyFromGraycode";
-				}
-
-				//----------
-				ofxCvGui::PanelPtr HomographyFromGraycode::getView() {
-					return this->view;
-				}
-
-				//----------
-				void HomographyFromGraycode::update() {
-					auto graycodeNode = this->getInput<Scan::Graycode>();
-					if (graycodeNode) {
-						this->view->setImage(graycodeNode->getDecoder().getProjectorInCamera());
-					}
-				}
-
-				//----------
-				void HomographyFromGraycode::serialize(Json::Value & json) {
-					auto & jsonCameraToProjector = json["cameraToProjector"];
-					for (int j = 0; j < 4; j++) {
-						auto & jsonCameraToProjectorRow = jsonCameraToProjector[j];
-						for (int i = 0; i < 4; i++) {
-							jsonCameraToProjectorRow[i] = this->cameraToProjector(i, j);
-						}
-					}
-
-					try {
-						throwIfMissingAnyConnection();
-						auto graycodeNode = this->getInput<Scan::Graycode>();
-						auto & dataSet = graycodeNode->getDecoder().getDataSet();
-						if (!dataSet.getHasData()) {
-							throw(new Exception("No [ofxGraycode::DataSet] loaded"));
-						}
-						auto normalisedToCamera = ofMatrix4x4::newTranslationMatrix(1.0f, -1.0f, 1.0f) *
-							ofMatrix4x4::newScaleMatrix(0.5f, -0.5f, 1.0f) *
-							ofMatrix4x4::newScaleMatrix(dataSet.getWidth(), dataSet.getHeight(), 1.0f);
-						auto normaliseToProjector = ofMatrix4x4::newTranslationMatrix(1.0f, -1.0f, 1.0f) *
-							ofMatrix4x4::newScaleMatrix(0.5f, -0.5f, 1.0f) *
-							ofMatrix4x4::newScaleMatrix(dataSet.getPayloadWidth(), dataSet.getPayloadHeight(), 1.0f);
-						;
-
-						auto cameraNormalisedToProjectorNormalised = normalisedToCamera * this->cameraToProjector * normaliseToProjector.getInverse();
-						auto projectorNormalisedToCameraNormalised = cameraNormalisedToProjectorNormalised.getInverse();
-
-						auto & jsonCameraToProjectorNormalised = json["cameraNormalisedToProjectorNormalised"];
-						auto & jsonProjectorToCameraNormalised = json["projectorNormalisedToCameraNormalised"];
-						for (int j = 0; j < 4; j++) {
-							auto & jsonCameraToProjectorNormalisedRow = jsonCameraToProjectorNormalised[j];
-							auto & jsonProjectorToCameraNormalisedRow = jsonProjectorToCameraNormalised[j];
-							for (int i = 0; i < 4; i++) {
-								jsonCameraToProjectorNormalisedRow[i] = cameraNormalisedToProjectorNormalised(i, j);
-								jsonProjectorToCameraNormalisedRow[i] = projectorNormalisedToCameraNormalised(i, j);
-							}
-						}
-					}
-					catch (...)
-					{
-
-					}
-
-					Utils::Serializable::serialize(this->undistortFirst, json);
-					Utils::Serializable::serialize(this->doubleExportSize, json);
-				}
-
-				//----------
-				void HomographyFromGraycode::deserialize(const Json::Value & json) {
-					const auto & jsonCameraToProjector = json["cameraToProjector"];
-					for (int j = 0; j < 4; j++) {
-						const auto & jsonCameraToProjectorRow = jsonCameraToProjector[j];
-						for (int i = 0; i < 4; i++) {
-							this->cameraToProjector(i, j) = jsonCameraToProjectorRow[i].asFloat();
-						}
-					}
-
-					Utils::Serializable::deserialize(this->undistortFirst, json);
-					Utils::Serializable::deserialize(this->doubleExportSize, json);
-				}
-
-				//----------
-				void HomographyFromGraycode::findHomography() {
-					this->throwIfMissingAnyConnection();
-
-					auto graycodeNode = this->getInput<Scan::Graycode>();
-					auto & dataSet = graycodeNode->getDataSet();
-					if (!dataSet.getHasData()) {
-						throw(ofxRulr::Exception("No data loaded for [ofxGraycode::DataSet]"));
-					}
-
-					vector<ofVec2f> camera;
-					vector<ofVec2f> projector;
-
-					for (const auto & pixel : dataSet) {
-						if (pixel.active) {
-							camera.push_back(pixel.getCameraXY());
-							projector.push_back(pixel.getProjectorXY());
-						}
-					}
-
-					if (this->undistortFirst) {
-						this->throwIfMissingAConnection<Item::Camera>();
-						auto cameraNode = this->getInput<Item::Camera>();
-						camera = toOf(ofxCv::undistortPixelCoordinates(toCv(camera), cameraNode->getCameraMatrix(), cameraNode->getDistortionCoefficients()));
-					}
-
-					auto result = cv::findHomography(ofxCv::toCv(camera), ofxCv::toCv(projector), CV_LMEDS, 5.0);
-
-					this->cameraToProjector.set(
-						result.at<double>(0, 0), result.at<double>(1, 0), 0.0, result.at<double>(2, 0),
-						result.at<double>(0, 1), result.at<double>(1, 1), 0.0, result.at<double>(2, 1),
-						0.0, 0.0, 1.0, 0.0,
-						result.at<double>(0, 2), result.at<double>(1, 2), 0.0, result.at<double>(2, 2));
-				}
-
-				//----------
-				void HomographyFromGraycode::findDistortionCoefficients() {
-					struct DataPoint {
-					};
-
-					class Model : public ofxNonLinearFit::Models::Base<DataPoint, Model> {
-					public:
-						cv::Mat distortionCoefficients;
-						cv::Mat homography;
-
-						const vector<ofVec2f> & cameraDistorted;
-						vector<ofVec2f> cameraUndistorted;
-						const vector<ofVec2f> & projector;
-
-						Model(const vector<ofVec2f> & cameraDistorted, const vector<ofVec2f> & projector) :
-							cameraDistorted(cameraDistorted), projector(projector) {
-
-						}
-
-						unsigned int getParameterCount() const override {
-							return RULR_CAMERA_DISTORTION_COEFFICIENT_COUNT;
-						}
-
-						double getResidual(DataPoint point) const override {
-							return 0.0f;
-						}
-
-						void evaluate(DataPoint &) const override {
-							//do nothing
-						}
-
-						void cacheModel() {
-							/*which camera matrix?
-							cv::undistortPoints(toCv(this->cameraDistorted), toCv(this->cameraUndistorted), )
-							undistort the points
-							fit a homography
-							*/
-						}
-					};
-				}
-
-				//----------
-				void HomographyFromGraycode::exportMappingImage(string filename) const {
-					this->throwIfMissingAnyConnection();
-
-					auto graycodeNode = this->getInput<Scan::Graycode>();
-					auto & dataSet = graycodeNode->getDataSet();
-					if (!dataSet.getHasData()) {
-						throw(ofxRulr::Exception("No data loaded for [ofxGraycode::DataSet]"));
-					}
-
-					if (this->cameraToProjector.isIdentity()) {
-						throw(ofxRulr::Exception("No mapping has been found yet, so can't save"));
-					}
-
-					string filePath;
-					if (filename == "") {
-						auto filenameBase = ofFilePath::removeExt(dataSet.getFilename());
-						auto result = ofSystemSaveDialog(filenameBase + "-cameraToProjector.exr", "Save mapping image");
-						if (!result.bSuccess) {
-							return;
-						}
-						filePath = result.filePath;
-					}
-					else {
-						filePath = filename;
-					}
-
-					auto mappingGrid = this->grid;
-					mappingGrid.clearColors();
-					for (auto vertex : mappingGrid.getVertices()) {
-						ofFloatColor color;
-						(ofVec3f&)color = vertex;
-						color.a = 1.0f;
-						mappingGrid.addColor(color);
-					}
-
-					auto factor = this->doubleExportSize ? 2.0f : 1.0f;
-
-					//note that these settings can fail with older versions of openFrameworks,
-					// where ofGLUtils.cpp lacks GL_RGBA32F from the ofGetImageTypeFromGLType function
-					ofFbo mappingImage;
-					ofFbo::Settings settings;
-					settings.width = dataSet.getPayloadWidth() * factor;
-					settings.height = dataSet.getPayloadHeight() * factor;
-					settings.internalformat = GL_RGBA32F;
-					settings.numColorbuffers = 1;
-					mappingImage.allocate(settings);
-
-					mappingImage.begin();
-					ofClear(0, 0);
-
-					ofScale(factor, factor, 1.0f);
-
-					ofMultMatrix(this->cameraToProjector);
-					ofScale(dataSet.getWidth(), dataSet.getHeight());
-					ofPushStyle();
-					mappingGrid.drawFaces();
-					ofPopStyle();
-					ofPopMatrix();
-
-					mappingImage.end();
-
-					ofFloatImage saveImage;
-					mappingImage.readToPixels(saveImage.getPixelsRef());
-					saveImage.saveImage(filePath + ".exr");
-
-
-					//save matrix
-					ofstream fileOut;
-					fileOut.open(ofToDataPath(filePath + ".matrix").c_str(), ofstream::out | ofstream::binary);
-					fileOut.write((char*)&this->cameraToProjector, sizeof(this->cameraToProjector));
-					fileOut.close();
-
-					//save undistort
-					if (this->undistortFirst) {
-						this->throwIfMissingAConnection<Item::Camera>();
-						auto cameraNode = this->getInput<Item::Camera>();
-
-						auto cameraMatrix = cameraNode->getCameraMatrix();
-						auto distortionCoefficients = cameraNode->getDistortionCoefficients();
-						auto fx = cameraMatrix.at<double>(0, 0);
-						auto fy = cameraMatrix.at<double>(1, 1);
-						auto cx = cameraMatrix.at<double>(0, 2);
-						auto cy = cameraMatrix.at<double>(1, 2);
-						auto distortionVector = vector<double>(RULR_VIEW_DISTORTION_COEFFICIENT_COUNT);
-						for (int i = 0; i < distortionVector.size(); i++) {
-							distortionVector[i] = distortionCoefficients.at<double>(i);
-						}
-
-						ofstream fileOut;
-						fileOut.open(ofToDataPath(filePath + ".undistort").c_str(), ofstream::out | ofstream::binary);
-						fileOut.write((char*)&fx, sizeof(double));
-						fileOut.write((char*)&fy, sizeof(double));
-						fileOut.write((char*)&cx, sizeof(double));
-						fileOut.write((char*)&cy, sizeof(double));
-						for (int i = 0; i < distortionVector.size(); i++) {
-							fileOut.write((char*)&distortionVector[i], sizeof(double));
-						}
-						fileOut.close();
-					}
-				}
-
-				//----------
-				void HomographyFromGraycode::populateInspector(ofxCvGui::ElementGroupPtr inspector) {
-					auto findHomographyButton = MAKE(ofxCvGui::Widgets::Button, "Find Homography", [this]() {
-						try {
-							this->findHomography();
-						}
-						RULR_CATCH_ALL_TO_ALERT
-					}, OF_KEY_RETURN);
-					findHomographyButton->setHeight(100.0f);
-					inspector->add(findHomographyButton);
-
-					inspector->add(MAKE(ofxCvGui::Widgets::Button, "Export mapping image and matrix...", [this]() {
-						try {
-							this->exportMappingImage();
-						}
-						RULR_CATCH_ALL_TO_ALERT
-					}));
-
-					inspector->add(MAKE(ofxCvGui::Widgets::Toggle, this->undistortFirst));
-					inspector->add(MAKE(ofxCvGui::Widgets::Toggle, this->doubleExportSize));
-				}
-			}
-		}
-	}
-}
+#include "HomographyFromGraycode.h"
+
+#include "ofxRulr/Exception.h"
+#include "ofxRulr/Utils/ExrWriter.h"
+
+#include "../Scan/Graycode.h"
+#include "../../Item/Camera.h"
+#include "ofxCvMin.h"
+
+#include "ofxCvGui/Panels/Image.h"
+#include "ofxCvGui/Widgets/Button.h"
+
+#include <chrono>
+#include <mutex>
+
+using namespace ofxRulr::Nodes;
+using namespace ofxCvGui;
+using namespace ofxCv;
+
+namespace ofxRulr {
+	namespace Nodes {
+		namespace Procedure {
+			namespace Calibrate {
+				//----------
+				static inline ofVec2f transformPoint(const cv::Matx33d & homography, const ofVec2f & point) {
+					const auto & H = homography;
+					const auto w = H(2, 0) * point.x + H(2, 1) * point.y + H(2, 2);
+					return ofVec2f((H(0, 0) * point.x + H(0, 1) * point.y + H(0, 2)) / w,
+						(H(1, 0) * point.x + H(1, 1) * point.y + H(1, 2)) / w);
+				}
+
+				//----------
+				HomographyFromGraycode::HomographyFromGraycode() {
+					RULR_NODE_INIT_LISTENER;
+				}
+
+				//----------
+				void HomographyFromGraycode::init() {
+					RULR_NODE_UPDATE_LISTENER;
+					RULR_NODE_SERIALIZATION_LISTENERS;
+					RULR_NODE_INSPECTOR_LISTENER;
+
+					this->grid = ofMesh::plane(1.0f, 1.0f, 11.0f, 11.0f);
+					for (auto & vertex : grid.getVertices()) {
+						vertex += ofVec3f(0.5f, 0.5f, 0.0f);
+					}
+
+					this->addInput(MAKE(Graph::Pin<Scan::Graycode>));
+					this->addInput(MAKE(Graph::Pin<Item::Camera>));
+
+					auto view = MAKE(ofxCvGui::Panels::Image, this->dummy);
+					view->onDrawCropped += [this](ofxCvGui::Panels::BaseImage::DrawCroppedArguments & args) {
+						try {
+							auto graycodeNode = this->getInput<Scan::Graycode>();
+							//don't force a lazily loaded DataSet to be read just to draw the panel
+							if (graycodeNode && graycodeNode->getIsDataSetLoaded()) {
+								auto & dataSet = graycodeNode->getDataSet();
+								if (dataSet.getHasData()) {
+									ofPushMatrix();
+									auto cameraRoi = graycodeNode->getCameraRoi();
+									graycodeNode->getDecoder().draw(cameraRoi.x, cameraRoi.y);
+
+									ofMultMatrix(this->cameraToProjector.getInverse());
+									auto projectorSize = graycodeNode->getProjectorSize();
+									ofScale(projectorSize.x, projectorSize.y);
+									ofPushStyle();
+									ofNoFill();
+									ofSetLineWidth(1.0f);
+									this->grid.drawWireframe();
+									ofPopStyle();
+									ofPopMatrix();
+								}
+							}
+						}
+						catch (...) {
+
+						}
+					};
+					this->view = view;
+
+					this->undistortFirst.set("Undistort first", false);
+					this->doubleExportSize.set("Double size of exported images", false);
+					this->maxSamples.set("Max samples", 20000, 100, 1000000);
+					this->ransacIterations.set("RANSAC iterations", 2000, 10, 100000);
+					this->inlierThreshold.set("Inlier threshold [px]", 5.0f, 0.1f, 50.0f);
+					this->cpuExportScale.set("CPU export scale", 1.0f, 0.1f, 16.0f);
+					this->cpuExportBakeDistortion.set("CPU export bakes distortion", false);
+
+					memset(&this->fitStatistics, 0, sizeof(this->fitStatistics));
+					memset(&this->distortionFitStatistics, 0, sizeof(this->distortionFitStatistics));
+
+					this->fittedDataVersion = 0;
+				}
+
+				//----------
+				string HomographyFromGraycode::getTypeName() const {
+					return "Procedure::Calibrate::HomographyFromGraycode";
+				}
+
+				//----------
+				ofxCvGui::PanelPtr HomographyFromGraycode::getView() {
+					return this->view;
+				}
+
+				//----------
+				void HomographyFromGraycode::update() {
+					auto graycodeNode = this->getInput<Scan::Graycode>();
+					//don't force a lazily loaded DataSet to be read just for the preview
+					if (graycodeNode && graycodeNode->getIsDataSetLoaded()) {
+						this->view->setImage(graycodeNode->getDecoder().getProjectorInCamera());
+					}
+				}
+
+				//----------
+				void HomographyFromGraycode::serialize(Json::Value & json) {
+					auto & jsonCameraToProjector = json["cameraToProjector"];
+					for (int j = 0; j < 4; j++) {
+						auto & jsonCameraToProjectorRow = jsonCameraToProjector[j];
+						for (int i = 0; i < 4; i++) {
+							jsonCameraToProjectorRow[i] = this->cameraToProjector(i, j);
+						}
+					}
+
+					try {
+						throwIfMissingAnyConnection();
+						auto graycodeNode = this->getInput<Scan::Graycode>();
+						//don't force a lazily loaded DataSet to be read just to save the patch
+						if (!graycodeNode->hasData()) {
+							throw(new Exception("No [ofxGraycode::DataSet] loaded"));
+						}
+						auto cameraSize = graycodeNode->getCameraSize();
+						auto normalisedToCamera = ofMatrix4x4::newTranslationMatrix(1.0f, -1.0f, 1.0f) *
+							ofMatrix4x4::newScaleMatrix(0.5f, -0.5f, 1.0f) *
+							ofMatrix4x4::newScaleMatrix(cameraSize.x, cameraSize.y, 1.0f);
+						auto projectorSize = graycodeNode->getProjectorSize();
+						auto normaliseToProjector = ofMatrix4x4::newTranslationMatrix(1.0f, -1.0f, 1.0f) *
+							ofMatrix4x4::newScaleMatrix(0.5f, -0.5f, 1.0f) *
+							ofMatrix4x4::newScaleMatrix(projectorSize.x, projectorSize.y, 1.0f);
+						;
+
+						auto cameraNormalisedToProjectorNormalised = normalisedToCamera * this->cameraToProjector * normaliseToProjector.getInverse();
+						auto projectorNormalisedToCameraNormalised = cameraNormalisedToProjectorNormalised.getInverse();
+
+						auto & jsonCameraToProjectorNormalised = json["cameraNormalisedToProjectorNormalised"];
+						auto & jsonProjectorToCameraNormalised = json["projectorNormalisedToCameraNormalised"];
+						for (int j = 0; j < 4; j++) {
+							auto & jsonCameraToProjectorNormalisedRow = jsonCameraToProjectorNormalised[j];
+							auto & jsonProjectorToCameraNormalisedRow = jsonProjectorToCameraNormalised[j];
+							for (int i = 0; i < 4; i++) {
+								jsonCameraToProjectorNormalisedRow[i] = cameraNormalisedToProjectorNormalised(i, j);
+								jsonProjectorToCameraNormalisedRow[i] = projectorNormalisedToCameraNormalised(i, j);
+							}
+						}
+					}
+					catch (...)
+					{
+
+					}
+
+					Utils::Serializable::serialize(this->undistortFirst, json);
+					Utils::Serializable::serialize(this->doubleExportSize, json);
+					Utils::Serializable::serialize(this->maxSamples, json);
+					Utils::Serializable::serialize(this->ransacIterations, json);
+					Utils::Serializable::serialize(this->inlierThreshold, json);
+					Utils::Serializable::serialize(this->cpuExportScale, json);
+					Utils::Serializable::serialize(this->cpuExportBakeDistortion, json);
+				}
+
+				//----------
+				void HomographyFromGraycode::deserialize(const Json::Value & json) {
+					const auto & jsonCameraToProjector = json["cameraToProjector"];
+					for (int j = 0; j < 4; j++) {
+						const auto & jsonCameraToProjectorRow = jsonCameraToProjector[j];
+						for (int i = 0; i < 4; i++) {
+							this->cameraToProjector(i, j) = jsonCameraToProjectorRow[i].asFloat();
+						}
+					}
+
+					Utils::Serializable::deserialize(this->undistortFirst, json);
+					Utils::Serializable::deserialize(this->doubleExportSize, json);
+					Utils::Serializable::deserialize(this->maxSamples, json);
+					Utils::Serializable::deserialize(this->ransacIterations, json);
+					Utils::Serializable::deserialize(this->inlierThreshold, json);
+					Utils::Serializable::deserialize(this->cpuExportScale, json);
+					Utils::Serializable::deserialize(this->cpuExportBakeDistortion, json);
+
+					this->fittedDataVersion = 0;
+				}
+
+				//----------
+				void HomographyFromGraycode::findHomography() {
+					this->throwIfMissingAnyConnection();
+
+					auto graycodeNode = this->getInput<Scan::Graycode>();
+					if (!graycodeNode->hasData()) {
+						throw(ofxRulr::Exception("No data loaded for [ofxGraycode::DataSet]"));
+					}
+
+					const auto & correspondences = graycodeNode->getCorrespondences();
+					if (correspondences.size() < 4) {
+						throw(ofxRulr::Exception("Not enough active pixels in [ofxGraycode::DataSet] to find a homography"));
+					}
+					const auto & projector = correspondences.projectorXY;
+
+					ofxCvGui::Utils::drawProcessingNotice("Finding homography");
+
+					auto lapStart = chrono::high_resolution_clock::now();
+					auto lap = [&lapStart]() {
+						auto now = chrono::high_resolution_clock::now();
+						auto duration = chrono::duration_cast<chrono::microseconds>(now - lapStart).count();
+						lapStart = now;
+						return (float)duration / 1000.0f;
+					};
+
+					//undistort all camera points through the camera's cached lookup table
+					const vector<ofVec2f> * camera = &correspondences.cameraXY;
+					vector<ofVec2f> cameraUndistorted;
+					if (this->undistortFirst) {
+						this->throwIfMissingAConnection<Item::Camera>();
+						auto cameraNode = this->getInput<Item::Camera>();
+						cameraNode->undistortPoints(correspondences.cameraXY, cameraUndistorted);
+						camera = &cameraUndistorted;
+					}
+					this->fitStatistics.undistortDuration = lap();
+
+					auto samples = this->selectSamples(*camera, correspondences.contrast);
+					this->fitStatistics.sampleDuration = lap();
+
+					auto initial = this->findHomographyRansac(*camera, projector, samples);
+					this->fitStatistics.ransacDuration = lap();
+
+					auto result = this->refineHomography(*camera, projector, initial);
+					this->fitStatistics.refineDuration = lap();
+
+					this->fitStatistics.correspondenceCount = correspondences.size();
+					this->fitStatistics.sampleCount = samples.size();
+
+					this->cameraToProjector.set(
+						result(0, 0), result(1, 0), 0.0, result(2, 0),
+						result(0, 1), result(1, 1), 0.0, result(2, 1),
+						0.0, 0.0, 1.0, 0.0,
+						result(0, 2), result(1, 2), 0.0, result(2, 2));
+
+					this->fittedDataVersion = graycodeNode->getDataVersion();
+				}
+
+				//----------
+				void HomographyFromGraycode::findDistortionCoefficients() {
+					this->throwIfMissingAnyConnection();
+
+					auto graycodeNode = this->getInput<Scan::Graycode>();
+					auto cameraNode = this->getInput<Item::Camera>();
+					if (!graycodeNode->hasData()) {
+						throw(ofxRulr::Exception("No data loaded for [ofxGraycode::DataSet]"));
+					}
+					if (this->cameraToProjector.isIdentity()) {
+						throw(ofxRulr::Exception("Find the homography first. It is used as the starting point for the distortion fit."));
+					}
+
+					const auto & correspondences = graycodeNode->getCorrespondences();
+					const auto & camera = correspondences.cameraXY;
+					const auto & projector = correspondences.projectorXY;
+					const auto count = correspondences.size();
+
+					ofxCvGui::Utils::drawProcessingNotice("Finding distortion coefficients");
+					auto startTime = chrono::high_resolution_clock::now();
+
+					auto cameraMatrix = cameraNode->getCameraMatrix();
+					const auto fx = cameraMatrix.at<double>(0, 0);
+					const auto fy = cameraMatrix.at<double>(1, 1);
+					const auto cx = cameraMatrix.at<double>(0, 2);
+					const auto cy = cameraMatrix.at<double>(1, 2);
+
+					//parameters are the projector to undistorted camera homography (row major, last element fixed at 1), then k1, k2, p1, p2
+					const int parameterCount = 12;
+					typedef cv::Vec<double, parameterCount> Parameters;
+					typedef cv::Matx<double, parameterCount, parameterCount> NormalMatrix;
+					typedef cv::Matx<double, 2, parameterCount> Jacobian;
+
+					Parameters parameters;
+					{
+						auto projectorToCamera = this->getCameraToProjector().inv();
+						projectorToCamera *= 1.0 / projectorToCamera(2, 2);
+						for (int i = 0; i < 8; i++) {
+							parameters[i] = projectorToCamera.val[i];
+						}
+						if (this->undistortFirst) {
+							//the homography was found in undistorted space, so carry on from the current coefficients
+							auto distortionCoefficients = cameraNode->getDistortionCoefficients();
+							for (int i = 0; i < 4; i++) {
+								parameters[8 + i] = distortionCoefficients.at<double>(i);
+							}
+						}
+					}
+
+					//predicts the distorted camera pixel of a projector pixel, and optionally its derivatives
+					auto evaluate = [fx, fy, cx, cy](const Parameters & g, const ofVec2f & projectorXY, double & cameraX, double & cameraY, Jacobian * jacobian) {
+						const double u = projectorXY.x;
+						const double v = projectorXY.y;
+						const auto w = g[6] * u + g[7] * v + 1.0;
+						const auto X = (g[0] * u + g[1] * v + g[2]) / w;
+						const auto Y = (g[3] * u + g[4] * v + g[5]) / w;
+
+						const auto x = (X - cx) / fx;
+						const auto y = (Y - cy) / fy;
+						const auto k1 = g[8], k2 = g[9], p1 = g[10], p2 = g[11];
+						const auto r2 = x * x + y * y;
+						const auto radial = 1.0 + k1 * r2 + k2 * r2 * r2;
+						const auto xd = x * radial + 2.0 * p1 * x * y + p2 * (r2 + 2.0 * x * x);
+						const auto yd = y * radial + p1 * (r2 + 2.0 * y * y) + 2.0 * p2 * x * y;
+						cameraX = fx * xd + cx;
+						cameraY = fy * yd + cy;
+
+						if (jacobian) {
+							auto & J = *jacobian;
+
+							//d(xd, yd) / d(x, y)
+							const auto dRadial = k1 + 2.0 * k2 * r2;
+							const auto dxd_dx = radial + 2.0 * x * x * dRadial + 2.0 * p1 * y + 6.0 * p2 * x;
+							const auto dxd_dy = 2.0 * x * y * dRadial + 2.0 * p1 * x + 2.0 * p2 * y;
+							const auto dyd_dx = dxd_dy;
+							const auto dyd_dy = radial + 2.0 * y * y * dRadial + 6.0 * p1 * y + 2.0 * p2 * x;
+
+							//d(camera) / d(X, Y)
+							const auto a00 = dxd_dx;
+							const auto a01 = dxd_dy * fx / fy;
+							const auto a10 = dyd_dx * fy / fx;
+							const auto a11 = dyd_dy;
+
+							//d(X, Y) / d(homography)
+							const double dX[8] = { u / w, v / w, 1.0 / w, 0.0, 0.0, 0.0, -X * u / w, -X * v / w };
+							const double dY[8] = { 0.0, 0.0, 0.0, u / w, v / w, 1.0 / w, -Y * u / w, -Y * v / w };
+							for (int i = 0; i < 8; i++) {
+								J(0, i) = a00 * dX[i] + a01 * dY[i];
+								J(1, i) = a10 * dX[i] + a11 * dY[i];
+							}
+
+							//d(camera) / d(k1, k2, p1, p2)
+							J(0, 8) = fx * x * r2;
+							J(0, 9) = fx * x * r2 * r2;
+							J(0, 10) = fx * 2.0 * x * y;
+							J(0, 11) = fx * (r2 + 2.0 * x * x);
+							J(1, 8) = fy * y * r2;
+							J(1, 9) = fy * y * r2 * r2;
+							J(1, 10) = fy * (r2 + 2.0 * y * y);
+							J(1, 11) = fy * 2.0 * x * y;
+						}
+					};
+
+					std::mutex accumulateLock;
+					vector<uint8_t> isInlier(count, 0);
+					const auto thresholdSquared = this->inlierThreshold.get() * this->inlierThreshold.get();
+
+					auto findInliers = [&](const Parameters & parameters) {
+						size_t inlierCount = 0;
+						Utils::parallelFor(count, [&](size_t begin, size_t end) {
+							size_t localInlierCount = 0;
+							for (size_t i = begin; i < end; i++) {
+								double cameraX, cameraY;
+								evaluate(parameters, projector[i], cameraX, cameraY, nullptr);
+								const auto rx = cameraX - camera[i].x;
+								const auto ry = cameraY - camera[i].y;
+								isInlier[i] = rx * rx + ry * ry < thresholdSquared;
+								localInlierCount += isInlier[i];
+							}
+							std::lock_guard<std::mutex> lock(accumulateLock);
+							inlierCount += localInlierCount;
+						});
+						return inlierCount;
+					};
+
+					auto findCost = [&](const Parameters & parameters) {
+						double cost = 0.0;
+						Utils::parallelFor(count, [&](size_t begin, size_t end) {
+							double localCost = 0.0;
+							for (size_t i = begin; i < end; i++) {
+								if (isInlier[i]) {
+									double cameraX, cameraY;
+									evaluate(parameters, projector[i], cameraX, cameraY, nullptr);
+									const auto rx = cameraX - camera[i].x;
+									const auto ry = cameraY - camera[i].y;
+									localCost += rx * rx + ry * ry;
+								}
+							}
+							std::lock_guard<std::mutex> lock(accumulateLock);
+							cost += localCost;
+						});
+						return cost;
+					};
+
+					//accumulate J^T J and J^T r in parallel, returning the cost
+					auto accumulateNormalEquations = [&](const Parameters & parameters, NormalMatrix & JtJ, Parameters & Jtr) {
+						JtJ = NormalMatrix::zeros();
+						Jtr = Parameters::all(0.0);
+						double cost = 0.0;
+						Utils::parallelFor(count, [&](size_t begin, size_t end) {
+							NormalMatrix localJtJ = NormalMatrix::zeros();
+							Parameters localJtr = Parameters::all(0.0);
+							double localCost = 0.0;
+							Jacobian J;
+							for (size_t i = begin; i < end; i++) {
+								if (!isInlier[i]) {
+									continue;
+								}
+								double cameraX, cameraY;
+								evaluate(parameters, projector[i], cameraX, cameraY, &J);
+								const auto rx = cameraX - camera[i].x;
+								const auto ry = cameraY - camera[i].y;
+								localCost += rx * rx + ry * ry;
+								for (int j = 0; j < parameterCount; j++) {
+									localJtr[j] += J(0, j) * rx + J(1, j) * ry;
+									for (int k = j; k < parameterCount; k++) {
+										localJtJ(j, k) += J(0, j) * J(0, k) + J(1, j) * J(1, k);
+									}
+								}
+							}
+							std::lock_guard<std::mutex> lock(accumulateLock);
+							JtJ += localJtJ;
+							Jtr += localJtr;
+							cost += localCost;
+						});
+						for (int j = 0; j < parameterCount; j++) {
+							for (int k = 0; k < j; k++) {
+								JtJ(j, k) = JtJ(k, j);
+							}
+						}
+						return cost;
+					};
+
+					//Levenberg-Marquardt, re-selecting inliers once the distortion is known
+					unsigned int iterationCount = 0;
+					size_t inlierCount = 0;
+					double cost = 0.0;
+					for (int round = 0; round < 2; round++) {
+						inlierCount = findInliers(parameters);
+						if (inlierCount < parameterCount) {
+							throw(ofxRulr::Exception("Not enough inliers to find distortion coefficients. Check the inlier threshold."));
+						}
+
+						NormalMatrix JtJ;
+						Parameters Jtr;
+						cost = accumulateNormalEquations(parameters, JtJ, Jtr);
+						double lambda = 1e-3;
+
+						for (int iteration = 0; iteration < 100; iteration++) {
+							auto A = JtJ;
+							for (int j = 0; j < parameterCount; j++) {
+								A(j, j) += lambda * max(JtJ(j, j), 1e-12);
+							}
+							cv::Mat step;
+							if (!cv::solve(cv::Mat(A), cv::Mat(-Jtr), step, cv::DECOMP_CHOLESKY)) {
+								lambda *= 10.0;
+								continue;
+							}
+
+							Parameters candidate = parameters + Parameters(step);
+							auto candidateCost = findCost(candidate);
+							iterationCount++;
+
+							if (candidateCost < cost) {
+								const auto improvement = (cost - candidateCost) / cost;
+								parameters = candidate;
+								lambda = max(lambda / 10.0, 1e-12);
+								cost = accumulateNormalEquations(parameters, JtJ, Jtr);
+								if (improvement < 1e-10) {
+									break;
+								}
+							}
+							else {
+								lambda *= 10.0;
+								if (lambda > 1e12) {
+									break;
+								}
+							}
+						}
+					}
+
+					//camera to projector is the inverse of the fitted projector to undistorted camera homography
+					cv::Matx33d projectorToCamera(parameters[0], parameters[1], parameters[2],
+						parameters[3], parameters[4], parameters[5],
+						parameters[6], parameters[7], 1.0);
+					cv::Matx33d result = projectorToCamera.inv();
+					result *= 1.0 / result(2, 2);
+					this->cameraToProjector.set(
+						result(0, 0), result(1, 0), 0.0, result(2, 0),
+						result(0, 1), result(1, 1), 0.0, result(2, 1),
+						0.0, 0.0, 1.0, 0.0,
+						result(0, 2), result(1, 2), 0.0, result(2, 2));
+
+					cv::Mat distortionCoefficients = cv::Mat::zeros(RULR_VIEW_DISTORTION_COEFFICIENT_COUNT, 1, CV_64F);
+					for (int i = 0; i < 4; i++) {
+						distortionCoefficients.at<double>(i) = parameters[8 + i];
+					}
+					cameraNode->setIntrinsics(cameraMatrix, distortionCoefficients);
+					this->undistortFirst = true;
+					this->fittedDataVersion = graycodeNode->getDataVersion();
+
+					this->distortionFitStatistics.iterationCount = iterationCount;
+					this->distortionFitStatistics.inlierCount = inlierCount;
+					this->distortionFitStatistics.rmsError = (float)sqrt(cost / (double)inlierCount);
+					this->distortionFitStatistics.duration = (float)chrono::duration_cast<chrono::milliseconds>(chrono::high_resolution_clock::now() - startTime).count();
+				}
+
+				//----------
+				vector<size_t> HomographyFromGraycode::selectSamples(const vector<ofVec2f> & camera, const vector<uint8_t> & contrast) const {
+					const auto maxSamples = (size_t)max(this->maxSamples.get(), 4);
+					vector<size_t> samples;
+
+					if (camera.size() <= maxSamples) {
+						samples.resize(camera.size());
+						for (size_t i = 0; i < camera.size(); i++) {
+							samples[i] = i;
+						}
+						return samples;
+					}
+
+					//grid over the bounds of the camera points, with roughly square cells
+					ofVec2f minimum(std::numeric_limits<float>::max()), maximum(-std::numeric_limits<float>::max());
+					for (const auto & point : camera) {
+						minimum.x = min(minimum.x, point.x);
+						minimum.y = min(minimum.y, point.y);
+						maximum.x = max(maximum.x, point.x);
+						maximum.y = max(maximum.y, point.y);
+					}
+					const auto size = maximum - minimum + 1.0f;
+					const auto cellsX = max((int)sqrt((float)maxSamples * size.x / size.y), 1);
+					const auto cellsY = max((int)maxSamples / cellsX, 1);
+					const auto cellScale = ofVec2f((float)cellsX / size.x, (float)cellsY / size.y);
+
+					//keep the highest contrast point within each cell
+					const size_t noSample = std::numeric_limits<size_t>::max();
+					vector<size_t> cellSample(cellsX * cellsY, noSample);
+					for (size_t i = 0; i < camera.size(); i++) {
+						auto cell = (camera[i] - minimum) * cellScale;
+						auto cellIndex = min((int)cell.x, cellsX - 1) + min((int)cell.y, cellsY - 1) * cellsX;
+						auto & sample = cellSample[cellIndex];
+						if (sample == noSample || contrast[i] > contrast[sample]) {
+							sample = i;
+						}
+					}
+
+					for (auto sample : cellSample) {
+						if (sample != noSample) {
+							samples.push_back(sample);
+						}
+					}
+					return samples;
+				}
+
+				//----------
+				cv::Matx33d HomographyFromGraycode::findHomographyRansac(const vector<ofVec2f> & camera, const vector<ofVec2f> & projector, const vector<size_t> & samples) const {
+					if (samples.size() < 4) {
+						throw(ofxRulr::Exception("Not enough samples to find a homography"));
+					}
+
+					const auto thresholdSquared = this->inlierThreshold.get() * this->inlierThreshold.get();
+					const auto sampleCount = (int)samples.size();
+
+					std::mutex bestLock;
+					size_t bestInlierCount = 0;
+					double bestError = std::numeric_limits<double>::max();
+					cv::Matx33d best = cv::Matx33d::eye();
+
+					Utils::parallelFor(this->ransacIterations, [&](size_t begin, size_t end) {
+						size_t localInlierCount = 0;
+						double localError = std::numeric_limits<double>::max();
+						cv::Matx33d localBest;
+
+						for (size_t iteration = begin; iteration < end; iteration++) {
+							//seeded by iteration so that results don't depend on thread scheduling
+							cv::RNG random((uint64)iteration * 7919 + 1);
+							int picks[4];
+							cv::Point2f cameraPoints[4], projectorPoints[4];
+							for (int i = 0; i < 4; i++) {
+								do {
+									picks[i] = random.uniform(0, sampleCount);
+								} while (std::find(picks, picks + i, picks[i]) != picks + i);
+								cameraPoints[i] = toCv(camera[samples[picks[i]]]);
+								projectorPoints[i] = toCv(projector[samples[picks[i]]]);
+							}
+
+							cv::Matx33d hypothesis = cv::getPerspectiveTransform(cameraPoints, projectorPoints);
+							if (fabs(cv::determinant(hypothesis)) < 1e-12) {
+								continue;
+							}
+
+							size_t inlierCount = 0;
+							double error = 0.0;
+							for (auto sample : samples) {
+								auto residual = (transformPoint(hypothesis, camera[sample]) - projector[sample]).lengthSquared();
+								if (residual < thresholdSquared) {
+									inlierCount++;
+									error += residual;
+								}
+							}
+
+							if (inlierCount > localInlierCount || (inlierCount == localInlierCount && error < localError)) {
+								localInlierCount = inlierCount;
+								localError = error;
+								localBest = hypothesis;
+							}
+						}
+
+						std::lock_guard<std::mutex> lock(bestLock);
+						if (localInlierCount > bestInlierCount || (localInlierCount == bestInlierCount && localInlierCount > 0 && localError < bestError)) {
+							bestInlierCount = localInlierCount;
+							bestError = localError;
+							best = localBest;
+						}
+					}, 16);
+
+					if (bestInlierCount < 4) {
+						throw(ofxRulr::Exception("Couldn't find a homography with enough inliers. Check the inlier threshold."));
+					}
+					return best;
+				}
+
+				//----------
+				cv::Matx33d HomographyFromGraycode::refineHomography(const vector<ofVec2f> & camera, const vector<ofVec2f> & projector, const cv::Matx33d & initial) {
+					const auto thresholdSquared = this->inlierThreshold.get() * this->inlierThreshold.get();
+					const auto count = camera.size();
+					std::mutex accumulateLock;
+
+					//find inliers over all correspondences, and their centroids and spread for normalisation
+					vector<uint8_t> isInlier(count, 0);
+					size_t inlierCount = 0;
+					cv::Vec4d sum(0, 0, 0, 0), sumSquares(0, 0, 0, 0);
+					Utils::parallelFor(count, [&](size_t begin, size_t end) {
+						size_t localInlierCount = 0;
+						cv::Vec4d localSum(0, 0, 0, 0), localSumSquares(0, 0, 0, 0);
+						for (size_t i = begin; i < end; i++) {
+							if ((transformPoint(initial, camera[i]) - projector[i]).lengthSquared() < thresholdSquared) {
+								isInlier[i] = 1;
+								localInlierCount++;
+								cv::Vec4d point(camera[i].x, camera[i].y, projector[i].x, projector[i].y);
+								localSum += point;
+								localSumSquares += cv::Vec4d(point[0] * point[0], point[1] * point[1], point[2] * point[2], point[3] * point[3]);
+							}
+						}
+						std::lock_guard<std::mutex> lock(accumulateLock);
+						inlierCount += localInlierCount;
+						sum += localSum;
+						sumSquares += localSumSquares;
+					});
+					if (inlierCount < 4) {
+						throw(ofxRulr::Exception("Not enough inliers to refine the homography"));
+					}
+
+					const auto mean = sum * (1.0 / (double)inlierCount);
+					const auto meanSquares = sumSquares * (1.0 / (double)inlierCount);
+					const auto cameraSpread = sqrt(max(meanSquares[0] + meanSquares[1] - mean[0] * mean[0] - mean[1] * mean[1], 1e-12));
+					const auto projectorSpread = sqrt(max(meanSquares[2] + meanSquares[3] - mean[2] * mean[2] - mean[3] * mean[3], 1e-12));
+					const auto cameraScale = sqrt(2.0) / cameraSpread;
+					const auto projectorScale = sqrt(2.0) / projectorSpread;
+					const cv::Matx33d cameraNormalise(cameraScale, 0, -mean[0] * cameraScale,
+						0, cameraScale, -mean[1] * cameraScale,
+						0, 0, 1);
+					const cv::Matx33d projectorNormalise(projectorScale, 0, -mean[2] * projectorScale,
+						0, projectorScale, -mean[3] * projectorScale,
+						0, 0, 1);
+
+					//accumulate the normal equations of the DLT in parallel
+					typedef cv::Matx<double, 9, 9> NormalMatrix;
+					NormalMatrix normal = NormalMatrix::zeros();
+					Utils::parallelFor(count, [&](size_t begin, size_t end) {
+						NormalMatrix localNormal = NormalMatrix::zeros();
+						for (size_t i = begin; i < end; i++) {
+							if (!isInlier[i]) {
+								continue;
+							}
+							const auto x = (camera[i].x - mean[0]) * cameraScale;
+							const auto y = (camera[i].y - mean[1]) * cameraScale;
+							const auto u = (projector[i].x - mean[2]) * projectorScale;
+							const auto v = (projector[i].y - mean[3]) * projectorScale;
+							const double rows[2][9] = {
+								{ -x, -y, -1, 0, 0, 0, u * x, u * y, u },
+								{ 0, 0, 0, -x, -y, -1, v * x, v * y, v }
+							};
+							for (int r = 0; r < 2; r++) {
+								for (int j = 0; j < 9; j++) {
+									for (int k = j; k < 9; k++) {
+										localNormal(j, k) += rows[r][j] * rows[r][k];
+									}
+								}
+							}
+						}
+						std::lock_guard<std::mutex> lock(accumulateLock);
+						normal += localNormal;
+					});
+					for (int j = 0; j < 9; j++) {
+						for (int k = 0; k < j; k++) {
+							normal(j, k) = normal(k, j);
+						}
+					}
+
+					//solution is the eigenvector with the smallest eigenvalue (eigenvalues are sorted descending)
+					cv::Mat eigenvalues, eigenvectors;
+					cv::eigen(cv::Mat(normal), eigenvalues, eigenvectors);
+					cv::Matx33d normalisedHomography;
+					for (int i = 0; i < 9; i++) {
+						normalisedHomography.val[i] = eigenvectors.at<double>(8, i);
+					}
+					cv::Matx33d result = projectorNormalise.inv() * normalisedHomography * cameraNormalise;
+					result *= 1.0 / result(2, 2);
+
+					//report the residual over the inliers
+					double sumSquaredError = 0.0;
+					Utils::parallelFor(count, [&](size_t begin, size_t end) {
+						double localSumSquaredError = 0.0;
+						for (size_t i = begin; i < end; i++) {
+							if (isInlier[i]) {
+								localSumSquaredError += (transformPoint(result, camera[i]) - projector[i]).lengthSquared();
+							}
+						}
+						std::lock_guard<std::mutex> lock(accumulateLock);
+						sumSquaredError += localSumSquaredError;
+					});
+
+					this->fitStatistics.inlierCount = inlierCount;
+					this->fitStatistics.rmsError = (float)sqrt(sumSquaredError / (double)inlierCount);
+
+					return result;
+				}
+
+				//----------
+				void HomographyFromGraycode::exportMappingImage(string filename) const {
+					this->throwIfMissingAnyConnection();
+
+					auto graycodeNode = this->getInput<Scan::Graycode>();
+					auto & dataSet = graycodeNode->getDataSet();
+					if (!dataSet.getHasData()) {
+						throw(ofxRulr::Exception("No data loaded for [ofxGraycode::DataSet]"));
+					}
+
+					if (this->cameraToProjector.isIdentity()) {
+						throw(ofxRulr::Exception("No mapping has been found yet, so can't save"));
+					}
+
+					auto filePath = filename == "" ? this->getExportFilePath(ofFilePath::removeExt(dataSet.getFilename())) : filename;
+					if (filePath == "") {
+						return;
+					}
+
+					auto mappingGrid = this->grid;
+					mappingGrid.clearColors();
+					for (auto vertex : mappingGrid.getVertices()) {
+						ofFloatColor color;
+						(ofVec3f&)color = vertex;
+						color.a = 1.0f;
+						mappingGrid.addColor(color);
+					}
+
+					auto factor = this->doubleExportSize ? 2.0f : 1.0f;
+
+					//note that these settings can fail with older versions of openFrameworks,
+					// where ofGLUtils.cpp lacks GL_RGBA32F from the ofGetImageTypeFromGLType function
+					ofFbo mappingImage;
+					ofFbo::Settings settings;
+					auto projectorSize = graycodeNode->getProjectorSize();
+					settings.width = projectorSize.x * factor;
+					settings.height = projectorSize.y * factor;
+					settings.internalformat = GL_RGBA32F;
+					settings.numColorbuffers = 1;
+					mappingImage.allocate(settings);
+
+					mappingImage.begin();
+					ofClear(0, 0);
+
+					ofScale(factor, factor, 1.0f);
+
+					ofMultMatrix(this->cameraToProjector);
+					auto cameraSize = graycodeNode->getCameraSize();
+					ofScale(cameraSize.x, cameraSize.y);
+					ofPushStyle();
+					mappingGrid.drawFaces();
+					ofPopStyle();
+					ofPopMatrix();
+
+					mappingImage.end();
+
+					ofFloatImage saveImage;
+					mappingImage.readToPixels(saveImage.getPixelsRef());
+					saveImage.saveImage(filePath + ".exr");
+
+					this->saveMatrixAndUndistort(filePath, this->undistortFirst);
+				}
+
+				//----------
+				void HomographyFromGraycode::exportMappingImageCpu(string filename) const {
+					this->throwIfMissingAConnection<Scan::Graycode>();
+
+					auto graycodeNode = this->getInput<Scan::Graycode>();
+					if (this->cameraToProjector.isIdentity()) {
+						throw(ofxRulr::Exception("No mapping has been found yet, so can't save"));
+					}
+
+					auto filePath = filename == "" ? this->getExportFilePath(ofFilePath::removeExt(graycodeNode->getDefaultFilename())) : filename;
+					if (filePath == "") {
+						return;
+					}
+
+					//optionally map back into the distorted camera image, so that the result can be used without an undistort step
+					const auto bakeDistortion = this->undistortFirst && this->cpuExportBakeDistortion;
+					double fx = 1.0, fy = 1.0, cx = 0.0, cy = 0.0;
+					double k1 = 0.0, k2 = 0.0, p1 = 0.0, p2 = 0.0, k3 = 0.0;
+					if (bakeDistortion) {
+						this->throwIfMissingAConnection<Item::Camera>();
+						auto cameraNode = this->getInput<Item::Camera>();
+						auto cameraMatrix = cameraNode->getCameraMatrix();
+						auto distortionCoefficients = cameraNode->getDistortionCoefficients();
+						fx = cameraMatrix.at<double>(0, 0);
+						fy = cameraMatrix.at<double>(1, 1);
+						cx = cameraMatrix.at<double>(0, 2);
+						cy = cameraMatrix.at<double>(1, 2);
+						const auto coefficientCount = distortionCoefficients.total();
+						k1 = coefficientCount > 0 ? distortionCoefficients.at<double>(0) : 0.0;
+						k2 = coefficientCount > 1 ? distortionCoefficients.at<double>(1) : 0.0;
+						p1 = coefficientCount > 2 ? distortionCoefficients.at<double>(2) : 0.0;
+						p2 = coefficientCount > 3 ? distortionCoefficients.at<double>(3) : 0.0;
+						k3 = coefficientCount > 4 ? distortionCoefficients.at<double>(4) : 0.0;
+					}
+
+					const auto projectorToCamera = this->getCameraToProjector().inv();
+					const auto cameraSize = graycodeNode->getCameraSize();
+					const auto projectorSize = graycodeNode->getProjectorSize();
+					const auto scale = this->cpuExportScale.get();
+					const auto width = (int)ceil(projectorSize.x * scale);
+					const auto height = (int)ceil(projectorSize.y * scale);
+
+					Utils::ExrWriter writer;
+					writer.open(filePath + ".exr", width, height, 4);
+
+					//evaluate a band of rows in parallel, then stream it out whilst only holding that band in memory
+					const int bandHeight = 64;
+					vector<float> band(width * bandHeight * 4);
+					for (int bandStart = 0; bandStart < height; bandStart += bandHeight) {
+						const auto rowCount = min(bandHeight, height - bandStart);
+
+						stringstream message;
+						message << "Exporting mapping image " << bandStart << "/" << height;
+						ofxCvGui::Utils::drawProcessingNotice(message.str());
+
+						Utils::parallelFor(rowCount, [&](size_t begin, size_t end) {
+							for (size_t row = begin; row < end; row++) {
+								const auto y = bandStart + (int)row;
+								auto output = band.data() + row * width * 4;
+								for (int x = 0; x < width; x++, output += 4) {
+									//same pixel centre convention as the FBO export
+									auto projectorXY = ofVec2f(((float)x + 0.5f) / scale, ((float)y + 0.5f) / scale);
+									auto cameraXY = transformPoint(projectorToCamera, projectorXY);
+
+									if (bakeDistortion) {
+										const auto nx = (cameraXY.x - cx) / fx;
+										const auto ny = (cameraXY.y - cy) / fy;
+										const auto r2 = nx * nx + ny * ny;
+										const auto radial = 1.0 + r2 * (k1 + r2 * (k2 + r2 * k3));
+										const auto dx = nx * radial + 2.0 * p1 * nx * ny + p2 * (r2 + 2.0 * nx * nx);
+										const auto dy = ny * radial + p1 * (r2 + 2.0 * ny * ny) + 2.0 * p2 * nx * ny;
+										cameraXY = ofVec2f(dx * fx + cx, dy * fy + cy);
+									}
+
+									if (cameraXY.x >= 0.0f && cameraXY.y >= 0.0f && cameraXY.x <= cameraSize.x && cameraXY.y <= cameraSize.y) {
+										output[0] = cameraXY.x / cameraSize.x;
+										output[1] = cameraXY.y / cameraSize.y;
+										output[2] = 0.0f;
+										output[3] = 1.0f;
+									}
+									else {
+										output[0] = output[1] = output[2] = output[3] = 0.0f;
+									}
+								}
+							}
+						}, 1);
+
+						writer.writeRows(band.data(), rowCount);
+					}
+					writer.close();
+
+					this->saveMatrixAndUndistort(filePath, this->undistortFirst && !bakeDistortion);
+				}
+
+				//----------
+				cv::Matx33d HomographyFromGraycode::getCameraToProjector() const {
+					//cameraToProjector is stored for ofMultMatrix, i.e. transposed, with z skipped
+					const int index[3] = { 0, 1, 3 };
+					cv::Matx33d homography;
+					for (int i = 0; i < 3; i++) {
+						for (int j = 0; j < 3; j++) {
+							homography(i, j) = this->cameraToProjector(index[j], index[i]);
+						}
+					}
+					return homography;
+				}
+
+				//----------
+				string HomographyFromGraycode::getExportFilePath(const string & defaultFilenameBase) const {
+					auto result = ofSystemSaveDialog(defaultFilenameBase + "-cameraToProjector.exr", "Save mapping image");
+					if (!result.bSuccess) {
+						return "";
+					}
+					return result.filePath;
+				}
+
+				//----------
+				void HomographyFromGraycode::saveMatrixAndUndistort(const string & filePath, bool saveUndistort) const {
+					//save matrix
+					ofstream fileOut;
+					fileOut.open(ofToDataPath(filePath + ".matrix").c_str(), ofstream::out | ofstream::binary);
+					fileOut.write((char*)&this->cameraToProjector, sizeof(this->cameraToProjector));
+					fileOut.close();
+
+					//save undistort
+					if (saveUndistort) {
+						this->throwIfMissingAConnection<Item::Camera>();
+						auto cameraNode = this->getInput<Item::Camera>();
+
+						auto cameraMatrix = cameraNode->getCameraMatrix();
+						auto distortionCoefficients = cameraNode->getDistortionCoefficients();
+						auto fx = cameraMatrix.at<double>(0, 0);
+						auto fy = cameraMatrix.at<double>(1, 1);
+						auto cx = cameraMatrix.at<double>(0, 2);
+						auto cy = cameraMatrix.at<double>(1, 2);
+						auto distortionVector = vector<double>(RULR_VIEW_DISTORTION_COEFFICIENT_COUNT);
+						for (int i = 0; i < distortionVector.size(); i++) {
+							distortionVector[i] = distortionCoefficients.at<double>(i);
+						}
+
+						ofstream fileOut;
+						fileOut.open(ofToDataPath(filePath + ".undistort").c_str(), ofstream::out | ofstream::binary);
+						fileOut.write((char*)&fx, sizeof(double));
+						fileOut.write((char*)&fy, sizeof(double));
+						fileOut.write((char*)&cx, sizeof(double));
+						fileOut.write((char*)&cy, sizeof(double));
+						for (int i = 0; i < distortionVector.size(); i++) {
+							fileOut.write((char*)&distortionVector[i], sizeof(double));
+						}
+						fileOut.close();
+					}
+				}
+
+				//----------
+				void HomographyFromGraycode::populateInspector(ofxCvGui::ElementGroupPtr inspector) {
+					auto findHomographyButton = MAKE(ofxCvGui::Widgets::Button, "Find Homography", [this]() {
+						try {
+							this->findHomography();
+						}
+						RULR_CATCH_ALL_TO_ALERT
+					}, OF_KEY_RETURN);
+					findHomographyButton->setHeight(100.0f);
+					inspector->add(findHomographyButton);
+					inspector->add(MAKE(ofxCvGui::Widgets::LiveValue<string>, "Homography", [this]() -> string {
+						auto graycodeNode = this->getInput<Scan::Graycode>();
+						if (this->cameraToProjector.isIdentity()) {
+							return "Not found";
+						}
+						else if (graycodeNode && this->fittedDataVersion != 0 && graycodeNode->getDataVersion() != this->fittedDataVersion) {
+							return "Scan data has changed since fit";
+						}
+						else {
+							return "Up to date";
+						}
+					}));
+
+					inspector->add(MAKE(ofxCvGui::Widgets::Button, "Find distortion coefficients", [this]() {
+						try {
+							this->findDistortionCoefficients();
+						}
+						RULR_CATCH_ALL_TO_ALERT
+					}));
+					inspector->add(MAKE(ofxCvGui::Widgets::LiveValue<string>, "Distortion fit", [this]() {
+						const auto & statistics = this->distortionFitStatistics;
+						stringstream message;
+						message << statistics.rmsError << "px RMS, " << statistics.inlierCount << " inliers, "
+							<< statistics.iterationCount << " iterations, " << (int)statistics.duration << "ms";
+						return message.str();
+					}));
+
+					inspector->add(MAKE(ofxCvGui::Widgets::Button, "Export mapping image and matrix...", [this]() {
+						try {
+							this->exportMappingImage();
+						}
+						RULR_CATCH_ALL_TO_ALERT
+					}));
+
+					inspector->add(MAKE(ofxCvGui::Widgets::Button, "Export mapping image and matrix (CPU)...", [this]() {
+						try {
+							this->exportMappingImageCpu();
+						}
+						RULR_CATCH_ALL_TO_ALERT
+					}));
+
+					inspector->add(MAKE(ofxCvGui::Widgets::Toggle, this->undistortFirst));
+					inspector->add(MAKE(ofxCvGui::Widgets::Toggle, this->doubleExportSize));
+					inspector->add(MAKE(ofxCvGui::Widgets::Slider, this->cpuExportScale));
+					inspector->add(MAKE(ofxCvGui::Widgets::Toggle, this->cpuExportBakeDistortion));
+
+					inspector->add(MAKE(ofxCvGui::Widgets::Title, "Robust fit", ofxCvGui::Widgets::Title::Level::H2));
+					inspector->add(MAKE(ofxCvGui::Widgets::EditableValue<int>, this->maxSamples));
+					inspector->add(MAKE(ofxCvGui::Widgets::EditableValue<int>, this->ransacIterations));
+					inspector->add(MAKE(ofxCvGui::Widgets::Slider, this->inlierThreshold));
+					inspector->add(MAKE(ofxCvGui::Widgets::LiveValue<int>, "Threads", []() {
+						return Utils::getThreadCount();
+					}));
+					inspector->add(MAKE(ofxCvGui::Widgets::LiveValue<string>, "Inliers / samples / total", [this]() {
+						const auto & statistics = this->fitStatistics;
+						stringstream message;
+						message << statistics.inlierCount << " / " << statistics.sampleCount << " / " << statistics.correspondenceCount;
+						return message.str();
+					}));
+					inspector->add(MAKE(ofxCvGui::Widgets::LiveValue<float>, "RMS error [px]", [this]() {
+						return this->fitStatistics.rmsError;
+					}));
+					inspector->add(MAKE(ofxCvGui::Widgets::LiveValue<string>, "Undistort / sample / RANSAC / refine [ms]", [this]() {
+						const auto & statistics = this->fitStatistics;
+						stringstream message;
+						message << (int)statistics.undistortDuration << " / " << (int)statistics.sampleDuration << " / "
+							<< (int)statistics.ransacDuration << " / " << (int)statistics.refineDuration;
+						return message.str();
+					}));
+				}
+			}
+		}
+	}
+}
@@ -1,40 +1,84 @@
-#pragma once
-
-#include "../Base.h"
-
-#include "ofxCvGui/Panels/Image.h"
-
-namespace ofxRulr {
-	namespace Nodes {
-		namespace Procedure {
-			namespace Calibrate {
-				class HomographyFromGraycode : public Procedure::Base {
-				public:
-					HomographyFromGraycode();
-					void init();
-					string getTypeName() const override;
-					ofxCvGui::PanelPtr getView() override;
-					void update();
-
-					void serialize(Json::Value &);
-					void deserialize(const Json::Value &);
-
-					void findHomography();
-					void findDistortionCoefficients();
-					void exportMappingImage(string filename = "") const;
-				protected:
-					void populateInspector(ofxCvGui::ElementGroupPtr);
-
-					shared_ptr<ofxCvGui::Panels::Image> view;
-
-					ofMatrix4x4 cameraToProjector;
-					ofMesh grid;
-					ofImage dummy;
-
-					ofParameter<bool> undistortFirst;
-					ofParameter<bool> doubleExportSize;
-				};
-			}
-		}
-	}
+#pragma once
+
+#include "../Base.h"
+
+#include "ofxCvGui/Panels/Image.h"
+
+#include <opencv2/core/core.hpp>
+
+namespace ofxRulr {
+	namespace Nodes {
+		namespace Procedure {
+			namespace Calibrate {
+				class HomographyFromGraycode : public Procedure::Base {
+				public:
+					HomographyFromGraycode();
+					void init();
+					string getTypeName() const override;
+					ofxCvGui::PanelPtr getView() override;
+					void update();
+
+					void serialize(Json::Value &);
+					void deserialize(const Json::Value &);
+
+					void findHomography();
+					void findDistortionCoefficients();
+					void exportMappingImage(string filename = "") const;
+					///Evaluates the mapping per pixel on the CPU and streams it to disk, so it doesn't need a GL context and isn't limited by FBO size
+					void exportMappingImageCpu(string filename = "") const;
+
+					///Homography from camera pixels to projector pixels
+					cv::Matx33d getCameraToProjector() const;
+				protected:
+					void populateInspector(ofxCvGui::ElementGroupPtr);
+
+					///Keeps the highest contrast correspondence in each cell of a grid over the camera image
+					vector<size_t> selectSamples(const vector<ofVec2f> & camera, const vector<uint8_t> & contrast) const;
+					///Evaluates random 4 point hypotheses against the samples in parallel, returning the one with most inliers
+					cv::Matx33d findHomographyRansac(const vector<ofVec2f> & camera, const vector<ofVec2f> & projector, const vector<size_t> & samples) const;
+					///Least squares fit (normalised DLT) over all inliers of the initial homography
+					cv::Matx33d refineHomography(const vector<ofVec2f> & camera, const vector<ofVec2f> & projector, const cv::Matx33d & initial);
+
+					string getExportFilePath(const string & defaultFilenameBase) const;
+					void saveMatrixAndUndistort(const string & filePath, bool saveUndistort) const;
+
+					shared_ptr<ofxCvGui::Panels::Image> view;
+
+					ofMatrix4x4 cameraToProjector;
+					ofMesh grid;
+					ofImage dummy;
+
+					ofParameter<bool> undistortFirst;
+					ofParameter<bool> doubleExportSize;
+					ofParameter<float> cpuExportScale;
+					ofParameter<bool> cpuExportBakeDistortion;
+					ofParameter<int> maxSamples;
+					ofParameter<int> ransacIterations;
+					ofParameter<float> inlierThreshold;
+
+					struct {
+						size_t correspondenceCount;
+						size_t sampleCount;
+						size_t inlierCount;
+						float rmsError;
+
+						// [ms]
+						float undistortDuration;
+						float sampleDuration;
+						float ransacDuration;
+						float refineDuration;
+					} fitStatistics;
+
+					struct {
+						unsigned int iterationCount;
+						size_t inlierCount;
+						float rmsError;
+						float duration; // [ms]
+					} distortionFitStatistics;
+
+					unsigned int fittedDataVersion; // Graycode data version which the current homography was found from, 0 if it was loaded from file
+				};
+			}
+		}
+	}
 }
\ No newline at end of file
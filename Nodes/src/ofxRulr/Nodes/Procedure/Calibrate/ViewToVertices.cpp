@@ -1,460 +1,696 @@
-#include "ViewToVertices.h"
-
-#include "../../Item/View.h"
-#include "../../Device/VideoOutput.h"
-#include "IReferenceVertices.h"
-
-#include "ofxCvGui/Widgets/SelectFile.h"
-#include "ofxCvGui/Widgets/Indicator.h"
-#include "ofxCvGui/Widgets/Button.h"
-#include "../../../addons/ofxSpinCursor/src/ofxSpinCursor.h"
-
-#include "ofxCvMin.h"
-
-using namespace ofxCvGui;
-using namespace ofxCv;
-using namespace ofxRulr::Nodes;
-
-namespace ofxRulr {
-	namespace Nodes {
-		namespace Procedure {
-			namespace Calibrate {
-#pragma mark ViewArea
-				//---------
-				ViewToVertices::ViewArea::ViewArea(ViewToVertices & parent) : parent(parent) {
-
-				}
-
-				//---------
-				void ViewToVertices::ViewArea::draw(float x, float y) const {
-					this->draw(x, y, this->getWidth(), this->getHeight());
-				}
-
-				//---------
-				void ViewToVertices::ViewArea::draw(float x, float y, float w, float h) const {
-					if (this->parent.projectorReferenceImage.isAllocated()) {
-						this->parent.projectorReferenceImage.draw(x, y, w, h);
-					}
-				}
-
-				//---------
-				float ViewToVertices::ViewArea::getHeight() const {
-					auto view = this->parent.getInput<Item::View>();
-					if (view) {
-						return view->getHeight();
-					}
-					else {
-						return 1;
-					}
-				}
-
-				//---------
-				float ViewToVertices::ViewArea::getWidth() const {
-					auto view = this->parent.getInput<Item::View>();
-					if (view) {
-						return view->getWidth();
-					}
-					else {
-						return 1;
-					}
-				}
-
-#pragma mark ViewToVertices
-				//---------
-				ViewToVertices::ViewToVertices() : viewArea(*this) {
-					RULR_NODE_INIT_LISTENER;
-				}
-
-				//---------
-				string ViewToVertices::getTypeName() const {
-					return "Procedure::Calibrate::ViewToVertices";
-				}
-
-				//---------
-				void ViewToVertices::init() {
-					RULR_NODE_UPDATE_LISTENER;
-					RULR_NODE_SERIALIZATION_LISTENERS;
-					RULR_NODE_INSPECTOR_LISTENER;
-
-					this->addInput<Item::View>();
-					auto videoOutputPin = this->addInput<Device::VideoOutput>();
-					auto referenceVerticesPin = this->addInput<IReferenceVertices>();
-
-					auto view = make_shared<Panels::Draws>(this->viewArea);
-					auto viewWeak = weak_ptr<Panels::Draws>(view);
-					view->onDrawCropped += [this](Panels::Draws::DrawCroppedArguments & args) {
-						//draw a label at each vertex
-						auto referenceVertices = this->getInput<IReferenceVertices>();
-						if (!referenceVertices) {
-							return;
-						}
-						auto scaleDrawToScreenFactor = args.drawSize / args.viewSize;
-
-						ofPushMatrix();
-						const auto & vertices = referenceVertices->getVertices();
-						int index = 0;
-						for (auto vertex : vertices) {
-							ofPushMatrix();
-							ofTranslate(vertex->viewPosition);
-
-							//text label
-							ofDrawBitmapString(ofToString(index++), 0, 0);
-
-							//cross
-							ofPushStyle();
-							ofScale(scaleDrawToScreenFactor.x, scaleDrawToScreenFactor.y);
-							//surround
-							ofSetLineWidth(3.0f);
-							ofSetColor(0);
-							ofLine(-10, 0, 10, 0);
-							ofLine(0, -10, 0, 10);
-							//inner
-							ofSetLineWidth(1.0f);
-							ofSetColor(vertex->isSelected() ? ofxCvGui::Utils::getBeatingSelectionColor() : ofColor(100));
-							ofLine(-10, 0, 10, 0);
-							ofLine(0, -10, 0, 10);
-							ofPopStyle();
-
-							ofPopMatrix();
-						}
-						ofPopMatrix();
-					};
-					view->onMouse += [this, viewWeak](ofxCvGui::MouseArguments & args) {
-						auto view = viewWeak.lock();
-						args.takeMousePress(view);
-
-						//if the mouse is dragging then move the vertex in view space
-						if (args.isDragging(view) && this->dragVerticesEnabled) {
-							auto referenceVertices = this->getInput<IReferenceVertices>();
-							if (referenceVertices) {
-								const auto & vertices = referenceVertices->getVertices();
-								for (auto vertex : vertices) {
-									if (vertex->isSelected()) {
-										auto multiplier = 0.5f;
-										if (ofGetKeyPressed(OF_KEY_SHIFT)) {
-											multiplier /= 5.0f;
-										}
-										vertex->viewPosition += args.movement * multiplier;
-										referenceVertices->onChangeVertex.notifyListeners();
-									}
-								}
-							}
-						}
-					};
-					view->onKeyboard += [this](ofxCvGui::KeyboardArguments & args) {
-						if (args.action == KeyboardArguments::Action::Pressed) {
-							ofVec2f movement;
-							switch (args.key) {
-							case OF_KEY_LEFT:
-								movement.x = -1;
-								break;
-							case OF_KEY_RIGHT:
-								movement.x = +1;
-								break;
-							case OF_KEY_UP:
-								movement.y = -1;
-								break;
-							case OF_KEY_DOWN:
-								movement.y = +1;
-								break;
-							default:
-								break;
-							}
-
-							if (movement != ofVec2f() && this->dragVerticesEnabled) {
-								if (ofGetKeyPressed(OF_KEY_SHIFT)) {
-									movement *= 5;
-								}
-								auto referenceVertices = this->getInput<IReferenceVertices>();
-								if (referenceVertices) {
-									const auto & vertices = referenceVertices->getVertices();
-									for (auto vertex : vertices) {
-										if (vertex->isSelected()) {
-											vertex->viewPosition += movement;
-											referenceVertices->onChangeVertex.notifyListeners();
-										}
-									}
-								}
-							}
-						}
-					};
-
-					this->view = view;
-
-					this->dragVerticesEnabled.set("Drag vertices enabled", true);
-					this->useExistingParametersAsInitial.set("Use existing data as initial", false);
-					this->projectorReferenceImageFilename.set("Projector reference image filename", "");
-					this->calibrateOnVertexChange.set("Calibrate on vertex change", true);
-
-					videoOutputPin->onNewConnection += [this](shared_ptr<Device::VideoOutput> videoOutput) {
-						videoOutput->onDrawOutput.addListener([this](ofRectangle & outputRectangle) {
-							this->drawOnProjector();
-						}, this);
-					};
-					videoOutputPin->onDeleteConnection += [this](shared_ptr<Device::VideoOutput> videoOutput) {
-						if (videoOutput) {
-							videoOutput->onDrawOutput.removeListeners(this);
-						}
-					};
-
-					//auto-call calibrate when a vertex changes
-					referenceVerticesPin->onNewConnection += [this](shared_ptr<IReferenceVertices> referenceVertices) {
-						auto referenceVerticesWeak = weak_ptr<IReferenceVertices>(referenceVertices);
-						referenceVertices->onChangeVertex.addListener([this, referenceVerticesWeak]() {
-							if (this->calibrateOnVertexChange) {
-								auto referenceVertices = referenceVerticesWeak.lock();
-								//require at least 5 vertices
-								if (referenceVertices && referenceVertices->getVertices().size() >= 5) {
-									try {
-										this->calibrate();
-									}
-									RULR_CATCH_ALL_TO_ERROR
-								}
-							}
-						}, this);
-					};
-					referenceVerticesPin->onDeleteConnection += [this](shared_ptr<IReferenceVertices> referenceVertices) {
-						referenceVertices->onChangeVertex.removeListeners(this);
-					};
-
-					this->success = false;
-					this->reprojectionError = 0.0f;
-				}
-
-				//---------
-				ofxCvGui::PanelPtr ViewToVertices::getView() {
-					return this->view;
-				}
-
-				//---------
-				void ViewToVertices::update() {
-
-				}
-
-				//---------
-				void ViewToVertices::serialize(Json::Value & json) {
-					ofxRulr::Utils::Serializable::serialize(this->projectorReferenceImageFilename, json);
-					ofxRulr::Utils::Serializable::serialize(this->dragVerticesEnabled, json);
-					ofxRulr::Utils::Serializable::serialize(this->calibrateOnVertexChange, json);
-					ofxRulr::Utils::Serializable::serialize(this->useExistingParametersAsInitial, json);
-				}
-
-				//---------
-				void ViewToVertices::deserialize(const Json::Value & json) {
-					ofxRulr::Utils::Serializable::deserialize(this->projectorReferenceImageFilename, json);
-					if (this->projectorReferenceImageFilename.get().empty()) {
-						this->projectorReferenceImage.clear();
-					}
-					else {
-						this->projectorReferenceImage.loadImage(this->projectorReferenceImageFilename.get());
-					}
-
-					ofxRulr::Utils::Serializable::deserialize(this->dragVerticesEnabled, json);
-					ofxRulr::Utils::Serializable::deserialize(this->calibrateOnVertexChange, json);
-					ofxRulr::Utils::Serializable::deserialize(this->useExistingParametersAsInitial, json);
-				}
-
-				//---------
-				void ViewToVertices::populateInspector(ofxCvGui::ElementGroupPtr inspector) {
-					inspector->add(Widgets::Toggle::make(this->dragVerticesEnabled));
-
-					inspector->add(Widgets::Title::make("Reference image", Widgets::Title::Level::H3));
-					inspector->add(Widgets::SelectFile::make(this->projectorReferenceImageFilename.getName(), [this](){
-						return this->projectorReferenceImageFilename.get();
-					}, [this](string & newFilename) {
-						this->projectorReferenceImageFilename = newFilename;
-						this->projectorReferenceImage.loadImage(newFilename);
-					}));
-					inspector->add(Widgets::Button::make("Clear iamge", [this]() {
-						this->projectorReferenceImage.clear();
-						this->projectorReferenceImageFilename.set("");
-					}));
-
-					inspector->add(Widgets::Spacer::make());
-
-					inspector->add(Widgets::Title::make("Calibrate", Widgets::Title::Level::H3));
-					auto calibrateButton = Widgets::Button::make("Calibrate", [this]() {
-						try {
-							this->calibrate();
-						}
-						RULR_CATCH_ALL_TO_ALERT
-					}, OF_KEY_RETURN);
-					calibrateButton->setHeight(100.0f);
-					inspector->add(calibrateButton);
-					inspector->add(Widgets::Toggle::make(this->calibrateOnVertexChange));
-					inspector->add(Widgets::Toggle::make(this->useExistingParametersAsInitial));
-					inspector->add(Widgets::LiveValue<float>::make("Reprojection error", [this]() {
-						return this->reprojectionError;
-					}));
-					inspector->add(Widgets::Indicator::make("Calibration success", [this]() {
-						return (Widgets::Indicator::Status) this->success;
-					}));
-				}
-
-				//---------
-				void ViewToVertices::calibrate() {
-					this->success = false;
-
-					this->throwIfMissingAConnection<IReferenceVertices>();
-					this->throwIfMissingAConnection<Item::View>();
-
-					auto verticesNode = this->getInput<IReferenceVertices>();
-					auto viewNode = this->getInput<Item::View>();
-
-					const auto & vertices = verticesNode->getVertices();
-
-					auto worldRows = vector<vector<ofVec3f>>(1);
-					auto viewRows = vector<vector<ofVec2f>>(1);
-					auto & world = worldRows[0];
-					auto & view = viewRows[0];
-					for (auto vertex : vertices) {
-						world.push_back(vertex->getWorldPosition());
-						view.push_back(vertex->viewPosition);
-					}
-
-					vector<cv::Mat> rotations, translations;
-					auto viewSize = viewNode->getSize();
-
-
-
-					//--
-					//Initialise matrices
-					//--
-					//
-					cv::Mat cameraMatrix, distortionCoefficients;
-					if (this->useExistingParametersAsInitial) {
-						cameraMatrix = viewNode->getCameraMatrix();
-						distortionCoefficients = viewNode->getDistortionCoefficients();
-
-						//clamp the initial intrinsics so that focal length is positive
-						auto & focalLengthX = cameraMatrix.at<double>(0, 0);
-						auto & focalLengthY = cameraMatrix.at<double>(1, 1);
-						if (focalLengthX <= 0) {
-							focalLengthX = viewSize.width;
-						}
-						if (focalLengthY <= 0) {
-							focalLengthY = viewSize.height;
-						}
-
-						//clamp the initial intrinsics so that principal point is inside the image plane.
-						//this is generally true for cameras, and insisted by OpenCV before fitting,
-						//but often not true for projectors and the fit function will return principal
-						//points outside of this range.
-						auto & principalPointX = cameraMatrix.at<double>(0, 2);
-						auto & principalPointY = cameraMatrix.at<double>(1, 2);
-						if (principalPointX <= 1) {
-							principalPointX = 1;
-						}
-						if (principalPointX >= viewSize.width - 2) {
-							principalPointX = viewSize.width - 2;
-						}
-						if (principalPointY <= 1) {
-							principalPointY = 1;
-						}
-						if (principalPointY >= viewSize.height - 2) {
-							principalPointY = viewSize.height - 2;
-						}
-					}
-					else {
-						//setup some default characteristics
-						cameraMatrix = Mat::eye(3, 3, CV_64F);
-						cameraMatrix.at<double>(0, 0) = (double)viewSize.width * 1.0; // default at throw ratio of 1. : 1.0f throw ratio
-						cameraMatrix.at<double>(1, 1) = (double)viewSize.height * 1.0;
-						cameraMatrix.at<double>(0, 2) = viewSize.width / 2.0f;
-						cameraMatrix.at<double>(1, 2) = viewSize.height * (0.50f - -0.4 / 2.0f); // default at 40% lens offset
-
-						distortionCoefficients = Mat::zeros(5, 1, CV_64F);
-					}
-					//
-					//--
-
-
-					//--
-					//check videoOutput has same size
-					//--
-					//
-					auto videoOutput = this->getInput<Device::VideoOutput>();
-					if (videoOutput) {
-						if (videoOutput->getWidth() != viewSize.width || videoOutput->getHeight() != viewSize.height) {
-							ofLogWarning("ViewToVertices") << "VideoOutput's size does not match View's size";
-						}
-					}
-					//
-					//--
-
-
-
-					//INSERT SYNETHESISED DATA
-					//ofLogWarning() << "USING SYNTHESISED DATA for 1280x800 view";
-					//worldRows.clear(); viewRows.clear();
-					//worldRows.push_back(vector<ofVec3f>()); viewRows.push_back(vector<ofVec2f>());
-					//worldRows[0].push_back(ofVec3f(0.4245, -0.3661, 0.4878)); viewRows[0].push_back(ofVec2f(596.9032, 721.8095));
-					//worldRows[0].push_back(ofVec3f(0.3507, 0.4697, -0.4054)); viewRows[0].push_back(ofVec2f(490.7527, 278.5092));
-					//worldRows[0].push_back(ofVec3f(-0.4230, 0.1083, -0.4126)); viewRows[0].push_back(ofVec2f(839.1771, 427.4655));
-					//worldRows[0].push_back(ofVec3f(-0.1699, -0.0651, -0.4814)); viewRows[0].push_back(ofVec2f(709.3167, 524.0535));
-					//worldRows[0].push_back(ofVec3f(0.2611, 0.3133, -0.1917)); viewRows[0].push_back(ofVec2f(563.7585, 382.7776));
-					//worldRows[0].push_back(ofVec3f(0.1478, 0.3996, 0.4931)); viewRows[0].push_back(ofVec2f(689.3846, 419.8475));
-					//worldRows[0].push_back(ofVec3f(0.0032, 0.1185, -0.2893)); viewRows[0].push_back(ofVec2f(656.1019, 455.0570));
-
-					//--
-					//setup flags
-					//--
-					//
-					auto flags = CV_CALIB_USE_INTRINSIC_GUESS; // since we're using a single object
-					if (viewNode->getHasDistortion()) {
-						flags |= RULR_VIEW_CALIBRATION_FLAGS;
-					}
-					else {
-						flags |= (CV_CALIB_FIX_K1 | CV_CALIB_FIX_K2 | CV_CALIB_FIX_K3 | CV_CALIB_FIX_K4 | CV_CALIB_FIX_K5 | CV_CALIB_FIX_K6 | CV_CALIB_ZERO_TANGENT_DIST);
-					}
-					//--
-
-
-
-					//--
-					//FIT
-					//--
-					//
-					auto reprojectionError = cv::calibrateCamera(toCv(worldRows), toCv(viewRows), viewSize, cameraMatrix, distortionCoefficients, rotations, translations, flags);
-					//we might have thrown at this point
-					//
-					//--
-
-
-
-					//--
-					//Set output
-					//--
-					//
-					viewNode->setIntrinsics(cameraMatrix, distortionCoefficients);
-					auto objectTransform = ofxCv::makeMatrix(rotations[0], translations[0]);
-					viewNode->setTransform(objectTransform.getInverse());
-					this->success = true;
-					this->reprojectionError = reprojectionError;
-					//
-					//--
-
-					for (auto & point : worldRows[0]) {
-						cout << point << endl;
-					}
-					for (auto & point : viewRows[0]) {
-						cout << point << endl;
-					}
-				}
-
-				//---------
-				void ViewToVertices::drawOnProjector() {
-					auto referenceVerticesNode = this->getInput<IReferenceVertices>();
-					if (referenceVerticesNode) {
-						auto vertices = referenceVerticesNode->getVertices();
-						for (auto vertex : vertices) {
-							if (vertex->isSelected()){
-								ofxSpinCursor::draw(vertex->viewPosition);
-							}
-						}
-					}
-				}
-			}
-		}
-	}
+#include "ViewToVertices.h"
+
+#include "../../Item/View.h"
+#include "../../Device/VideoOutput.h"
+#include "IReferenceVertices.h"
+
+#include "ofxRulr/Utils/LensModelSelection.h"
+
+#include "ofxCvGui/Widgets/SelectFile.h"
+#include "ofxCvGui/Widgets/Indicator.h"
+#include "ofxCvGui/Widgets/Button.h"
+#include "ofxCvGui/Widgets/EditableValue.h"
+#include "../../../addons/ofxSpinCursor/src/ofxSpinCursor.h"
+
+#include "ofxCvMin.h"
+
+using namespace ofxCvGui;
+using namespace ofxCv;
+using namespace ofxRulr::Nodes;
+
+namespace ofxRulr {
+	namespace Nodes {
+		namespace Procedure {
+			namespace Calibrate {
+#pragma mark ViewArea
+				//---------
+				ViewToVertices::ViewArea::ViewArea(ViewToVertices & parent) : parent(parent) {
+
+				}
+
+				//---------
+				void ViewToVertices::ViewArea::draw(float x, float y) const {
+					this->draw(x, y, this->getWidth(), this->getHeight());
+				}
+
+				//---------
+				void ViewToVertices::ViewArea::draw(float x, float y, float w, float h) const {
+					if (this->parent.projectorReferenceImage.isAllocated()) {
+						this->parent.projectorReferenceImage.draw(x, y, w, h);
+					}
+				}
+
+				//---------
+				float ViewToVertices::ViewArea::getHeight() const {
+					auto view = this->parent.getInput<Item::View>();
+					if (view) {
+						return view->getHeight();
+					}
+					else {
+						return 1;
+					}
+				}
+
+				//---------
+				float ViewToVertices::ViewArea::getWidth() const {
+					auto view = this->parent.getInput<Item::View>();
+					if (view) {
+						return view->getWidth();
+					}
+					else {
+						return 1;
+					}
+				}
+
+#pragma mark ViewToVertices
+				//---------
+				ViewToVertices::ViewToVertices() :
+				viewArea(*this),
+				solveRequested(false),
+				solveDueTime(0.0f),
+				solveFirstRequestTime(0.0f),
+				solverClosing(false),
+				solverRequestIndex(0),
+				solverCancelIndex(0),
+				solverResultIndex(0),
+				solverFailed(false) {
+					RULR_NODE_INIT_LISTENER;
+				}
+
+				//---------
+				ViewToVertices::~ViewToVertices() {
+					{
+						lock_guard<mutex> lock(this->solverMutex);
+						this->solverClosing = true;
+					}
+					this->solverCondition.notify_all();
+					if (this->solverThread.joinable()) {
+						this->solverThread.join();
+					}
+				}
+
+				//---------
+				string ViewToVertices::getTypeName() const {
+					return "Procedure::Calibrate::ViewToVertices";
+				}
+
+				//---------
+				void ViewToVertices::init() {
+					RULR_NODE_UPDATE_LISTENER;
+					RULR_NODE_SERIALIZATION_LISTENERS;
+					RULR_NODE_INSPECTOR_LISTENER;
+
+					this->addInput<Item::View>();
+					auto videoOutputPin = this->addInput<Device::VideoOutput>();
+					auto referenceVerticesPin = this->addInput<IReferenceVertices>();
+
+					auto view = make_shared<Panels::Draws>(this->viewArea);
+					auto viewWeak = weak_ptr<Panels::Draws>(view);
+					view->onDrawCropped += [this](Panels::Draws::DrawCroppedArguments & args) {
+						//draw a label at each vertex
+						auto referenceVertices = this->getInput<IReferenceVertices>();
+						if (!referenceVertices) {
+							return;
+						}
+						auto scaleDrawToScreenFactor = args.drawSize / args.viewSize;
+
+						ofPushMatrix();
+						const auto & vertices = referenceVertices->getVertices();
+
+						//residual from each vertex to where the fitted view projects it
+						ofPushStyle();
+						ofSetColor(255, 0, 0);
+						for (size_t i = 0; i < vertices.size() && i < this->reprojectedVertices.size(); i++) {
+							ofLine(vertices[i]->viewPosition, this->reprojectedVertices[i]);
+						}
+						ofPopStyle();
+
+						int index = 0;
+						for (auto vertex : vertices) {
+							ofPushMatrix();
+							ofTranslate(vertex->viewPosition);
+
+							//text label
+							ofDrawBitmapString(ofToString(index++), 0, 0);
+
+							//cross
+							ofPushStyle();
+							ofScale(scaleDrawToScreenFactor.x, scaleDrawToScreenFactor.y);
+							//surround
+							ofSetLineWidth(3.0f);
+							ofSetColor(0);
+							ofLine(-10, 0, 10, 0);
+							ofLine(0, -10, 0, 10);
+							//inner
+							ofSetLineWidth(1.0f);
+							ofSetColor(vertex->isSelected() ? ofxCvGui::Utils::getBeatingSelectionColor() : ofColor(100));
+							ofLine(-10, 0, 10, 0);
+							ofLine(0, -10, 0, 10);
+							ofPopStyle();
+
+							ofPopMatrix();
+						}
+						ofPopMatrix();
+					};
+					view->onMouse += [this, viewWeak](ofxCvGui::MouseArguments & args) {
+						auto view = viewWeak.lock();
+						args.takeMousePress(view);
+
+						//if the mouse is dragging then move the vertex in view space
+						if (args.isDragging(view) && this->dragVerticesEnabled) {
+							auto referenceVertices = this->getInput<IReferenceVertices>();
+							if (referenceVertices) {
+								const auto & vertices = referenceVertices->getVertices();
+								for (auto vertex : vertices) {
+									if (vertex->isSelected()) {
+										auto multiplier = 0.5f;
+										if (ofGetKeyPressed(OF_KEY_SHIFT)) {
+											multiplier /= 5.0f;
+										}
+										vertex->viewPosition += args.movement * multiplier;
+										referenceVertices->onChangeVertex.notifyListeners();
+									}
+								}
+							}
+						}
+					};
+					view->onKeyboard += [this](ofxCvGui::KeyboardArguments & args) {
+						if (args.action == KeyboardArguments::Action::Pressed) {
+							ofVec2f movement;
+							switch (args.key) {
+							case OF_KEY_LEFT:
+								movement.x = -1;
+								break;
+							case OF_KEY_RIGHT:
+								movement.x = +1;
+								break;
+							case OF_KEY_UP:
+								movement.y = -1;
+								break;
+							case OF_KEY_DOWN:
+								movement.y = +1;
+								break;
+							default:
+								break;
+							}
+
+							if (movement != ofVec2f() && this->dragVerticesEnabled) {
+								if (ofGetKeyPressed(OF_KEY_SHIFT)) {
+									movement *= 5;
+								}
+								auto referenceVertices = this->getInput<IReferenceVertices>();
+								if (referenceVertices) {
+									const auto & vertices = referenceVertices->getVertices();
+									for (auto vertex : vertices) {
+										if (vertex->isSelected()) {
+											vertex->viewPosition += movement;
+											referenceVertices->onChangeVertex.notifyListeners();
+										}
+									}
+								}
+							}
+						}
+					};
+
+					this->view = view;
+
+					this->dragVerticesEnabled.set("Drag vertices enabled", true);
+					this->useExistingParametersAsInitial.set("Use existing data as initial", false);
+					this->projectorReferenceImageFilename.set("Projector reference image filename", "");
+					this->calibrateOnVertexChange.set("Calibrate on vertex change", true);
+					this->crossValidationFolds.set("Cross validation folds", 5, 2, 20);
+
+					videoOutputPin->onNewConnection += [this](shared_ptr<Device::VideoOutput> videoOutput) {
+						videoOutput->onDrawOutput.addListener([this](ofRectangle & outputRectangle) {
+							this->drawOnProjector();
+						}, this);
+					};
+					videoOutputPin->onDeleteConnection += [this](shared_ptr<Device::VideoOutput> videoOutput) {
+						if (videoOutput) {
+							videoOutput->onDrawOutput.removeListeners(this);
+						}
+					};
+
+					//solve in the background when a vertex changes
+					referenceVerticesPin->onNewConnection += [this](shared_ptr<IReferenceVertices> referenceVertices) {
+						referenceVertices->onChangeVertex.addListener([this]() {
+							if (this->calibrateOnVertexChange) {
+								this->requestSolve();
+							}
+						}, this);
+					};
+					referenceVerticesPin->onDeleteConnection += [this](shared_ptr<IReferenceVertices> referenceVertices) {
+						referenceVertices->onChangeVertex.removeListeners(this);
+					};
+
+					this->success = false;
+					this->reprojectionError = 0.0f;
+
+					this->lensModelFlags = RULR_VIEW_CALIBRATION_FLAGS;
+					this->lensModelName = "Default";
+					this->lensModelCrossValidationError = 0.0f;
+				}
+
+				//---------
+				ofxCvGui::PanelPtr ViewToVertices::getView() {
+					return this->view;
+				}
+
+				//---------
+				void ViewToVertices::update() {
+					//hand the changes to the solver thread once the window has closed
+					if (this->solveRequested && ofGetElapsedTimef() >= this->solveDueTime) {
+						this->solveRequested = false;
+
+						//require at least 5 vertices
+						auto referenceVertices = this->getInput<IReferenceVertices>();
+						if (referenceVertices && referenceVertices->getVertices().size() >= 5) {
+							try {
+								auto problem = make_shared<Problem>(this->prepareProblem());
+								if (!this->solverThread.joinable()) {
+									this->solverThread = thread([this]() {
+										this->solverThreadLoop();
+									});
+								}
+								{
+									lock_guard<mutex> lock(this->solverMutex);
+									this->solverProblem = problem;
+									this->solverRequestIndex++;
+								}
+								this->solverCondition.notify_one();
+							}
+							RULR_CATCH_ALL_TO_ERROR
+						}
+					}
+
+					//apply the result from the solver thread, unless a newer request has superseded it
+					shared_ptr<Solution> solution;
+					bool failed;
+					string errorMessage;
+					{
+						lock_guard<mutex> lock(this->solverMutex);
+						swap(solution, this->solverSolution);
+						failed = this->solverFailed;
+						this->solverFailed = false;
+						errorMessage = this->solverErrorMessage;
+						if (this->solverResultIndex != this->solverRequestIndex) {
+							solution.reset();
+							failed = false;
+						}
+					}
+					if (solution) {
+						try {
+							this->applySolution(*solution);
+						}
+						RULR_CATCH_ALL_TO_ERROR
+					}
+					else if (failed) {
+						this->success = false;
+						this->reprojectedVertices.clear();
+						ofLogError("ViewToVertices") << errorMessage;
+					}
+				}
+
+				//---------
+				void ViewToVertices::serialize(Json::Value & json) {
+					ofxRulr::Utils::Serializable::serialize(this->projectorReferenceImageFilename, json);
+					ofxRulr::Utils::Serializable::serialize(this->dragVerticesEnabled, json);
+					ofxRulr::Utils::Serializable::serialize(this->calibrateOnVertexChange, json);
+					ofxRulr::Utils::Serializable::serialize(this->useExistingParametersAsInitial, json);
+					ofxRulr::Utils::Serializable::serialize(this->crossValidationFolds, json);
+
+					auto & jsonLensModel = json["lensModel"];
+					jsonLensModel["flags"] = this->lensModelFlags;
+					jsonLensModel["name"] = this->lensModelName;
+					jsonLensModel["crossValidationError"] = this->lensModelCrossValidationError;
+				}
+
+				//---------
+				void ViewToVertices::deserialize(const Json::Value & json) {
+					ofxRulr::Utils::Serializable::deserialize(this->projectorReferenceImageFilename, json);
+					if (this->projectorReferenceImageFilename.get().empty()) {
+						this->projectorReferenceImage.clear();
+					}
+					else {
+						this->projectorReferenceImage.loadImage(this->projectorReferenceImageFilename.get());
+					}
+
+					ofxRulr::Utils::Serializable::deserialize(this->dragVerticesEnabled, json);
+					ofxRulr::Utils::Serializable::deserialize(this->calibrateOnVertexChange, json);
+					ofxRulr::Utils::Serializable::deserialize(this->useExistingParametersAsInitial, json);
+					ofxRulr::Utils::Serializable::deserialize(this->crossValidationFolds, json);
+
+					const auto & jsonLensModel = json["lensModel"];
+					if (jsonLensModel.isMember("flags")) {
+						this->lensModelFlags = jsonLensModel["flags"].asInt();
+						this->lensModelName = jsonLensModel["name"].asString();
+						this->lensModelCrossValidationError = jsonLensModel["crossValidationError"].asFloat();
+					}
+				}
+
+				//---------
+				void ViewToVertices::populateInspector(ofxCvGui::ElementGroupPtr inspector) {
+					inspector->add(Widgets::Toggle::make(this->dragVerticesEnabled));
+
+					inspector->add(Widgets::Title::make("Reference image", Widgets::Title::Level::H3));
+					inspector->add(Widgets::SelectFile::make(this->projectorReferenceImageFilename.getName(), [this](){
+						return this->projectorReferenceImageFilename.get();
+					}, [this](string & newFilename) {
+						this->projectorReferenceImageFilename = newFilename;
+						this->projectorReferenceImage.loadImage(newFilename);
+					}));
+					inspector->add(Widgets::Button::make("Clear iamge", [this]() {
+						this->projectorReferenceImage.clear();
+						this->projectorReferenceImageFilename.set("");
+					}));
+
+					inspector->add(Widgets::Spacer::make());
+
+					inspector->add(Widgets::Title::make("Calibrate", Widgets::Title::Level::H3));
+					auto calibrateButton = Widgets::Button::make("Calibrate", [this]() {
+						try {
+							this->calibrate();
+						}
+						RULR_CATCH_ALL_TO_ALERT
+					}, OF_KEY_RETURN);
+					calibrateButton->setHeight(100.0f);
+					inspector->add(calibrateButton);
+					inspector->add(Widgets::Toggle::make(this->calibrateOnVertexChange));
+					inspector->add(Widgets::Toggle::make(this->useExistingParametersAsInitial));
+					inspector->add(Widgets::LiveValue<float>::make("Reprojection error", [this]() {
+						return this->reprojectionError;
+					}));
+					inspector->add(Widgets::Indicator::make("Calibration success", [this]() {
+						return (Widgets::Indicator::Status) this->success;
+					}));
+
+					inspector->add(Widgets::Spacer::make());
+
+					inspector->add(Widgets::Title::make("Lens model", Widgets::Title::Level::H3));
+					inspector->add(Widgets::EditableValue<int>::make(this->crossValidationFolds));
+					inspector->add(Widgets::Button::make("Select lens model", [this]() {
+						try {
+							this->selectLensModel();
+						}
+						RULR_CATCH_ALL_TO_ALERT
+					}));
+					inspector->add(Widgets::LiveValue<string>::make("Lens model", [this]() {
+						return this->lensModelName;
+					}));
+					inspector->add(Widgets::LiveValue<float>::make("Cross validation error", [this]() {
+						return this->lensModelCrossValidationError;
+					}));
+				}
+
+				//---------
+				void ViewToVertices::calibrate() {
+					this->cancelSolve();
+					this->success = false;
+					this->reprojectedVertices.clear();
+
+					const auto problem = this->prepareProblem();
+					this->applySolution(ViewToVertices::solve(problem));
+				}
+
+				//---------
+				ViewToVertices::Problem ViewToVertices::prepareProblem() {
+					this->throwIfMissingAConnection<IReferenceVertices>();
+					this->throwIfMissingAConnection<Item::View>();
+
+					auto viewNode = this->getInput<Item::View>();
+
+					Problem problem;
+					problem.viewSize = viewNode->getSize();
+					this->prepareCalibration(problem.worldRows, problem.viewRows, problem.cameraMatrix, problem.distortionCoefficients);
+
+					//INSERT SYNETHESISED DATA
+					//ofLogWarning() << "USING SYNTHESISED DATA for 1280x800 view";
+					//problem.worldRows.clear(); problem.viewRows.clear();
+					//problem.worldRows.push_back(vector<ofVec3f>()); problem.viewRows.push_back(vector<ofVec2f>());
+					//problem.worldRows[0].push_back(ofVec3f(0.4245, -0.3661, 0.4878)); problem.viewRows[0].push_back(ofVec2f(596.9032, 721.8095));
+					//problem.worldRows[0].push_back(ofVec3f(0.3507, 0.4697, -0.4054)); problem.viewRows[0].push_back(ofVec2f(490.7527, 278.5092));
+					//problem.worldRows[0].push_back(ofVec3f(-0.4230, 0.1083, -0.4126)); problem.viewRows[0].push_back(ofVec2f(839.1771, 427.4655));
+					//problem.worldRows[0].push_back(ofVec3f(-0.1699, -0.0651, -0.4814)); problem.viewRows[0].push_back(ofVec2f(709.3167, 524.0535));
+					//problem.worldRows[0].push_back(ofVec3f(0.2611, 0.3133, -0.1917)); problem.viewRows[0].push_back(ofVec2f(563.7585, 382.7776));
+					//problem.worldRows[0].push_back(ofVec3f(0.1478, 0.3996, 0.4931)); problem.viewRows[0].push_back(ofVec2f(689.3846, 419.8475));
+					//problem.worldRows[0].push_back(ofVec3f(0.0032, 0.1185, -0.2893)); problem.viewRows[0].push_back(ofVec2f(656.1019, 455.0570));
+
+					//--
+					//setup flags
+					//--
+					//
+					problem.flags = CV_CALIB_USE_INTRINSIC_GUESS; // since we're using a single object
+					if (viewNode->getHasDistortion()) {
+						problem.flags |= this->lensModelFlags;
+					}
+					else {
+						problem.flags |= RULR_VIEW_CALIBRATION_NO_DISTORTION_FLAGS | (this->lensModelFlags & (CV_CALIB_FIX_PRINCIPAL_POINT | CV_CALIB_FIX_ASPECT_RATIO));
+					}
+					//--
+
+					return problem;
+				}
+
+				//---------
+				ViewToVertices::Solution ViewToVertices::solve(const Problem & problem) {
+					Solution solution;
+					solution.cameraMatrix = problem.cameraMatrix.clone();
+					solution.distortionCoefficients = problem.distortionCoefficients.clone();
+
+					vector<cv::Mat> rotations, translations;
+					solution.reprojectionError = cv::calibrateCamera(toCv(problem.worldRows), toCv(problem.viewRows), problem.viewSize, solution.cameraMatrix, solution.distortionCoefficients, rotations, translations, problem.flags);
+					//we might have thrown at this point
+
+					auto objectTransform = ofxCv::makeMatrix(rotations[0], translations[0]);
+					solution.viewTransform = objectTransform.getInverse();
+					solution.worldPoints = problem.worldRows[0];
+					return solution;
+				}
+
+				//---------
+				void ViewToVertices::applySolution(const Solution & solution) {
+					this->throwIfMissingAConnection<Item::View>();
+					auto viewNode = this->getInput<Item::View>();
+
+					//intrinsics and extrinsics arrive together as one change to the view
+					viewNode->beginUpdate();
+					viewNode->setIntrinsics(solution.cameraMatrix, solution.distortionCoefficients);
+					viewNode->setTransform(solution.viewTransform);
+					viewNode->commitUpdate();
+
+					this->success = true;
+					this->reprojectionError = solution.reprojectionError;
+					viewNode->getBatchTransform().project(solution.worldPoints, this->reprojectedVertices, false);
+				}
+
+				//---------
+				void ViewToVertices::requestSolve() {
+					//each change pushes the solve back, so that we solve once the changes have stopped.
+					//but during continuous changes we don't wait longer than the max wait since the first of them
+					const auto now = ofGetElapsedTimef();
+					if (!this->solveRequested) {
+						this->solveRequested = true;
+						this->solveFirstRequestTime = now;
+					}
+					this->solveDueTime = min(now + RULR_VIEW_TO_VERTICES_SOLVE_WINDOW, this->solveFirstRequestTime + RULR_VIEW_TO_VERTICES_SOLVE_MAX_WAIT);
+				}
+
+				//---------
+				void ViewToVertices::cancelSolve() {
+					this->solveRequested = false;
+
+					lock_guard<mutex> lock(this->solverMutex);
+					this->solverProblem.reset();
+					this->solverSolution.reset();
+					this->solverFailed = false;
+					this->solverCancelIndex = this->solverRequestIndex;
+				}
+
+				//---------
+				void ViewToVertices::solverThreadLoop() {
+					while (true) {
+						shared_ptr<Problem> problem;
+						uint64_t requestIndex;
+						{
+							unique_lock<mutex> lock(this->solverMutex);
+							this->solverCondition.wait(lock, [this]() {
+								return this->solverClosing || this->solverProblem;
+							});
+							if (this->solverClosing) {
+								return;
+							}
+							problem = this->solverProblem;
+							this->solverProblem.reset();
+							requestIndex = this->solverRequestIndex;
+						}
+
+						shared_ptr<Solution> solution;
+						string errorMessage;
+						try {
+							solution = make_shared<Solution>(ViewToVertices::solve(*problem));
+						}
+						RULR_CATCH_ALL_TO(errorMessage = e.what())
+
+						{
+							lock_guard<mutex> lock(this->solverMutex);
+							if (requestIndex > this->solverCancelIndex) {
+								this->solverSolution = solution;
+								this->solverFailed = !solution;
+								this->solverErrorMessage = errorMessage;
+								this->solverResultIndex = requestIndex;
+							}
+						}
+					}
+				}
+
+				//---------
+				void ViewToVertices::selectLensModel() {
+					this->cancelSolve();
+					this->success = false;
+					this->reprojectedVertices.clear();
+
+					this->throwIfMissingAConnection<IReferenceVertices>();
+					this->throwIfMissingAConnection<Item::View>();
+
+					auto viewNode = this->getInput<Item::View>();
+
+					vector<vector<ofVec3f>> worldRows;
+					vector<vector<ofVec2f>> viewRows;
+					cv::Mat cameraMatrix, distortionCoefficients;
+					this->prepareCalibration(worldRows, viewRows, cameraMatrix, distortionCoefficients);
+
+					//with a single view, the folds hold out vertices
+					auto models = Utils::LensModelSelection::getDefaultModels();
+					if (!viewNode->getHasDistortion()) {
+						models.clear();
+						models.push_back({ "Pinhole", RULR_VIEW_CALIBRATION_NO_DISTORTION_FLAGS });
+						models.push_back({ "Pinhole, fixed principal point", RULR_VIEW_CALIBRATION_NO_DISTORTION_FLAGS | CV_CALIB_FIX_PRINCIPAL_POINT });
+						models.push_back({ "Pinhole, fixed aspect ratio", RULR_VIEW_CALIBRATION_NO_DISTORTION_FLAGS | CV_CALIB_FIX_ASPECT_RATIO });
+					}
+
+					const vector<vector<cv::Point3f>> worldRowsCv = toCv(worldRows);
+					const vector<vector<cv::Point2f>> viewRowsCv = toCv(viewRows);
+					auto results = Utils::LensModelSelection::select(worldRowsCv, viewRowsCv, viewNode->getSize(), cameraMatrix, distortionCoefficients, CV_CALIB_USE_INTRINSIC_GUESS, this->crossValidationFolds, models);
+					const auto & best = results.front();
+					if (!best.success) {
+						throw(ofxRulr::Exception("No lens model could be fitted : " + best.errorMessage));
+					}
+					for (const auto & result : results) {
+						ofLogNotice("ViewToVertices") << result.model.name << " : " << (result.success ? ofToString(result.crossValidationError) + "px" : result.errorMessage);
+					}
+
+					this->lensModelFlags = best.model.flags;
+					this->lensModelName = best.model.name;
+					this->lensModelCrossValidationError = best.crossValidationError;
+
+					viewNode->setIntrinsics(best.cameraMatrix, best.distortionCoefficients);
+					auto objectTransform = ofxCv::makeMatrix(best.rotations[0], best.translations[0]);
+					viewNode->setTransform(objectTransform.getInverse());
+					this->success = true;
+					this->reprojectionError = best.fitError;
+					viewNode->getBatchTransform().project(worldRows[0], this->reprojectedVertices, false);
+				}
+
+				//---------
+				void ViewToVertices::prepareCalibration(vector<vector<ofVec3f>> & worldRows, vector<vector<ofVec2f>> & viewRows, cv::Mat & cameraMatrix, cv::Mat & distortionCoefficients) {
+					auto verticesNode = this->getInput<IReferenceVertices>();
+					auto viewNode = this->getInput<Item::View>();
+
+					const auto & vertices = verticesNode->getVertices();
+
+					worldRows.assign(1, vector<ofVec3f>());
+					viewRows.assign(1, vector<ofVec2f>());
+					auto & world = worldRows[0];
+					auto & view = viewRows[0];
+					for (auto vertex : vertices) {
+						world.push_back(vertex->getWorldPosition());
+						view.push_back(vertex->viewPosition);
+					}
+
+					auto viewSize = viewNode->getSize();
+
+
+
+					//--
+					//Initialise matrices
+					//--
+					//
+					if (this->useExistingParametersAsInitial) {
+						cameraMatrix = viewNode->getCameraMatrix().clone(); // we clamp and fit into these
+						distortionCoefficients = viewNode->getDistortionCoefficients().clone();
+
+						//clamp the initial intrinsics so that focal length is positive
+						auto & focalLengthX = cameraMatrix.at<double>(0, 0);
+						auto & focalLengthY = cameraMatrix.at<double>(1, 1);
+						if (focalLengthX <= 0) {
+							focalLengthX = viewSize.width;
+						}
+						if (focalLengthY <= 0) {
+							focalLengthY = viewSize.height;
+						}
+
+						//clamp the initial intrinsics so that principal point is inside the image plane.
+						//this is generally true for cameras, and insisted by OpenCV before fitting,
+						//but often not true for projectors and the fit function will return principal
+						//points outside of this range.
+						auto & principalPointX = cameraMatrix.at<double>(0, 2);
+						auto & principalPointY = cameraMatrix.at<double>(1, 2);
+						if (principalPointX <= 1) {
+							principalPointX = 1;
+						}
+						if (principalPointX >= viewSize.width - 2) {
+							principalPointX = viewSize.width - 2;
+						}
+						if (principalPointY <= 1) {
+							principalPointY = 1;
+						}
+						if (principalPointY >= viewSize.height - 2) {
+							principalPointY = viewSize.height - 2;
+						}
+					}
+					else {
+						//setup some default characteristics
+						cameraMatrix = Mat::eye(3, 3, CV_64F);
+						cameraMatrix.at<double>(0, 0) = (double)viewSize.width * 1.0; // default at throw ratio of 1. : 1.0f throw ratio
+						cameraMatrix.at<double>(1, 1) = (double)viewSize.height * 1.0;
+						cameraMatrix.at<double>(0, 2) = viewSize.width / 2.0f;
+						cameraMatrix.at<double>(1, 2) = viewSize.height * (0.50f - -0.4 / 2.0f); // default at 40% lens offset
+
+						distortionCoefficients = Mat::zeros(5, 1, CV_64F);
+					}
+					//
+					//--
+
+
+
+
+					//--
+					//check videoOutput has same size
+					//--
+					//
+					auto videoOutput = this->getInput<Device::VideoOutput>();
+					if (videoOutput) {
+						if (videoOutput->getWidth() != viewSize.width || videoOutput->getHeight() != viewSize.height) {
+							ofLogWarning("ViewToVertices") << "VideoOutput's size does not match View's size";
+						}
+					}
+					//
+					//--
+				}
+
+				//---------
+				void ViewToVertices::drawOnProjector() {
+					auto referenceVerticesNode = this->getInput<IReferenceVertices>();
+					if (referenceVerticesNode) {
+						auto vertices = referenceVerticesNode->getVertices();
+						for (auto vertex : vertices) {
+							if (vertex->isSelected()){
+								ofxSpinCursor::draw(vertex->viewPosition);
+							}
+						}
+					}
+				}
+			}
+		}
+	}
 }
\ No newline at end of file
@@ -1,49 +1,108 @@
-#pragma once
-
-#include "../Base.h"
-
-namespace ofxRulr {
-	namespace Nodes {
-		namespace Procedure {
-			namespace Calibrate {
-				class ViewToVertices : public Base {
-				public:
-					class ViewArea : public ofBaseDraws {
-					public:
-						ViewArea(ViewToVertices &);
-						void draw(float x, float y) const override;
-						void draw(float x, float y, float w, float h) const override;
-						float getHeight() const override;
-						float getWidth() const override;
-					protected:
-						ViewToVertices & parent;
-					};
-					ViewToVertices();
-					string getTypeName() const override;
-					void init();
-					ofxCvGui::PanelPtr getView() override;
-					void update();
-
-					void serialize(Json::Value &);
-					void deserialize(const Json::Value &);
-					void populateInspector(ofxCvGui::ElementGroupPtr);
-
-					void calibrate(); // will throw on fail
-				protected:
-					void drawOnProjector();
-
-					ViewArea viewArea;
-					ofxCvGui::PanelPtr view;
-
-					ofParameter<string> projectorReferenceImageFilename;
-					ofImage projectorReferenceImage;
-					ofParameter<bool> dragVerticesEnabled;
-					ofParameter<bool> calibrateOnVertexChange;
-					ofParameter<bool> useExistingParametersAsInitial;
-					bool success;
-					float reprojectionError;
-				};
-			}
-		}
-	}
-}
+#pragma once
+
+#include "../Base.h"
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+//when calibrating on vertex change, we solve once the vertices have been still for this long [s]
+#define RULR_VIEW_TO_VERTICES_SOLVE_WINDOW 0.05f
+//whilst the vertices keep changing (e.g. during a drag), we still solve at least this often [s]
+#define RULR_VIEW_TO_VERTICES_SOLVE_MAX_WAIT 0.15f
+
+namespace ofxRulr {
+	namespace Nodes {
+		namespace Procedure {
+			namespace Calibrate {
+				class ViewToVertices : public Base {
+				public:
+					class ViewArea : public ofBaseDraws {
+					public:
+						ViewArea(ViewToVertices &);
+						void draw(float x, float y) const override;
+						void draw(float x, float y, float w, float h) const override;
+						float getHeight() const override;
+						float getWidth() const override;
+					protected:
+						ViewToVertices & parent;
+					};
+					ViewToVertices();
+					~ViewToVertices();
+					string getTypeName() const override;
+					void init();
+					ofxCvGui::PanelPtr getView() override;
+					void update();
+
+					void serialize(Json::Value &);
+					void deserialize(const Json::Value &);
+					void populateInspector(ofxCvGui::ElementGroupPtr);
+
+					void calibrate(); // will throw on fail
+					void selectLensModel(); // will throw on fail
+				protected:
+					///Everything cv::calibrateCamera needs, gathered on the main thread
+					struct Problem {
+						vector<vector<ofVec3f>> worldRows;
+						vector<vector<ofVec2f>> viewRows;
+						cv::Size viewSize;
+						cv::Mat cameraMatrix;
+						cv::Mat distortionCoefficients;
+						int flags;
+					};
+					struct Solution {
+						cv::Mat cameraMatrix;
+						cv::Mat distortionCoefficients;
+						ofMatrix4x4 viewTransform;
+						float reprojectionError;
+						vector<ofVec3f> worldPoints;
+					};
+
+					Problem prepareProblem();
+					static Solution solve(const Problem &); // safe to call from any thread
+					void applySolution(const Solution &);
+
+					void requestSolve(); // debounced (each request restarts the window, up to a maximum wait), runs on the solver thread
+					void cancelSolve(); // drops any queued or in flight solve
+					void solverThreadLoop();
+
+					void prepareCalibration(vector<vector<ofVec3f>> & worldRows, vector<vector<ofVec2f>> & viewRows, cv::Mat & cameraMatrix, cv::Mat & distortionCoefficients);
+					void drawOnProjector();
+
+					ViewArea viewArea;
+					ofxCvGui::PanelPtr view;
+
+					ofParameter<string> projectorReferenceImageFilename;
+					ofImage projectorReferenceImage;
+					ofParameter<bool> dragVerticesEnabled;
+					ofParameter<bool> calibrateOnVertexChange;
+					ofParameter<bool> useExistingParametersAsInitial;
+					ofParameter<int> crossValidationFolds;
+					bool success;
+					float reprojectionError;
+					vector<ofVec2f> reprojectedVertices; // world vertices projected through the fitted view, by vertex index
+
+					int lensModelFlags;
+					string lensModelName;
+					float lensModelCrossValidationError;
+
+					bool solveRequested;
+					float solveDueTime;
+					float solveFirstRequestTime; // of the changes which are waiting to be solved
+
+					thread solverThread;
+					mutex solverMutex;
+					condition_variable solverCondition;
+					bool solverClosing;
+					uint64_t solverRequestIndex;
+					uint64_t solverCancelIndex; // results of requests up to this index are dropped
+					shared_ptr<Problem> solverProblem; // waiting to be picked up by the solver thread. A newer request replaces it
+					shared_ptr<Solution> solverSolution; // waiting to be applied on the main thread
+					string solverErrorMessage;
+					bool solverFailed;
+					uint64_t solverResultIndex; // the request which solverSolution / solverFailed belong to
+				};
+			}
+		}
+	}
+}
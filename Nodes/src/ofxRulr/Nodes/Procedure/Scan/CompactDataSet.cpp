@@ -0,0 +1,284 @@
+#include "CompactDataSet.h"
+
+#include "ofxRulr/Exception.h"
+#include "ofxRulr/Utils/Constants.h"
+
+#include "Poco/File.h"
+
+#define RULR_COMPACT_DATASET_MAGIC "RULRSL\0\0"
+#define RULR_COMPACT_DATASET_VERSION 1
+#define RULR_COMPACT_DATASET_ALIGNMENT 16
+
+namespace ofxRulr {
+	namespace Nodes {
+		namespace Procedure {
+			namespace Scan {
+				//----------
+				void CompactDataSet::save(const ofxGraycode::DataSet & dataSet, const string & filename) {
+					if (!dataSet.getHasData()) {
+						throw(Exception("Cannot save an empty ofxGraycode::DataSet"));
+					}
+
+					const auto width = dataSet.getWidth();
+					const auto height = dataSet.getHeight();
+					const auto payloadWidth = dataSet.getPayloadWidth();
+					const auto pixelCount = width * height;
+
+					//pack the per pixel arrays
+					vector<uint32_t> projectorIndices(pixelCount, 0);
+					vector<uint8_t> active(pixelCount, 0);
+					vector<uint8_t> distance(pixelCount, 0);
+					vector<uint8_t> median(pixelCount, 0);
+					for (const auto & pixel : dataSet) {
+						const auto cameraXY = pixel.getCameraXY();
+						const auto projectorXY = pixel.getProjectorXY();
+						const auto cameraIndex = (int)cameraXY.x + (int)cameraXY.y * width;
+						projectorIndices[cameraIndex] = (uint32_t)projectorXY.x + (uint32_t)projectorXY.y * payloadWidth;
+						active[cameraIndex] = pixel.active ? 1 : 0;
+						distance[cameraIndex] = pixel.distance;
+					}
+
+					//the median is stored as a single channel
+					const auto & medianPixels = dataSet.getMedian();
+					const auto medianChannels = medianPixels.getNumChannels();
+					for (int i = 0; i < pixelCount; i++) {
+						median[i] = medianPixels.getPixels()[i * medianChannels];
+					}
+
+					//build the header and chunk table
+					Header header;
+					memcpy(header.magic, RULR_COMPACT_DATASET_MAGIC, sizeof(header.magic));
+					header.version = RULR_COMPACT_DATASET_VERSION;
+					header.width = width;
+					header.height = height;
+					header.payloadWidth = payloadWidth;
+					header.payloadHeight = dataSet.getPayloadHeight();
+					header.chunkCount = 4;
+
+					vector<pair<Chunk, const void *>> chunks;
+					auto addChunk = [&chunks](const char * id, const void * data, uint64_t size) {
+						Chunk chunk;
+						memcpy(chunk.id, id, sizeof(chunk.id));
+						chunk.reserved = 0;
+						chunk.offset = 0;
+						chunk.size = size;
+						chunks.push_back(make_pair(chunk, data));
+					};
+					addChunk("PIDX", projectorIndices.data(), projectorIndices.size() * sizeof(uint32_t));
+					addChunk("ACTV", active.data(), active.size());
+					addChunk("DIST", distance.data(), distance.size());
+					addChunk("MEDN", median.data(), median.size());
+
+					auto align = [](uint64_t offset) {
+						return (offset + RULR_COMPACT_DATASET_ALIGNMENT - 1) / RULR_COMPACT_DATASET_ALIGNMENT * RULR_COMPACT_DATASET_ALIGNMENT;
+					};
+					uint64_t offset = align(sizeof(Header) + sizeof(Chunk) * chunks.size());
+					for (auto & chunk : chunks) {
+						chunk.first.offset = offset;
+						offset = align(offset + chunk.first.size);
+					}
+
+					//write the file
+					ofstream file(ofToDataPath(filename).c_str(), ios::binary | ios::out | ios::trunc);
+					if (!file.is_open()) {
+						throw(Exception("Couldn't open " + filename + " for writing"));
+					}
+					file.write((const char *)&header, sizeof(header));
+					for (const auto & chunk : chunks) {
+						file.write((const char *)&chunk.first, sizeof(Chunk));
+					}
+					const char padding[RULR_COMPACT_DATASET_ALIGNMENT] = { 0 };
+					for (const auto & chunk : chunks) {
+						file.write(padding, chunk.first.offset - (uint64_t)file.tellp());
+						file.write((const char *)chunk.second, chunk.first.size);
+					}
+					file.close();
+				}
+
+				//----------
+				CompactDataSet::CompactDataSet() {
+					this->close();
+				}
+
+				//----------
+				bool CompactDataSet::open(const string & filename) {
+					this->close();
+
+					auto path = ofToDataPath(filename);
+					Poco::File file(path);
+					if (!file.exists() || file.getSize() < sizeof(Header)) {
+						return false;
+					}
+
+					try {
+						this->mapping = Poco::SharedMemory(file, Poco::SharedMemory::AM_READ);
+					}
+					catch (const std::exception & e) {
+						RULR_ERROR << "Couldn't map " << filename << " : " << e.what();
+						return false;
+					}
+
+					memcpy(&this->header, this->mapping.begin(), sizeof(Header));
+					if (memcmp(this->header.magic, RULR_COMPACT_DATASET_MAGIC, sizeof(this->header.magic)) != 0
+						|| this->header.version != RULR_COMPACT_DATASET_VERSION) {
+						RULR_ERROR << filename << " is not a compatible compact DataSet file";
+						this->close();
+						return false;
+					}
+
+					const auto pixelCount = (uint64_t) this->header.width * (uint64_t) this->header.height;
+					this->projectorIndices = (const uint32_t *) this->findChunk("PIDX", pixelCount * sizeof(uint32_t));
+					this->active = this->findChunk("ACTV", pixelCount);
+					this->distance = this->findChunk("DIST", pixelCount);
+					this->median = this->findChunk("MEDN", pixelCount);
+					if (!this->projectorIndices || !this->active || !this->distance || !this->median) {
+						RULR_ERROR << filename << " is missing data chunks";
+						this->close();
+						return false;
+					}
+
+					this->filename = filename;
+					return true;
+				}
+
+				//----------
+				void CompactDataSet::close() {
+					this->mapping = Poco::SharedMemory();
+					this->filename = "";
+					memset(&this->header, 0, sizeof(this->header));
+					this->projectorIndices = nullptr;
+					this->active = nullptr;
+					this->distance = nullptr;
+					this->median = nullptr;
+					for (int i = 0; i < PreviewCount; i++) {
+						this->previews[i].clear();
+						this->previewIsBuilt[i] = false;
+					}
+				}
+
+				//----------
+				bool CompactDataSet::isOpen() const {
+					return this->projectorIndices != nullptr;
+				}
+
+				//----------
+				const string & CompactDataSet::getFilename() const {
+					return this->filename;
+				}
+
+				//----------
+				unsigned int CompactDataSet::getWidth() const {
+					return this->header.width;
+				}
+
+				//----------
+				unsigned int CompactDataSet::getHeight() const {
+					return this->header.height;
+				}
+
+				//----------
+				unsigned int CompactDataSet::getPayloadWidth() const {
+					return this->header.payloadWidth;
+				}
+
+				//----------
+				unsigned int CompactDataSet::getPayloadHeight() const {
+					return this->header.payloadHeight;
+				}
+
+				//----------
+				const uint32_t * CompactDataSet::getProjectorIndices() const {
+					return this->projectorIndices;
+				}
+
+				//----------
+				const uint8_t * CompactDataSet::getActive() const {
+					return this->active;
+				}
+
+				//----------
+				const uint8_t * CompactDataSet::getDistance() const {
+					return this->distance;
+				}
+
+				//----------
+				const uint8_t * CompactDataSet::getMedian() const {
+					return this->median;
+				}
+
+				//----------
+				const ofImage & CompactDataSet::getPreview(Preview preview) {
+					if (!this->isOpen()) {
+						throw(Exception("Compact DataSet is not open"));
+					}
+					if (!this->previewIsBuilt[preview]) {
+						this->buildPreview(preview);
+						this->previewIsBuilt[preview] = true;
+					}
+					return this->previews[preview];
+				}
+
+				//----------
+				const uint8_t * CompactDataSet::findChunk(const char * id, uint64_t expectedSize) const {
+					const auto mappedSize = (uint64_t) (this->mapping.end() - this->mapping.begin());
+					auto chunks = (const Chunk *) (this->mapping.begin() + sizeof(Header));
+					if (sizeof(Header) + sizeof(Chunk) * this->header.chunkCount > mappedSize) {
+						return nullptr;
+					}
+					for (uint32_t i = 0; i < this->header.chunkCount; i++) {
+						const auto & chunk = chunks[i];
+						if (memcmp(chunk.id, id, sizeof(chunk.id)) == 0) {
+							if (chunk.size != expectedSize || chunk.offset + chunk.size > mappedSize) {
+								return nullptr;
+							}
+							return (const uint8_t *) this->mapping.begin() + chunk.offset;
+						}
+					}
+					return nullptr;
+				}
+
+				//----------
+				void CompactDataSet::buildPreview(Preview preview) {
+					const auto width = this->header.width;
+					const auto height = this->header.height;
+					const auto pixelCount = width * height;
+					auto & image = this->previews[preview];
+
+					switch (preview) {
+					case Median:
+						image.setFromPixels(this->median, width, height, OF_IMAGE_GRAYSCALE);
+						break;
+					case MedianInverse:
+					{
+						const auto payloadWidth = this->header.payloadWidth;
+						const auto payloadHeight = this->header.payloadHeight;
+						const auto payloadCount = payloadWidth * payloadHeight;
+						image.allocate(payloadWidth, payloadHeight, OF_IMAGE_GRAYSCALE);
+						auto output = image.getPixels();
+						memset(output, 0, payloadCount);
+						for (uint32_t i = 0; i < pixelCount; i++) {
+							if (this->active[i] && this->projectorIndices[i] < payloadCount) {
+								output[this->projectorIndices[i]] = this->median[i];
+							}
+						}
+						image.update();
+						break;
+					}
+					case Active:
+					{
+						image.allocate(width, height, OF_IMAGE_GRAYSCALE);
+						auto output = image.getPixels();
+						for (uint32_t i = 0; i < pixelCount; i++) {
+							output[i] = this->active[i] ? 255 : 0;
+						}
+						image.update();
+						break;
+					}
+					default:
+						break;
+					}
+				}
+			}
+		}
+	}
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+#include "../../../addons/ofxGraycode/src/ofxGraycode.h"
+
+#include "Poco/SharedMemory.h"
+
+namespace ofxRulr {
+	namespace Nodes {
+		namespace Procedure {
+			namespace Scan {
+				/**
+				Chunked binary storage for the results of an ofxGraycode::DataSet.
+				The file is memory mapped when opened, so only the header is read up front.
+				Correspondences and masks are stored as flat per camera pixel arrays, and preview
+				images are built from the mapped arrays the first time they are requested.
+				**/
+				class CompactDataSet {
+				public:
+					enum Preview {
+						Median = 0,
+						MedianInverse,
+						Active,
+						PreviewCount
+					};
+
+					static void save(const ofxGraycode::DataSet &, const string & filename);
+
+					CompactDataSet();
+					bool open(const string & filename);
+					void close();
+					bool isOpen() const;
+					const string & getFilename() const;
+
+					unsigned int getWidth() const;
+					unsigned int getHeight() const;
+					unsigned int getPayloadWidth() const;
+					unsigned int getPayloadHeight() const;
+
+					///Payload pixel index (x + y * payloadWidth) for each camera pixel
+					const uint32_t * getProjectorIndices() const;
+					///Non-zero for each camera pixel which was active at the time of saving
+					const uint8_t * getActive() const;
+					///Contrast between the positive and negative frames for each camera pixel
+					const uint8_t * getDistance() const;
+					///Median brightness for each camera pixel
+					const uint8_t * getMedian() const;
+
+					///Preview images are built on first use and kept until the file is closed
+					const ofImage & getPreview(Preview);
+
+				protected:
+					struct Header {
+						char magic[8];
+						uint32_t version;
+						uint32_t width;
+						uint32_t height;
+						uint32_t payloadWidth;
+						uint32_t payloadHeight;
+						uint32_t chunkCount;
+					};
+
+					struct Chunk {
+						char id[4];
+						uint32_t reserved;
+						uint64_t offset;
+						uint64_t size;
+					};
+
+					const uint8_t * findChunk(const char * id, uint64_t expectedSize) const;
+					void buildPreview(Preview);
+
+					Poco::SharedMemory mapping;
+					string filename;
+					Header header;
+
+					const uint32_t * projectorIndices;
+					const uint8_t * active;
+					const uint8_t * distance;
+					const uint8_t * median;
+
+					ofImage previews[PreviewCount];
+					bool previewIsBuilt[PreviewCount];
+				};
+			}
+		}
+	}
+}
@@ -1,278 +1,1001 @@
-#include "Graycode.h"
-
-#include "../../Item/Camera.h"
-#include "../../Device/VideoOutput.h"
-#include "ofxRulr/Exception.h"
-
-#include "ofxCvGui.h"
-
-#include "ofAppGLFWWindow.h"
-
-using namespace ofxRulr::Graph;
-using namespace ofxRulr::Nodes;
-using namespace ofxCvGui;
-
-namespace ofxRulr {
-	namespace Nodes {
-		namespace Procedure {
-			namespace Scan {
-				//---------
-				Graycode::Graycode() {
-					RULR_NODE_INIT_LISTENER;
-				}
-
-				//----------
-				void Graycode::init() {
-					RULR_NODE_UPDATE_LISTENER;
-					RULR_NODE_SERIALIZATION_LISTENERS;
-					RULR_NODE_INSPECTOR_LISTENER;
-
-					this->addInput(MAKE(Pin<Item::Camera>));
-					auto videoOutputPin = MAKE(Pin<Device::VideoOutput>);
-					this->addInput(videoOutputPin);
-
-					this->threshold.set("Threshold", 10.0f, 0.0f, 255.0f);
-					this->delay.set("Capture delay [ms]", 200.0f, 0.0f, 2000.0f);
-					this->brightness.set("Brightness [/255]", 255.0f, 0.0f, 255.0f);
-					this->enablePreviewOnVideoOutput.set("Enable preview on output", false);
-
-					this->payload.init(1, 1);
-					this->decoder.init(payload);
-					this->encoder.init(payload);
-
-					this->view = MAKE(Panels::Image, this->decoder.getProjectorInCamera());
-
-					videoOutputPin->onNewConnection += [this](shared_ptr<Device::VideoOutput> videoOutput) {
-						videoOutput->onDrawOutput.addListener([this](ofRectangle & rectangle) {
-							if (this->enablePreviewOnVideoOutput) {
-								this->drawPreviewOnVideoOutput(rectangle);
-							}
-						}, this);
-					};
-
-					videoOutputPin->onDeleteConnection += [this](shared_ptr<Device::VideoOutput> videoOutput) {
-						if (videoOutput) {
-							videoOutput->onDrawOutput.removeListeners(this);
-						}
-					};
-
-					this->previewIsOfNonLivePixels = false;
-				}
-
-				//----------
-				string Graycode::getTypeName() const {
-					return "Procedure::Scan::Graycode";
-				}
-
-				//----------
-				PanelPtr Graycode::getView() {
-					return this->view;
-				}
-
-				//----------
-				void Graycode::update() {
-					this->decoder.update();
-				}
-
-				//----------
-				void Graycode::serialize(Json::Value & json) {
-					Utils::Serializable::serialize(this->threshold, json);
-					Utils::Serializable::serialize(this->delay, json);
-					Utils::Serializable::serialize(this->brightness, json);
-					auto filename = ofFilePath::removeExt(this->getDefaultFilename()) + ".sl";
-					this->decoder.saveDataSet(filename);
-
-					Utils::Serializable::serialize(this->enablePreviewOnVideoOutput, json);
-				}
-
-				//----------
-				void Graycode::deserialize(const Json::Value & json) {
-					auto filename = ofFilePath::removeExt(this->getDefaultFilename()) + ".sl";
-					this->decoder.loadDataSet(filename, false);
-					Utils::Serializable::deserialize(this->threshold, json);
-					this->decoder.setThreshold(this->threshold);
-					Utils::Serializable::deserialize(this->delay, json);
-					Utils::Serializable::deserialize(this->brightness, json);
-
-					Utils::Serializable::deserialize(this->enablePreviewOnVideoOutput, json);
-				}
-
-				//----------
-				bool Graycode::isReady() {
-					return (this->getInput<Item::Camera>() && this->getInput<Device::VideoOutput>() && this->payload.isAllocated());
-				}
-
-				//----------
-				void Graycode::runScan() {
-					//safety checks
-					this->throwIfMissingAnyConnection();
-
-					//get variables
-					auto camera = this->getInput<Item::Camera>();
-					auto videoOutput = this->getInput<Device::VideoOutput>();
-					auto videoOutputSize = videoOutput->getSize();
-					auto grabber = camera->getGrabber();
-
-					//check that the window is open
-					if (!videoOutput->isWindowOpen()) {
-						throw(Exception("Cannot run Graycode scan whilst the VideoOutput's window isn't open"));
-					}
-
-					//initialise payload
-					this->payload.init(videoOutputSize.getWidth(), videoOutputSize.getHeight());
-					this->encoder.init(payload);
-					this->decoder.init(payload);
-
-					//initialise scan
-					this->encoder.reset();
-					this->decoder.reset();
-					this->decoder.setThreshold(this->threshold);
-					this->message.clear();
-
-					ofHideCursor();
-
-					while (this->encoder >> this->message) {
-						videoOutput->clearFbo(false);
-						videoOutput->begin();
-						//
-						ofPushStyle();
-						auto brightness = this->brightness;
-						ofSetColor(brightness);
-						this->message.draw(0, 0);
-						ofPopStyle();
-						//
-						videoOutput->end();
-						videoOutput->presentFbo();
-
-						stringstream message;
-						message << this->getName() << " scanning " << this->encoder.getFrame() << "/" << this->encoder.getFrameCount();
-						ofxCvGui::Utils::drawProcessingNotice(message.str());
-
-						auto startWait = ofGetElapsedTimeMillis();
-						while (ofGetElapsedTimeMillis() - startWait < this->delay) {
-							ofSleepMillis(1);
-							grabber->update();
-						}
-
-						auto frame = grabber->getFreshFrame();
-						this->decoder << frame->getPixels();
-					}
-
-					ofShowCursor();
-
-					this->switchIfLookingAtDirtyView();
-				}
-
-				//----------
-				ofxGraycode::Decoder & Graycode::getDecoder() {
-					return this->decoder;
-				}
-
-				//----------
-				const ofxGraycode::DataSet & Graycode::getDataSet() const {
-					if (!this->decoder.hasData()) {
-						throw(Exception("Can't get DataSet from Graycode node, no data available"));
-					}
-					return this->decoder.getDataSet();
-				}
-
-				//----------
-				void Graycode::drawPreviewOnVideoOutput(const ofRectangle & rectangle) {
-					auto preview = this->view->getImage();
-					if (preview) {
-						preview->draw(rectangle);
-					}
-				}
-
-				//----------
-				void Graycode::populateInspector(ElementGroupPtr inspector) {
-					auto scanButton = Widgets::Button::make("SCAN", [this]() {
-						try {
-							this->runScan();
-						}
-						RULR_CATCH_ALL_TO_ALERT
-					}, OF_KEY_RETURN);
-					scanButton->setHeight(100.0f);
-					inspector->add(scanButton);
-					inspector->add(Widgets::Button::make("Clear", [this]() {
-						this->decoder.clear();
-						this->preview.clear();
-					}));
-					inspector->add(Widgets::Button::make("Save ofxGraycode::DataSet...", [this]() {
-						if (this->decoder.hasData()) {
-							this->decoder.saveDataSet();
-							this->decoder.savePreviews();
-						}
-						else {
-							ofSystemAlertDialog("No data to save yet. Have you scanned?");
-						}
-					}));
-					inspector->add(Widgets::Button::make("Load ofxGraycode::DataSet...", [this]() {
-						this->decoder.loadDataSet();
-					}));
-
-					inspector->add(Widgets::Title::make("Decoder", Widgets::Title::Level::H2));
-					inspector->add(Widgets::LiveValue<string>::make("Has data", [this]() {
-						return this->decoder.hasData() ? "True" : "False";
-					}));
-					inspector->add(Widgets::Slider::make(this->delay));
-					auto thresholdSlider = Widgets::Slider::make(this->threshold);
-					thresholdSlider->addIntValidator();
-					thresholdSlider->onValueChange += [this](ofParameter<float> &) {
-						this->decoder.setThreshold(this->threshold);
-						this->switchIfLookingAtDirtyView();
-					};
-					inspector->add(thresholdSlider);
-					auto brightnessSlider = Widgets::Slider::make(this->brightness);
-					brightnessSlider->addIntValidator();
-					inspector->add(brightnessSlider);
-
-					inspector->add(Widgets::Title::make("Payload", Widgets::Title::Level::H2));
-					inspector->add(Widgets::LiveValue<unsigned int>::make("Width", [this]() { return this->payload.getWidth(); }));
-					inspector->add(Widgets::LiveValue<unsigned int>::make("Height", [this]() { return this->payload.getHeight(); }));
-
-					inspector->add(Widgets::Spacer::make());
-					inspector->add(Widgets::Title::make("Views", Widgets::Title::Level::H2));
-					inspector->add(Widgets::Button::make("Camera in Projector", [this]() {
-						this->view->setImage(this->decoder.getCameraInProjector());
-						this->previewIsOfNonLivePixels = false;
-					}));
-					inspector->add(Widgets::Button::make("Projector in Camera", [this]() {
-						this->view->setImage(this->decoder.getProjectorInCamera());
-						this->previewIsOfNonLivePixels = false;
-					}));
-					inspector->add(Widgets::Button::make("Median", [this]() {
-						this->preview = this->decoder.getDataSet().getMedian();
-						this->preview.update();
-						this->view->setImage(this->preview);
-						this->previewIsOfNonLivePixels = true;
-					}));
-					inspector->add(Widgets::Button::make("Median Inverse", [this]() {
-						this->preview = this->decoder.getDataSet().getMedianInverse();
-						this->preview.update();
-						this->view->setImage(this->preview);
-						this->previewIsOfNonLivePixels = true;
-					}));
-					inspector->add(Widgets::Button::make("Active", [this]() {
-						this->preview = this->decoder.getDataSet().getActive();
-						this->preview.update();
-						this->view->setImage(this->preview);
-						this->previewIsOfNonLivePixels = true;
-					}));
-
-					inspector->add(Widgets::Spacer::make());
-
-					inspector->add(Widgets::Toggle::make(this->enablePreviewOnVideoOutput));
-				}
-
-				//----------
-				void Graycode::switchIfLookingAtDirtyView() {
-					if (this->previewIsOfNonLivePixels) {
-						this->view->setImage(this->decoder.getProjectorInCamera());
-						this->previewIsOfNonLivePixels = false;
-					}
-				}
-			}
-		}
-	}
+#include "Graycode.h"
+
+#include "../../Item/Camera.h"
+#include "../../Device/VideoOutput.h"
+#include "ofxRulr/Exception.h"
+
+#include "ofxCvGui.h"
+#include "ofxCvMin.h"
+
+#include "ofAppGLFWWindow.h"
+
+using namespace ofxRulr::Graph;
+using namespace ofxRulr::Nodes;
+using namespace ofxCvGui;
+
+namespace ofxRulr {
+	namespace Nodes {
+		namespace Procedure {
+			namespace Scan {
+				//---------
+				Graycode::Graycode() {
+					RULR_NODE_INIT_LISTENER;
+				}
+
+				//----------
+				void Graycode::init() {
+					RULR_NODE_UPDATE_LISTENER;
+					RULR_NODE_SERIALIZATION_LISTENERS;
+					RULR_NODE_INSPECTOR_LISTENER;
+
+					this->addInput(MAKE(Pin<Item::Camera>));
+					auto videoOutputPin = MAKE(Pin<Device::VideoOutput>);
+					this->addInput(videoOutputPin);
+
+					this->threshold.set("Threshold", 10.0f, 0.0f, 255.0f);
+					this->delay.set("Capture delay [ms]", 200.0f, 0.0f, 2000.0f);
+					this->brightness.set("Brightness [/255]", 255.0f, 0.0f, 255.0f);
+					this->enablePreviewOnVideoOutput.set("Enable preview on output", false);
+					this->payloadMode.set("Payload mode", 0, 0, 2);
+					this->cellSize.set("Coarse cell size [px]", 16, 2, 256);
+					this->phaseSteps.set("Phase shift steps", 4, 3, 16);
+					this->enableRoi.set("Enable ROI", false);
+					this->projectorRoi.set("Projector ROI [px]", ofRectangle(0, 0, 1024, 768));
+					this->cameraRoi.set("Camera ROI [px]", ofRectangle(0, 0, 1280, 720));
+					this->roiMargin.set("ROI margin [px]", 32.0f, 0.0f, 512.0f);
+
+					this->scanned.payloadMode = 0;
+					this->scanned.cellSize = 1;
+					this->scanned.projectorSize = ofVec2f(1, 1);
+					this->scanned.cameraSize = ofVec2f(1, 1);
+					this->scanned.projectorRoi = ofRectangle(0, 0, 1, 1);
+					this->scanned.cameraRoi = ofRectangle(0, 0, 1, 1);
+
+					this->payload.init(1, 1);
+					this->decoder.init(payload);
+					this->encoder.init(payload);
+
+					this->view = MAKE(Panels::Image, this->decoder.getProjectorInCamera());
+
+					videoOutputPin->onNewConnection += [this](shared_ptr<Device::VideoOutput> videoOutput) {
+						videoOutput->onDrawOutput.addListener([this](ofRectangle & rectangle) {
+							if (this->enablePreviewOnVideoOutput) {
+								this->drawPreviewOnVideoOutput(rectangle);
+							}
+						}, this);
+					};
+
+					videoOutputPin->onDeleteConnection += [this](shared_ptr<Device::VideoOutput> videoOutput) {
+						if (videoOutput) {
+							videoOutput->onDrawOutput.removeListeners(this);
+						}
+					};
+
+					this->previewIsOfNonLivePixels = false;
+					this->dataSetLoadPending = false;
+					this->dataSetIsDirty = false;
+					this->invalidatePreviews();
+
+					this->dataVersion = 0;
+					this->correspondencesVersion = 0;
+				}
+
+				//----------
+				string Graycode::getTypeName() const {
+					return "Procedure::Scan::Graycode";
+				}
+
+				//----------
+				PanelPtr Graycode::getView() {
+					return this->view;
+				}
+
+				//----------
+				void Graycode::update() {
+					this->decoder.update();
+				}
+
+				//----------
+				void Graycode::serialize(Json::Value & json) {
+					Utils::Serializable::serialize(this->threshold, json);
+					Utils::Serializable::serialize(this->delay, json);
+					Utils::Serializable::serialize(this->brightness, json);
+
+					Utils::Serializable::serialize(this->enablePreviewOnVideoOutput, json);
+					Utils::Serializable::serialize(this->payloadMode, json);
+					Utils::Serializable::serialize(this->cellSize, json);
+					Utils::Serializable::serialize(this->phaseSteps, json);
+					Utils::Serializable::serialize(this->enableRoi, json);
+					Utils::Serializable::serialize(this->projectorRoi, json);
+					Utils::Serializable::serialize(this->cameraRoi, json);
+					Utils::Serializable::serialize(this->roiMargin, json);
+
+					auto & jsonScanned = json["scanned"];
+					jsonScanned["payloadMode"] = this->scanned.payloadMode;
+					jsonScanned["cellSize"] = this->scanned.cellSize;
+					jsonScanned["projectorSize"] << this->scanned.projectorSize;
+					jsonScanned["cameraSize"] << this->scanned.cameraSize;
+					jsonScanned["projectorRoi"] << this->scanned.projectorRoi;
+					jsonScanned["cameraRoi"] << this->scanned.cameraRoi;
+
+					//write the scan data when it has changed since it was last saved or loaded, when this save goes somewhere
+					// other than where our data lives (e.g. the node was renamed or the patch saved elsewhere), or when the files are missing
+					auto filenameBase = ofFilePath::removeExt(this->getDefaultFilename());
+					auto filesMatchData = this->hasData() == ofFile::doesFileExist(filenameBase + ".rulr-sl");
+					if (this->dataSetIsDirty || filenameBase != this->dataSetFilenameBase || !filesMatchData) {
+						//anything we haven't read yet has to come from where it currently lives
+						this->loadDataSetIfPending();
+						this->compactDataSet.close();
+
+						auto removeFile = [&filenameBase](const string & extension) {
+							auto filename = filenameBase + extension;
+							if (ofFile::doesFileExist(filename)) {
+								ofFile::removeFile(filename);
+							}
+						};
+
+						if (this->decoder.hasData()) {
+							//the .sl is the full DataSet which getDataSet reads back. the .rulr-sl is what we map for everything else
+							this->decoder.saveDataSet(filenameBase + ".sl");
+							CompactDataSet::save(this->decoder.getDataSet(), filenameBase + ".rulr-sl");
+							this->compactDataSet.open(filenameBase + ".rulr-sl");
+							if (this->scanned.payloadMode == 2) {
+								this->savePhaseShift(filenameBase + ".phase");
+							}
+							else {
+								removeFile(".phase");
+							}
+						}
+						else {
+							for (auto extension : { ".sl", ".rulr-sl", ".phase" }) {
+								removeFile(extension);
+							}
+						}
+						this->dataSetFilenameBase = filenameBase;
+						this->dataSetIsDirty = false;
+						this->invalidatePreviews();
+					}
+				}
+
+				//----------
+				void Graycode::deserialize(const Json::Value & json) {
+					auto filenameBase = ofFilePath::removeExt(this->getDefaultFilename());
+					this->decoder.clear();
+					this->invalidatePreviews();
+					this->dataVersion++;
+					this->dataSetFilenameBase = filenameBase;
+					if (this->compactDataSet.open(filenameBase + ".rulr-sl")) {
+						//the full DataSet is only read when something asks for it
+						this->dataSetLoadPending = true;
+						this->dataSetIsDirty = false;
+					}
+					else {
+						//saves from before the compact format are read in full, and converted on the next save
+						this->decoder.loadDataSet(filenameBase + ".sl", false);
+						this->dataSetLoadPending = false;
+						this->dataSetIsDirty = this->decoder.hasData();
+					}
+					Utils::Serializable::deserialize(this->threshold, json);
+					this->decoder.setThreshold(this->threshold);
+					Utils::Serializable::deserialize(this->delay, json);
+					Utils::Serializable::deserialize(this->brightness, json);
+
+					Utils::Serializable::deserialize(this->enablePreviewOnVideoOutput, json);
+					Utils::Serializable::deserialize(this->payloadMode, json);
+					Utils::Serializable::deserialize(this->cellSize, json);
+					Utils::Serializable::deserialize(this->phaseSteps, json);
+					Utils::Serializable::deserialize(this->enableRoi, json);
+					Utils::Serializable::deserialize(this->projectorRoi, json);
+					Utils::Serializable::deserialize(this->cameraRoi, json);
+					Utils::Serializable::deserialize(this->roiMargin, json);
+
+					const auto & jsonScanned = json["scanned"];
+					if (!jsonScanned.isNull()) {
+						this->scanned.payloadMode = jsonScanned["payloadMode"].asInt();
+						this->scanned.cellSize = jsonScanned["cellSize"].asInt();
+						jsonScanned["projectorSize"] >> this->scanned.projectorSize;
+					}
+					else {
+						//older saves only contain full resolution graycode data
+						this->scanned.payloadMode = 0;
+						this->scanned.cellSize = 1;
+						if (this->decoder.hasData()) {
+							const auto & dataSet = this->decoder.getDataSet();
+							this->scanned.projectorSize = ofVec2f(dataSet.getPayloadWidth(), dataSet.getPayloadHeight());
+						}
+					}
+
+					if (!jsonScanned["cameraRoi"].isNull()) {
+						jsonScanned["cameraSize"] >> this->scanned.cameraSize;
+						jsonScanned["projectorRoi"] >> this->scanned.projectorRoi;
+						jsonScanned["cameraRoi"] >> this->scanned.cameraRoi;
+					}
+					else {
+						//saves from before ROI scanning are full frame
+						this->scanned.projectorRoi = ofRectangle(0, 0, this->scanned.projectorSize.x, this->scanned.projectorSize.y);
+						if (this->decoder.hasData()) {
+							const auto & dataSet = this->decoder.getDataSet();
+							this->scanned.cameraSize = ofVec2f(dataSet.getWidth(), dataSet.getHeight());
+						}
+						this->scanned.cameraRoi = ofRectangle(0, 0, this->scanned.cameraSize.x, this->scanned.cameraSize.y);
+					}
+
+					this->phaseShiftProjectorXY.clear();
+					if (this->scanned.payloadMode == 2) {
+						this->loadPhaseShift(filenameBase + ".phase");
+					}
+				}
+
+				//----------
+				bool Graycode::isReady() {
+					return (this->getInput<Item::Camera>() && this->getInput<Device::VideoOutput>() && this->payload.isAllocated());
+				}
+
+				//----------
+				void Graycode::runScan() {
+					//safety checks
+					this->throwIfMissingAnyConnection();
+
+					//get variables
+					auto camera = this->getInput<Item::Camera>();
+					auto videoOutput = this->getInput<Device::VideoOutput>();
+					auto videoOutputSize = videoOutput->getSize();
+					auto grabber = camera->getGrabber();
+
+					//check that the window is open
+					if (!videoOutput->isWindowOpen()) {
+						throw(Exception("Cannot run Graycode scan whilst the VideoOutput's window isn't open"));
+					}
+
+					//get regions of interest
+					auto projectorSize = ofVec2f(videoOutputSize.getWidth(), videoOutputSize.getHeight());
+					auto cameraSize = ofVec2f(grabber->getWidth(), grabber->getHeight());
+					auto projectorRoi = ofRectangle(0, 0, projectorSize.x, projectorSize.y);
+					auto cameraRoi = ofRectangle(0, 0, cameraSize.x, cameraSize.y);
+					if (this->enableRoi) {
+						projectorRoi = this->getClippedRoi(this->projectorRoi, projectorSize);
+						cameraRoi = this->getClippedRoi(this->cameraRoi, cameraSize);
+						if (projectorRoi.isEmpty() || cameraRoi.isEmpty()) {
+							throw(Exception("Graycode ROI lies outside of the VideoOutput or camera image"));
+						}
+					}
+
+					//settings for this scan. these only become our scanned settings once the scan has succeeded
+					ScanSettings scanning;
+					scanning.payloadMode = this->payloadMode;
+					scanning.cellSize = this->payloadMode == 0 ? 1 : max(this->cellSize.get(), 1);
+					scanning.projectorSize = projectorSize;
+					scanning.cameraSize = cameraSize;
+					scanning.projectorRoi = projectorRoi;
+					scanning.cameraRoi = cameraRoi;
+
+					//initialise payload
+					this->initPayload(ofVec2f(projectorRoi.width, projectorRoi.height));
+					this->encoder.init(payload);
+					this->decoder.init(payload);
+					this->phaseShiftProjectorXY.clear();
+					this->dataSetLoadPending = false;
+					this->markDataSetDirty();
+
+					//initialise scan
+					this->encoder.reset();
+					this->decoder.reset();
+					this->decoder.setThreshold(this->threshold);
+					this->message.clear();
+
+					ofHideCursor();
+
+					try {
+						this->captureAndDecode(camera, videoOutput, scanning);
+					}
+					catch (...) {
+						//don't leave a partial scan behind
+						ofShowCursor();
+						this->decoder.clear();
+						this->phaseShiftProjectorXY.clear();
+						this->markDataSetDirty();
+						this->switchIfLookingAtDirtyView();
+						throw;
+					}
+
+					ofShowCursor();
+
+					this->scanned = scanning;
+					this->markDataSetDirty();
+
+					this->switchIfLookingAtDirtyView();
+				}
+
+				//----------
+				void Graycode::captureAndDecode(shared_ptr<Item::Camera> camera, shared_ptr<Device::VideoOutput> videoOutput, const ScanSettings & scanning) {
+					auto grabber = camera->getGrabber();
+					const auto & projectorRoi = scanning.projectorRoi;
+
+					while (this->encoder >> this->message) {
+						videoOutput->clearFbo(false);
+						videoOutput->begin();
+						//
+						ofPushStyle();
+						auto brightness = this->brightness;
+						ofSetColor(brightness);
+						//each payload pixel covers exactly one cell of the output, starting at the ROI origin. cells overhanging the ROI are clipped
+						const auto cellSize = (float) scanning.cellSize;
+						this->message.getTextureReference().setTextureMinMagFilter(GL_NEAREST, GL_NEAREST);
+						this->message.drawSubsection(projectorRoi.x, projectorRoi.y, projectorRoi.width, projectorRoi.height
+							, 0, 0, projectorRoi.width / cellSize, projectorRoi.height / cellSize);
+						ofPopStyle();
+						//
+						videoOutput->end();
+						videoOutput->presentFbo();
+
+						stringstream message;
+						message << this->getName() << " scanning " << this->encoder.getFrame() << "/" << this->encoder.getFrameCount();
+						ofxCvGui::Utils::drawProcessingNotice(message.str());
+
+						auto startWait = ofGetElapsedTimeMillis();
+						while (ofGetElapsedTimeMillis() - startWait < this->delay) {
+							ofSleepMillis(1);
+							grabber->update();
+						}
+
+						auto frame = camera->getFreshFrame();
+						if (!frame) {
+							throw(Exception("Camera returned no frame"));
+						}
+						if (scanning.cameraRoi != ofRectangle(0, 0, scanning.cameraSize.x, scanning.cameraSize.y)) {
+							ofPixels cropped;
+							this->cropToCameraRoi(frame->getPixels(), scanning, cropped);
+							this->decoder << cropped;
+						}
+						else {
+							this->decoder << frame->getPixels();
+						}
+					}
+
+					if (scanning.payloadMode == 2) {
+						vector<ofPixels> capturesX, capturesY;
+						this->capturePhaseShift(videoOutput, scanning, true, capturesX);
+						this->capturePhaseShift(videoOutput, scanning, false, capturesY);
+
+						ofxCvGui::Utils::drawProcessingNotice(this->getName() + " decoding phase shift");
+						this->decodePhaseShift(scanning, capturesX, capturesY);
+					}
+				}
+
+				//----------
+				bool Graycode::hasData() const {
+					return this->dataSetLoadPending || this->decoder.hasData();
+				}
+
+				//----------
+				bool Graycode::getIsDataSetLoaded() const {
+					return !this->dataSetLoadPending && this->decoder.hasData();
+				}
+
+				//----------
+				ofxGraycode::Decoder & Graycode::getDecoder() {
+					this->loadDataSetIfPending();
+					return this->decoder;
+				}
+
+				//----------
+				const ofxGraycode::DataSet & Graycode::getDataSet() const {
+					this->loadDataSetIfPending();
+					if (!this->decoder.hasData()) {
+						throw(Exception("Can't get DataSet from Graycode node, no data available"));
+					}
+					return this->decoder.getDataSet();
+				}
+
+				//----------
+				ofImage & Graycode::getPreview(CompactDataSet::Preview preview) {
+					if (this->compactDataSet.isOpen() && !this->dataSetIsDirty) {
+						return this->compactDataSet.getPreview(preview);
+					}
+
+					auto & livePreview = this->livePreviews[preview];
+					if (!this->livePreviewIsBuilt[preview]) {
+						const auto & dataSet = this->getDataSet();
+						switch (preview) {
+						case CompactDataSet::Median:
+							livePreview = dataSet.getMedian();
+							break;
+						case CompactDataSet::MedianInverse:
+							livePreview = dataSet.getMedianInverse();
+							break;
+						case CompactDataSet::Active:
+							livePreview = dataSet.getActive();
+							break;
+						default:
+							break;
+						}
+						livePreview.update();
+						this->livePreviewIsBuilt[preview] = true;
+					}
+					return livePreview;
+				}
+
+				//----------
+				const Graycode::Correspondences & Graycode::getCorrespondences() {
+					if (this->correspondencesVersion != this->dataVersion) {
+						this->buildCorrespondences();
+						this->correspondencesVersion = this->dataVersion;
+					}
+					return this->correspondences;
+				}
+
+				//----------
+				unsigned int Graycode::getDataVersion() const {
+					return this->dataVersion;
+				}
+
+				//----------
+				ofVec2f Graycode::getProjectorSize() const {
+					return this->scanned.projectorSize;
+				}
+
+				//----------
+				ofVec2f Graycode::getCameraSize() const {
+					return this->scanned.cameraSize;
+				}
+
+				//----------
+				ofRectangle Graycode::getProjectorRoi() const {
+					return this->scanned.projectorRoi;
+				}
+
+				//----------
+				ofRectangle Graycode::getCameraRoi() const {
+					return this->scanned.cameraRoi;
+				}
+
+				//----------
+				ofVec2f Graycode::getCameraXY(const ofVec2f & dataSetCameraXY) const {
+					return dataSetCameraXY + this->scanned.cameraRoi.getPosition();
+				}
+
+				//----------
+				ofVec2f Graycode::getProjectorXY(const ofVec2f & dataSetCameraXY, const ofVec2f & dataSetProjectorXY) const {
+					ofVec2f projectorXYInRoi;
+					switch (this->scanned.payloadMode) {
+					case 1:
+						//center of the coarse cell
+						projectorXYInRoi = (dataSetProjectorXY + 0.5f) * this->scanned.cellSize - 0.5f;
+						break;
+					case 2:
+						if (this->phaseShiftProjectorXY.isAllocated()) {
+							auto pixel = this->phaseShiftProjectorXY.getPixels() + ((int)dataSetCameraXY.x + (int)dataSetCameraXY.y * this->phaseShiftProjectorXY.getWidth()) * 2;
+							projectorXYInRoi = ofVec2f(pixel[0], pixel[1]);
+						}
+						else {
+							projectorXYInRoi = (dataSetProjectorXY + 0.5f) * this->scanned.cellSize - 0.5f;
+						}
+						break;
+					case 0:
+					default:
+						projectorXYInRoi = dataSetProjectorXY;
+						break;
+					}
+					return projectorXYInRoi + this->scanned.projectorRoi.getPosition();
+				}
+
+				//----------
+				bool Graycode::getIsFullResolution() const {
+					return this->scanned.payloadMode == 0
+						&& this->scanned.projectorRoi == ofRectangle(0, 0, this->scanned.projectorSize.x, this->scanned.projectorSize.y)
+						&& this->scanned.cameraRoi == ofRectangle(0, 0, this->scanned.cameraSize.x, this->scanned.cameraSize.y);
+				}
+
+				//----------
+				void Graycode::drawPreviewOnVideoOutput(const ofRectangle & rectangle) {
+					auto preview = this->view->getImage();
+					if (preview) {
+						preview->draw(rectangle);
+					}
+				}
+
+				//----------
+				void Graycode::populateInspector(ElementGroupPtr inspector) {
+					auto scanButton = Widgets::Button::make("SCAN", [this]() {
+						try {
+							this->runScan();
+						}
+						RULR_CATCH_ALL_TO_ALERT
+					}, OF_KEY_RETURN);
+					scanButton->setHeight(100.0f);
+					inspector->add(scanButton);
+					inspector->add(Widgets::Button::make("Clear", [this]() {
+						this->decoder.clear();
+						this->compactDataSet.close();
+						this->dataSetLoadPending = false;
+						this->markDataSetDirty();
+						this->phaseShiftProjectorXY.clear();
+						this->switchIfLookingAtDirtyView();
+					}));
+					inspector->add(Widgets::Button::make("Save ofxGraycode::DataSet...", [this]() {
+						if (this->hasData()) {
+							auto & decoder = this->getDecoder();
+							decoder.saveDataSet();
+							decoder.savePreviews();
+						}
+						else {
+							ofSystemAlertDialog("No data to save yet. Have you scanned?");
+						}
+					}));
+					inspector->add(Widgets::Button::make("Load ofxGraycode::DataSet...", [this]() {
+						this->decoder.loadDataSet();
+						this->dataSetLoadPending = false;
+						this->markDataSetDirty();
+						this->switchIfLookingAtDirtyView();
+					}));
+
+					inspector->add(Widgets::Title::make("Decoder", Widgets::Title::Level::H2));
+					inspector->add(Widgets::LiveValue<string>::make("Has data", [this]() {
+						if (!this->hasData()) {
+							return "False";
+						}
+						return this->getIsDataSetLoaded() ? "True" : "True (not loaded)";
+					}));
+					inspector->add(Widgets::Slider::make(this->delay));
+					auto thresholdSlider = Widgets::Slider::make(this->threshold);
+					thresholdSlider->addIntValidator();
+					thresholdSlider->onValueChange += [this](ofParameter<float> &) {
+						if (this->hasData()) {
+							this->getDecoder().setThreshold(this->threshold);
+							this->markDataSetDirty();
+						}
+						this->switchIfLookingAtDirtyView();
+					};
+					inspector->add(thresholdSlider);
+					auto brightnessSlider = Widgets::Slider::make(this->brightness);
+					brightnessSlider->addIntValidator();
+					inspector->add(brightnessSlider);
+
+					inspector->add(Widgets::Title::make("Payload", Widgets::Title::Level::H2));
+					auto payloadModeChooser = make_shared<Widgets::MultipleChoice>("Payload mode");
+					payloadModeChooser->addOption("Graycode");
+					payloadModeChooser->addOption("Coarse");
+					payloadModeChooser->addOption("Coarse + phase");
+					payloadModeChooser->setSelection(this->payloadMode);
+					payloadModeChooser->onValueChange += [this](const int & selectionIndex) {
+						this->payloadMode = selectionIndex;
+					};
+					inspector->add(payloadModeChooser);
+					inspector->add(Widgets::EditableValue<int>::make(this->cellSize));
+					inspector->add(Widgets::EditableValue<int>::make(this->phaseSteps));
+					inspector->add(Widgets::LiveValue<unsigned int>::make("Frames for next scan", [this]() { return this->getPlannedFrameCount(); }));
+					inspector->add(Widgets::LiveValue<unsigned int>::make("Width", [this]() { return this->payload.getWidth(); }));
+					inspector->add(Widgets::LiveValue<unsigned int>::make("Height", [this]() { return this->payload.getHeight(); }));
+
+					inspector->add(Widgets::Title::make("Region of interest", Widgets::Title::Level::H2));
+					inspector->add(Widgets::Toggle::make(this->enableRoi));
+					inspector->add(Widgets::EditableValue<ofRectangle>::make(this->projectorRoi));
+					inspector->add(Widgets::EditableValue<ofRectangle>::make(this->cameraRoi));
+					inspector->add(Widgets::Slider::make(this->roiMargin));
+					inspector->add(Widgets::Button::make("Fit ROIs to current data", [this]() {
+						try {
+							this->fitRoisToDataSet();
+						}
+						RULR_CATCH_ALL_TO_ALERT
+					}));
+
+					inspector->add(Widgets::Spacer::make());
+					inspector->add(Widgets::Title::make("Views", Widgets::Title::Level::H2));
+					inspector->add(Widgets::Button::make("Camera in Projector", [this]() {
+						this->view->setImage(this->getDecoder().getCameraInProjector());
+						this->previewIsOfNonLivePixels = false;
+					}));
+					inspector->add(Widgets::Button::make("Projector in Camera", [this]() {
+						this->view->setImage(this->getDecoder().getProjectorInCamera());
+						this->previewIsOfNonLivePixels = false;
+					}));
+					inspector->add(Widgets::Button::make("Median", [this]() {
+						try {
+							this->view->setImage(this->getPreview(CompactDataSet::Median));
+							this->previewIsOfNonLivePixels = true;
+						}
+						RULR_CATCH_ALL_TO_ALERT
+					}));
+					inspector->add(Widgets::Button::make("Median Inverse", [this]() {
+						try {
+							this->view->setImage(this->getPreview(CompactDataSet::MedianInverse));
+							this->previewIsOfNonLivePixels = true;
+						}
+						RULR_CATCH_ALL_TO_ALERT
+					}));
+					inspector->add(Widgets::Button::make("Active", [this]() {
+						try {
+							this->view->setImage(this->getPreview(CompactDataSet::Active));
+							this->previewIsOfNonLivePixels = true;
+						}
+						RULR_CATCH_ALL_TO_ALERT
+					}));
+
+					inspector->add(Widgets::Spacer::make());
+
+					inspector->add(Widgets::Toggle::make(this->enablePreviewOnVideoOutput));
+				}
+
+				//----------
+				ofRectangle Graycode::getClippedRoi(const ofRectangle & roi, const ofVec2f & frameSize) const {
+					auto clipped = roi.getIntersection(ofRectangle(0, 0, frameSize.x, frameSize.y));
+					//snap to whole pixels
+					auto x = (int)floor(clipped.x);
+					auto y = (int)floor(clipped.y);
+					auto width = (int)ceil(clipped.getRight()) - x;
+					auto height = (int)ceil(clipped.getBottom()) - y;
+					return ofRectangle(x, y, max(width, 0), max(height, 0));
+				}
+
+				//----------
+				void Graycode::fitRoisToDataSet() {
+					const auto & correspondences = this->getCorrespondences();
+					if (correspondences.empty()) {
+						throw(Exception("No active pixels in the DataSet to fit the ROIs to"));
+					}
+
+					ofVec2f cameraMin(std::numeric_limits<float>::max()), cameraMax(-std::numeric_limits<float>::max());
+					ofVec2f projectorMin = cameraMin, projectorMax = cameraMax;
+					for (size_t i = 0; i < correspondences.size(); i++) {
+						const auto & cameraXY = correspondences.cameraXY[i];
+						const auto & projectorXY = correspondences.projectorXY[i];
+						cameraMin.x = min(cameraMin.x, cameraXY.x);
+						cameraMin.y = min(cameraMin.y, cameraXY.y);
+						cameraMax.x = max(cameraMax.x, cameraXY.x);
+						cameraMax.y = max(cameraMax.y, cameraXY.y);
+						projectorMin.x = min(projectorMin.x, projectorXY.x);
+						projectorMin.y = min(projectorMin.y, projectorXY.y);
+						projectorMax.x = max(projectorMax.x, projectorXY.x);
+						projectorMax.y = max(projectorMax.y, projectorXY.y);
+					}
+
+					//grow by the margin so that a small bump of the projector stays inside the ROI
+					const auto margin = ofVec2f(this->roiMargin, this->roiMargin);
+					auto cameraRoi = ofRectangle(cameraMin - margin, cameraMax + margin + 1.0f);
+					auto projectorRoi = ofRectangle(projectorMin - margin, projectorMax + margin + 1.0f);
+					this->cameraRoi = this->getClippedRoi(cameraRoi, this->scanned.cameraSize);
+					this->projectorRoi = this->getClippedRoi(projectorRoi, this->scanned.projectorSize);
+					this->enableRoi = true;
+				}
+
+				//----------
+				void Graycode::cropToCameraRoi(const ofPixels & frame, const ScanSettings & scanning, ofPixels & cropped) const {
+					const auto & roi = scanning.cameraRoi;
+					if (frame.getWidth() != scanning.cameraSize.x || frame.getHeight() != scanning.cameraSize.y) {
+						throw(Exception("Camera frame size has changed during Graycode scan"));
+					}
+					frame.cropTo(cropped, roi.x, roi.y, roi.width, roi.height);
+				}
+
+				//----------
+				void Graycode::initPayload(const ofVec2f & projectorSize) {
+					if (this->payloadMode == 0) {
+						this->payload.init(projectorSize.x, projectorSize.y);
+					}
+					else {
+						//coarse payloads encode one cell per payload pixel
+						auto cellSize = (float) max(this->cellSize.get(), 1);
+						this->payload.init(ceil(projectorSize.x / cellSize), ceil(projectorSize.y / cellSize));
+					}
+				}
+
+				//----------
+				unsigned int Graycode::getPlannedFrameCount() const {
+					auto videoOutput = this->getInput<Device::VideoOutput>();
+					if (!videoOutput) {
+						return 0;
+					}
+
+					auto width = videoOutput->getWidth();
+					auto height = videoOutput->getHeight();
+					if (this->enableRoi) {
+						auto roi = this->getClippedRoi(this->projectorRoi, ofVec2f(width, height));
+						width = roi.width;
+						height = roi.height;
+					}
+					if (this->payloadMode != 0) {
+						auto cellSize = (float) max(this->cellSize.get(), 1);
+						width = ceil(width / cellSize);
+						height = ceil(height / cellSize);
+					}
+
+					ofxGraycode::PayloadGraycode plannedPayload;
+					plannedPayload.init(width, height);
+					auto frameCount = plannedPayload.getFrameCount();
+
+					if (this->payloadMode == 2) {
+						//fringes plus the complementary boundary code and its inverse, for each axis
+						frameCount += (this->phaseSteps + 2) * 2;
+					}
+					return frameCount;
+				}
+
+				//----------
+				void Graycode::capturePhaseShift(shared_ptr<Device::VideoOutput> videoOutput, const ScanSettings & scanning, bool horizontal, vector<ofPixels> & captures) {
+					auto camera = this->getInput<Item::Camera>();
+					auto grabber = camera->getGrabber();
+					const auto & roi = scanning.projectorRoi;
+					const auto steps = this->phaseSteps.get();
+					const auto cellSize = (float) scanning.cellSize;
+
+					//1D fringe pattern, stretched across the projector ROI
+					const int length = horizontal ? roi.getWidth() : roi.getHeight();
+					ofImage fringe;
+					fringe.allocate(horizontal ? length : 1, horizontal ? 1 : length, OF_IMAGE_GRAYSCALE);
+
+					//the fringe steps are followed by the complementary boundary code and its inverse.
+					//the boundary code is bright around even cell boundaries and dark around odd ones, changing at the cell centers
+					captures.clear();
+					for (int step = 0; step < steps + 2; step++) {
+						auto fringePixels = fringe.getPixels();
+						if (step < steps) {
+							const auto stepPhase = TWO_PI * (float)step / (float)steps;
+							for (int i = 0; i < length; i++) {
+								auto phase = TWO_PI * ((float)i + 0.5f) / cellSize;
+								fringePixels[i] = (unsigned char)(127.5f + 127.5f * cos(phase + stepPhase));
+							}
+						}
+						else {
+							const auto positive = step == steps;
+							for (int i = 0; i < length; i++) {
+								auto nearestBoundary = (int)floor(((float)i + 0.5f) / cellSize + 0.5f);
+								fringePixels[i] = ((nearestBoundary % 2 == 0) == positive) ? 255 : 0;
+							}
+						}
+						fringe.update();
+						fringe.getTextureReference().setTextureMinMagFilter(GL_NEAREST, GL_NEAREST);
+
+						videoOutput->clearFbo(false);
+						videoOutput->begin();
+						//
+						ofPushStyle();
+						ofSetColor(this->brightness);
+						fringe.draw(roi);
+						ofPopStyle();
+						//
+						videoOutput->end();
+						videoOutput->presentFbo();
+
+						stringstream message;
+						message << this->getName() << " phase shift " << (horizontal ? "X " : "Y ") << (step + 1) << "/" << (steps + 2);
+						ofxCvGui::Utils::drawProcessingNotice(message.str());
+
+						auto startWait = ofGetElapsedTimeMillis();
+						while (ofGetElapsedTimeMillis() - startWait < this->delay) {
+							ofSleepMillis(1);
+							grabber->update();
+						}
+
+						auto frame = camera->getFreshFrame();
+						if (!frame) {
+							throw(Exception("Camera returned no frame"));
+						}
+						ofPixels pixels;
+						this->cropToCameraRoi(frame->getPixels(), scanning, pixels);
+						ofPixels grayscale;
+						if (pixels.getNumChannels() != 1) {
+							grayscale.allocate(pixels.getWidth(), pixels.getHeight(), OF_PIXELS_MONO);
+							cv::cvtColor(ofxCv::toCv(pixels), ofxCv::toCv(grayscale), CV_RGB2GRAY);
+						}
+						else {
+							grayscale = pixels;
+						}
+						captures.push_back(grayscale);
+					}
+				}
+
+				//----------
+				void Graycode::decodePhaseShift(const ScanSettings & scanning, const vector<ofPixels> & capturesX, const vector<ofPixels> & capturesY) {
+					const auto & dataSet = this->decoder.getDataSet();
+					const auto cameraWidth = dataSet.getWidth();
+					const auto cameraHeight = dataSet.getHeight();
+					const auto cellSize = (float) scanning.cellSize;
+					const auto steps = (int) capturesX.size() - 2; // the last 2 captures are the boundary code
+					if (steps < 3 || capturesY.size() != capturesX.size()) {
+						throw(Exception("Phase shift needs at least 3 fringe captures and 2 boundary code captures per axis"));
+					}
+
+					//look up tables for the step phases
+					vector<float> stepSin(steps), stepCos(steps);
+					for (int step = 0; step < steps; step++) {
+						stepSin[step] = sin(TWO_PI * (float)step / (float)steps);
+						stepCos[step] = cos(TWO_PI * (float)step / (float)steps);
+					}
+
+					//returns the position within the cell [-0.5, cellSize - 0.5) or false if the fringe has too little modulation
+					auto findOffset = [&](const vector<ofPixels> & captures, int cameraIndex, float & offset) {
+						float sumSin = 0.0f, sumCos = 0.0f;
+						for (int step = 0; step < steps; step++) {
+							const auto value = (float)captures[step].getPixels()[cameraIndex];
+							sumSin += value * stepSin[step];
+							sumCos += value * stepCos[step];
+						}
+						auto modulation = 2.0f * sqrt(sumSin * sumSin + sumCos * sumCos) / (float)steps;
+						if (modulation * 2.0f < this->threshold) {
+							return false;
+						}
+						auto phase = atan2(-sumSin, sumCos);
+						if (phase < 0.0f) {
+							phase += TWO_PI;
+						}
+						offset = phase / TWO_PI * cellSize - 0.5f;
+						return true;
+					};
+
+					//returns false if the boundary code has too little contrast
+					auto findNearestBoundaryIsEven = [&](const vector<ofPixels> & captures, int cameraIndex, bool & isEven) {
+						const auto positive = (float)captures[steps].getPixels()[cameraIndex];
+						const auto negative = (float)captures[steps + 1].getPixels()[cameraIndex];
+						if (abs(positive - negative) < this->threshold) {
+							return false;
+						}
+						isEven = positive > negative;
+						return true;
+					};
+
+					//the phase wraps at the cell boundaries, which is exactly where the gray code can be out by one cell.
+					//in the outer quarters of the cell we take the boundary from the boundary code instead (it is steady there)
+					auto unwrap = [&](const vector<ofPixels> & captures, int cameraIndex, int cell, float offset) {
+						const auto fraction = (offset + 0.5f) / cellSize;
+						bool nearestBoundaryIsEven;
+						if ((fraction >= 0.25f && fraction < 0.75f) || !findNearestBoundaryIsEven(captures, cameraIndex, nearestBoundaryIsEven)) {
+							return (float)cell * cellSize + offset;
+						}
+
+						//the nearest boundary is at the start of the coded cell or of the next one
+						const auto boundary = ((cell % 2 == 0) == nearestBoundaryIsEven) ? cell : cell + 1;
+						const auto unwrappedCell = fraction < 0.25f ? boundary : boundary - 1;
+						return (float)unwrappedCell * cellSize + offset;
+					};
+
+					this->phaseShiftProjectorXY.allocate(cameraWidth, cameraHeight, 2);
+					this->phaseShiftProjectorXY.set(0.0f);
+					auto output = this->phaseShiftProjectorXY.getPixels();
+
+					for (const auto & pixel : dataSet) {
+						if (!pixel.active) {
+							continue;
+						}
+						const auto cameraXY = pixel.getCameraXY();
+						const auto cell = pixel.getProjectorXY();
+						const auto cameraIndex = (int)cameraXY.x + (int)cameraXY.y * cameraWidth;
+
+						//if there's too little modulation we stay at the center of the cell
+						ofVec2f offset(cellSize / 2.0f - 0.5f, cellSize / 2.0f - 0.5f);
+						findOffset(capturesX, cameraIndex, offset.x);
+						findOffset(capturesY, cameraIndex, offset.y);
+
+						output[cameraIndex * 2 + 0] = unwrap(capturesX, cameraIndex, (int)cell.x, offset.x);
+						output[cameraIndex * 2 + 1] = unwrap(capturesY, cameraIndex, (int)cell.y, offset.y);
+					}
+				}
+
+				//----------
+				void Graycode::savePhaseShift(const string & filename) const {
+					if (!this->phaseShiftProjectorXY.isAllocated()) {
+						return;
+					}
+					ofstream file(ofToDataPath(filename).c_str(), ios::binary | ios::out);
+					uint32_t width = this->phaseShiftProjectorXY.getWidth();
+					uint32_t height = this->phaseShiftProjectorXY.getHeight();
+					file.write((char*)&width, sizeof(width));
+					file.write((char*)&height, sizeof(height));
+					file.write((char*) this->phaseShiftProjectorXY.getPixels(), sizeof(float) * width * height * 2);
+					file.close();
+				}
+
+				//----------
+				void Graycode::loadPhaseShift(const string & filename) {
+					ifstream file(ofToDataPath(filename).c_str(), ios::binary | ios::in);
+					if (!file.is_open()) {
+						RULR_WARNING << "Couldn't load phase shift data from " << filename;
+						return;
+					}
+					uint32_t width, height;
+					file.read((char*)&width, sizeof(width));
+					file.read((char*)&height, sizeof(height));
+					this->phaseShiftProjectorXY.allocate(width, height, 2);
+					file.read((char*) this->phaseShiftProjectorXY.getPixels(), sizeof(float) * width * height * 2);
+					file.close();
+				}
+
+				//----------
+				void Graycode::switchIfLookingAtDirtyView() {
+					if (this->previewIsOfNonLivePixels) {
+						this->view->setImage(this->decoder.getProjectorInCamera());
+						this->previewIsOfNonLivePixels = false;
+					}
+				}
+
+				//----------
+				void Graycode::loadDataSetIfPending() const {
+					if (this->dataSetLoadPending) {
+						this->dataSetLoadPending = false;
+						auto filename = this->dataSetFilenameBase + ".sl";
+						this->decoder.loadDataSet(filename, false);
+						this->decoder.setThreshold(this->threshold);
+					}
+				}
+
+				//----------
+				void Graycode::markDataSetDirty() {
+					this->dataSetIsDirty = true;
+					this->invalidatePreviews();
+					this->dataVersion++;
+				}
+
+				//----------
+				void Graycode::invalidatePreviews() {
+					for (int i = 0; i < CompactDataSet::PreviewCount; i++) {
+						this->livePreviews[i].clear();
+						this->livePreviewIsBuilt[i] = false;
+					}
+				}
+
+				//----------
+				void Graycode::buildCorrespondences() {
+					auto & correspondences = this->correspondences;
+					correspondences.cameraXY.clear();
+					correspondences.projectorXY.clear();
+					correspondences.contrast.clear();
+					if (!this->hasData()) {
+						return;
+					}
+
+					auto add = [this, &correspondences](const ofVec2f & dataSetCameraXY, const ofVec2f & dataSetProjectorXY, uint8_t contrast) {
+						correspondences.cameraXY.push_back(this->getCameraXY(dataSetCameraXY));
+						correspondences.projectorXY.push_back(this->getProjectorXY(dataSetCameraXY, dataSetProjectorXY));
+						correspondences.contrast.push_back(contrast);
+					};
+
+					if (this->compactDataSet.isOpen() && !this->dataSetIsDirty) {
+						//read straight from the memory mapped file, without loading the full DataSet
+						const auto width = this->compactDataSet.getWidth();
+						const auto pixelCount = width * this->compactDataSet.getHeight();
+						const auto payloadWidth = this->compactDataSet.getPayloadWidth();
+						const auto projectorIndices = this->compactDataSet.getProjectorIndices();
+						const auto active = this->compactDataSet.getActive();
+						const auto distance = this->compactDataSet.getDistance();
+
+						size_t activeCount = 0;
+						for (unsigned int i = 0; i < pixelCount; i++) {
+							if (active[i]) {
+								activeCount++;
+							}
+						}
+						correspondences.cameraXY.reserve(activeCount);
+						correspondences.projectorXY.reserve(activeCount);
+						correspondences.contrast.reserve(activeCount);
+
+						for (unsigned int i = 0; i < pixelCount; i++) {
+							if (active[i]) {
+								auto dataSetCameraXY = ofVec2f(i % width, i / width);
+								auto dataSetProjectorXY = ofVec2f(projectorIndices[i] % payloadWidth, projectorIndices[i] / payloadWidth);
+								add(dataSetCameraXY, dataSetProjectorXY, distance[i]);
+							}
+						}
+					}
+					else {
+						const auto & dataSet = this->getDataSet();
+
+						size_t activeCount = 0;
+						for (const auto & pixel : dataSet) {
+							if (pixel.active) {
+								activeCount++;
+							}
+						}
+						correspondences.cameraXY.reserve(activeCount);
+						correspondences.projectorXY.reserve(activeCount);
+						correspondences.contrast.reserve(activeCount);
+
+						for (const auto & pixel : dataSet) {
+							if (pixel.active) {
+								add(pixel.getCameraXY(), pixel.getProjectorXY(), pixel.distance);
+							}
+						}
+					}
+				}
+			}
+		}
+	}
 }
\ No newline at end of file
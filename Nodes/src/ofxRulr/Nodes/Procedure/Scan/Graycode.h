@@ -1,52 +1,157 @@
-#pragma once
-
-#include "../Base.h"
-
-#include "../../../addons/ofxGraycode/src/ofxGraycode.h"
-#include "ofxCvGui/Panels/Image.h"
-
-namespace ofxRulr {
-	namespace Nodes {
-		namespace Procedure {
-			namespace Scan {
-				class Graycode : public Procedure::Base {
-				public:
-					Graycode();
-					void init();
-					string getTypeName() const override;
-					ofxCvGui::PanelPtr getView() override;
-					void update();
-
-					void serialize(Json::Value &);
-					void deserialize(const Json::Value &);
-
-					bool isReady();
-					void runScan();
-
-					ofxGraycode::Decoder & getDecoder();
-					const ofxGraycode::DataSet & getDataSet() const;
-
-				protected:
-					void drawPreviewOnVideoOutput(const ofRectangle &);
-					void populateInspector(ofxCvGui::ElementGroupPtr);
-					void switchIfLookingAtDirtyView();
-
-					shared_ptr<ofxCvGui::Panels::Image> view;
-
-					ofxGraycode::PayloadGraycode payload;
-					ofxGraycode::Encoder encoder;
-					ofxGraycode::Decoder decoder;
-					ofImage message;
-
-					ofImage preview;
-					ofParameter<float> threshold;
-					ofParameter<float> delay;
-					ofParameter<float> brightness;
-					ofParameter<bool> enablePreviewOnVideoOutput;
-
-					bool previewIsOfNonLivePixels;
-				};
-			}
-		}
-	}
+#pragma once
+
+#include "../Base.h"
+#include "CompactDataSet.h"
+
+#include "../../../addons/ofxGraycode/src/ofxGraycode.h"
+#include "ofxCvGui/Panels/Image.h"
+
+namespace ofxRulr {
+	namespace Nodes {
+		namespace Device {
+			class VideoOutput;
+		}
+		namespace Item {
+			class Camera;
+		}
+	}
+}
+
+namespace ofxRulr {
+	namespace Nodes {
+		namespace Procedure {
+			namespace Scan {
+				class Graycode : public Procedure::Base {
+				public:
+					///Active camera/projector pixel pairs in full frame coordinates, stored as parallel arrays
+					struct Correspondences {
+						vector<ofVec2f> cameraXY;
+						vector<ofVec2f> projectorXY;
+						vector<uint8_t> contrast;
+
+						size_t size() const { return this->cameraXY.size(); }
+						bool empty() const { return this->cameraXY.empty(); }
+					};
+
+					Graycode();
+					void init();
+					string getTypeName() const override;
+					ofxCvGui::PanelPtr getView() override;
+					void update();
+
+					void serialize(Json::Value &);
+					void deserialize(const Json::Value &);
+
+					bool isReady();
+					void runScan();
+
+					///Returns true if a scan is available, whether or not it has been read into the Decoder yet
+					bool hasData() const;
+					///Returns true once the full ofxGraycode::DataSet has been read into the Decoder
+					bool getIsDataSetLoaded() const;
+
+					///Reads the full DataSet from disk if it hasn't been read yet
+					ofxGraycode::Decoder & getDecoder();
+					///Reads the full DataSet from disk if it hasn't been read yet
+					const ofxGraycode::DataSet & getDataSet() const;
+					///Served from the memory mapped file when it is current, otherwise built from the Decoder. Cached until the data changes.
+					ofImage & getPreview(CompactDataSet::Preview);
+
+					///Built once per change of data or threshold, and shared read-only by all consumers
+					const Correspondences & getCorrespondences();
+					///Changes whenever the scan data or threshold changes, so consumers can tell if their results are stale
+					unsigned int getDataVersion() const;
+
+					///Size of the VideoOutput at the time of the scan [px]
+					ofVec2f getProjectorSize() const;
+					///Size of the camera image at the time of the scan [px]
+					ofVec2f getCameraSize() const;
+					///Region of the VideoOutput which was scanned [px]
+					ofRectangle getProjectorRoi() const;
+					///Region of the camera image which was decoded [px]
+					ofRectangle getCameraRoi() const;
+
+					///Full frame camera position [px] of a pixel in the DataSet
+					ofVec2f getCameraXY(const ofVec2f & dataSetCameraXY) const;
+					///Full frame projector position [px] of a pixel in the DataSet.
+					///Accounts for regions of interest, coarse payloads and phase shift refinement.
+					ofVec2f getProjectorXY(const ofVec2f & dataSetCameraXY, const ofVec2f & dataSetProjectorXY) const;
+					///Returns true if the DataSet's coordinates are full resolution, full frame camera and output pixels
+					bool getIsFullResolution() const;
+
+				protected:
+					void drawPreviewOnVideoOutput(const ofRectangle &);
+					void populateInspector(ofxCvGui::ElementGroupPtr);
+					void switchIfLookingAtDirtyView();
+					void loadDataSetIfPending() const;
+					void markDataSetDirty();
+					void invalidatePreviews();
+					void buildCorrespondences();
+
+					ofRectangle getClippedRoi(const ofRectangle & roi, const ofVec2f & frameSize) const;
+					void fitRoisToDataSet();
+
+					///Settings which a scan was (or is being) made with
+					struct ScanSettings {
+						int payloadMode;
+						int cellSize;
+						ofVec2f projectorSize;
+						ofVec2f cameraSize;
+						ofRectangle projectorRoi;
+						ofRectangle cameraRoi;
+					};
+
+					void cropToCameraRoi(const ofPixels & frame, const ScanSettings &, ofPixels & cropped) const;
+
+					void initPayload(const ofVec2f & projectorSize);
+					unsigned int getPlannedFrameCount() const;
+					void captureAndDecode(shared_ptr<Item::Camera>, shared_ptr<Device::VideoOutput>, const ScanSettings &);
+					///Captures phaseSteps fringes followed by the complementary boundary code and its inverse
+					void capturePhaseShift(shared_ptr<Device::VideoOutput>, const ScanSettings &, bool horizontal, vector<ofPixels> & captures);
+					void decodePhaseShift(const ScanSettings &, const vector<ofPixels> & capturesX, const vector<ofPixels> & capturesY);
+					void savePhaseShift(const string & filename) const;
+					void loadPhaseShift(const string & filename);
+
+					shared_ptr<ofxCvGui::Panels::Image> view;
+
+					ofxGraycode::PayloadGraycode payload;
+					ofxGraycode::Encoder encoder;
+					mutable ofxGraycode::Decoder decoder; // the DataSet is read on first use
+					ofImage message;
+
+					CompactDataSet compactDataSet;
+					mutable bool dataSetLoadPending;
+					bool dataSetIsDirty; // the data we hold differs from what is on disk
+					string dataSetFilenameBase; // where the data we hold was last loaded from or saved to (without extension)
+
+					ofImage livePreviews[CompactDataSet::PreviewCount];
+					bool livePreviewIsBuilt[CompactDataSet::PreviewCount];
+
+					Correspondences correspondences;
+					unsigned int dataVersion;
+					unsigned int correspondencesVersion;
+
+					ofParameter<float> threshold;
+					ofParameter<float> delay;
+					ofParameter<float> brightness;
+					ofParameter<bool> enablePreviewOnVideoOutput;
+
+					ofParameter<int> payloadMode; // 0 = graycode, 1 = coarse graycode, 2 = coarse graycode + phase shift
+					ofParameter<int> cellSize;
+					ofParameter<int> phaseSteps;
+
+					ofParameter<bool> enableRoi;
+					ofParameter<ofRectangle> projectorRoi;
+					ofParameter<ofRectangle> cameraRoi;
+					ofParameter<float> roiMargin;
+
+					ScanSettings scanned; // settings which were used for the data we currently hold
+
+					ofFloatPixels phaseShiftProjectorXY; // 2 channel, camera ROI resolution, relative to projector ROI
+
+					bool previewIsOfNonLivePixels;
+				};
+			}
+		}
+	}
 }
\ No newline at end of file
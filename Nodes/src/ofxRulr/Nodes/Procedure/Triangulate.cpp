@@ -1,140 +1,483 @@
-#include "Triangulate.h"
-
-#include "../Item/Camera.h"
-#include "../Item/Projector.h"
-#include "./Scan/Graycode.h"
-
-#include "../../../addons/ofxTriangulate/src/ofxTriangulate.h"
-#include "ofxCvGui.h"
-
-using namespace ofxRulr::Nodes;
-using namespace ofxCvGui;
-
-namespace ofxRulr {
-	namespace Nodes {
-		namespace Procedure {
-			//----------
-			Triangulate::Triangulate() {
-				RULR_NODE_INIT_LISTENER;
-			}
-
-			//----------
-			void Triangulate::init() {
-				RULR_NODE_INSPECTOR_LISTENER;
-				RULR_NODE_SERIALIZATION_LISTENERS;
-
-				auto cameraPin = MAKE(Graph::Pin<Item::Camera>);
-				auto projectorPin = MAKE(Graph::Pin<Item::Projector>);
-				auto graycodePin = MAKE(Graph::Pin<Scan::Graycode>);
-
-				this->addInput(cameraPin);
-				this->addInput(projectorPin);
-				this->addInput(graycodePin);
-
-				this->maxLength.set("Maximum length disparity [m]", 0.05f, 0.0f, 10.0f);
-				this->giveColor.set("Give color", true);
-				this->giveTexCoords.set("Give texture coordinates", true);
-				this->drawPointSize.set("Point size for draw", 1.0f, 1.0f, 10.0f);
-			}
-
-			//----------
-			string Triangulate::getTypeName() const {
-				return "Procedure::Triangulate";
-			}
-
-			//----------
-			void Triangulate::serialize(Json::Value & json) {
-
-			}
-
-			//----------
-			void Triangulate::deserialize(const Json::Value & json) {
-
-			}
-
-			//----------
-			void Triangulate::triangulate() {
-				this->throwIfMissingAnyConnection();
-
-				auto camera = this->getInput<Item::Camera>();
-				auto projector = this->getInput<Item::Projector>();
-				auto graycode = this->getInput<Scan::Graycode>();
-
-				const auto & dataSet = graycode->getDataSet();
-
-				ofxCvGui::Utils::drawProcessingNotice("Triangulating..");
-				ofxTriangulate::Triangulate(dataSet, camera->getViewInWorldSpace(), projector->getViewInWorldSpace(), this->mesh, this->maxLength, this->giveColor, this->giveTexCoords);
-			}
-
-			//----------
-			void Triangulate::populateInspector(ofxCvGui::ElementGroupPtr inspector) {
-				auto triangulateButton = Widgets::Button::make("Triangulate", [this]() {
-					try {
-						this->triangulate();
-					}
-					catch (std::exception e) {
-						ofSystemAlertDialog(e.what());
-					}
-				}, OF_KEY_RETURN);
-				triangulateButton->setHeight(100.0f);
-				inspector->add(triangulateButton);
-				inspector->add(Widgets::Slider::make(this->maxLength));
-				inspector->add(Widgets::Toggle::make(this->giveColor));
-				inspector->add(Widgets::Toggle::make(this->giveTexCoords));
-				inspector->add(Widgets::Slider::make(this->drawPointSize));
-				inspector->add(Widgets::Button::make("Save ofMesh...", [this]() {
-					auto result = ofSystemSaveDialog("mesh.ply", "Save mesh as PLY");
-					if (result.bSuccess) {
-						this->mesh.save(result.filePath);
-					}
-				}));
-				inspector->add(Widgets::Button::make("Save binary mesh...", [this]() {
-					auto result = ofSystemSaveDialog("mesh.bin", "Save mesh as PLY");
-					if (result.bSuccess) {
-						ofstream save(ofToDataPath(result.filePath).c_str(), ios::binary);
-						if (!save.is_open()) {
-							ofLogError("ofxRulr::Triangulate") << "save failed to open file " << result.fileName;
-							return;
-						}
-						auto numVertices = (uint32_t) this->mesh.getNumVertices();
-						save.write((char *)& numVertices, sizeof(numVertices));
-						save.write((char *) this->mesh.getVerticesPointer(), sizeof(ofVec3f)* numVertices);
-
-						auto numTexCoords = (uint32_t) this->mesh.getNumTexCoords();
-						save.write((char *)& numTexCoords, sizeof(numTexCoords));
-						save.write((char *) this->mesh.getTexCoordsPointer(), sizeof(ofVec2f)* numTexCoords);
-
-						auto numColors = (uint32_t) this->mesh.getNumColors();
-						save.write((char *)& numColors, sizeof(numColors));
-						save.write((char *) this->mesh.getColorsPointer(), sizeof(ofFloatColor)* numColors);
-
-						save.close();
-					}
-				}));
-			}
-
-			//----------
-			void Triangulate::drawWorld() {
-				glPushAttrib(GL_POINT_BIT);
-				glPointSize(this->drawPointSize);
-				this->mesh.drawVertices();
-				glPopAttrib();
-
-				auto graycode = this->getInput<Scan::Graycode>();
-
-				auto camera = this->getInput<Item::Camera>();
-				if (camera) {
-					if (graycode) {
-						camera->getViewInWorldSpace().drawOnNearPlane(graycode->getDecoder().getProjectorInCamera());
-					}
-				}
-				auto projector = this->getInput<Item::Projector>();
-				if (projector) {
-					if (graycode) {
-						projector->getViewInWorldSpace().drawOnNearPlane(graycode->getDecoder().getCameraInProjector());
-					}
-				}
-			}
-		}
-	}
+#include "Triangulate.h"
+
+#include "../Item/Camera.h"
+#include "../Item/Projector.h"
+#include "./Scan/Graycode.h"
+
+#include "ofxRulr/Utils/Parallel.h"
+#include "ofxRulr/Utils/PlyReader.h"
+#include "ofxRulr/Utils/PlyWriter.h"
+#include "ofxRulr/Utils/VoxelGrid.h"
+
+#include "ofxCvGui.h"
+#include "ofxCvMin.h"
+
+#include <chrono>
+#include <mutex>
+
+using namespace ofxRulr::Nodes;
+using namespace ofxCvGui;
+using namespace ofxCv;
+
+namespace ofxRulr {
+	namespace Nodes {
+		namespace Procedure {
+			//----------
+			Triangulate::Triangulate() {
+				RULR_NODE_INIT_LISTENER;
+			}
+
+			//----------
+			void Triangulate::init() {
+				RULR_NODE_INSPECTOR_LISTENER;
+				RULR_NODE_SERIALIZATION_LISTENERS;
+
+				auto cameraPin = MAKE(Graph::Pin<Item::Camera>);
+				auto projectorPin = MAKE(Graph::Pin<Item::Projector>);
+				auto graycodePin = MAKE(Graph::Pin<Scan::Graycode>);
+
+				this->addInput(cameraPin);
+				this->addInput(projectorPin);
+				this->addInput(graycodePin);
+
+				this->maxLength.set("Maximum length disparity [m]", 0.05f, 0.0f, 10.0f);
+				this->giveColor.set("Give color", true);
+				this->giveTexCoords.set("Give texture coordinates", true);
+				this->drawPointSize.set("Point size for draw", 1.0f, 1.0f, 10.0f);
+				this->drawPointBudget.set("Max points for draw", 2000000, 10000, 50000000);
+
+				this->voxelSize.set("Voxel size [m]", 0.005f, 0.0001f, 1.0f);
+				this->outlierNeighbours.set("Outlier neighbours", 8, 1, 64);
+				this->outlierDeviations.set("Outlier standard deviations", 2.0f, 0.1f, 10.0f);
+
+				this->meshVersion = 0;
+				this->levelOfDetailVersion = 0;
+				this->levelOfDetailVoxelSize = 0.0f;
+				this->levelOfDetailBudget = 0;
+				this->levelOfDetailBuildCount = 0;
+
+				memset(&this->triangulateStatistics, 0, sizeof(this->triangulateStatistics));
+			}
+
+			//----------
+			string Triangulate::getTypeName() const {
+				return "Procedure::Triangulate";
+			}
+
+			//----------
+			void Triangulate::serialize(Json::Value & json) {
+
+			}
+
+			//----------
+			void Triangulate::deserialize(const Json::Value & json) {
+
+			}
+
+			//----------
+			void Triangulate::triangulate() {
+				this->throwIfMissingAnyConnection();
+
+				auto camera = this->getInput<Item::Camera>();
+				auto projector = this->getInput<Item::Projector>();
+				auto graycode = this->getInput<Scan::Graycode>();
+
+				if (!graycode->hasData()) {
+					throw(Exception("No data loaded for [ofxGraycode::DataSet]"));
+				}
+				if (graycode->getProjectorSize() != ofVec2f(projector->getWidth(), projector->getHeight())) {
+					throw(Exception("Projector resolution does not match the resolution of the Graycode scan"));
+				}
+				if (graycode->getCameraSize() != ofVec2f(camera->getWidth(), camera->getHeight())) {
+					throw(Exception("Camera resolution does not match the resolution of the Graycode scan"));
+				}
+
+				ofxCvGui::Utils::drawProcessingNotice("Triangulating..");
+				auto startTime = chrono::high_resolution_clock::now();
+
+				//correspondences are in full frame coordinates, so ROIs and phase shift refinement are already accounted for
+				const auto & correspondences = graycode->getCorrespondences();
+				const auto count = correspondences.size();
+
+				const auto cameraTransform = camera->getBatchTransform();
+				const auto projectorTransform = projector->getBatchTransform();
+
+				const auto giveColor = this->giveColor.get();
+				const auto giveTexCoords = this->giveTexCoords.get();
+				const auto maxLengthSquared = this->maxLength.get() * this->maxLength.get();
+
+				//median brightness is indexed in camera ROI coordinates
+				const ofPixels * median = nullptr;
+				ofVec2f cameraRoiOrigin;
+				if (giveColor) {
+					median = &graycode->getPreview(Scan::CompactDataSet::Median).getPixelsRef();
+					cameraRoiOrigin = graycode->getCameraRoi().getPosition();
+				}
+
+				//every block writes its accepted points to the front of its own slice of these arrays
+				vector<ofVec3f> vertices(count);
+				vector<ofFloatColor> colors(giveColor ? count : 0);
+				vector<ofVec2f> texCoords(giveTexCoords ? count : 0);
+
+				const size_t blockSize = 8192;
+				const auto blockCount = (count + blockSize - 1) / blockSize;
+				vector<size_t> blockVertexCount(blockCount, 0);
+
+				Utils::parallelFor(count, [&](size_t begin, size_t end) {
+					const auto size = end - begin;
+
+					//rays as structure of arrays so that the intersection loop below can be vectorised by the compiler
+					vector<float> rays(size * 12);
+					auto s1x = rays.data(), s1y = s1x + size, s1z = s1y + size;
+					auto t1x = s1z + size, t1y = t1x + size, t1z = t1y + size;
+					auto s2x = t1z + size, s2y = s2x + size, s2z = s2y + size;
+					auto t2x = s2z + size, t2y = t2x + size, t2z = t2y + size;
+					cameraTransform.unproject(correspondences.cameraXY.data() + begin, size, s1x, s1y, s1z, t1x, t1y, t1z);
+					projectorTransform.unproject(correspondences.projectorXY.data() + begin, size, s2x, s2y, s2z, t2x, t2y, t2z);
+
+					//closest points between each camera ray and projector ray
+					vector<float> midpoints(size * 4);
+					auto mx = midpoints.data(), my = mx + size, mz = my + size, lengthSquared = mz + size;
+					for (size_t i = 0; i < size; i++) {
+						const auto wx = s1x[i] - s2x[i];
+						const auto wy = s1y[i] - s2y[i];
+						const auto wz = s1z[i] - s2z[i];
+						const auto a = t1x[i] * t1x[i] + t1y[i] * t1y[i] + t1z[i] * t1z[i];
+						const auto b = t1x[i] * t2x[i] + t1y[i] * t2y[i] + t1z[i] * t2z[i];
+						const auto c = t2x[i] * t2x[i] + t2y[i] * t2y[i] + t2z[i] * t2z[i];
+						const auto d = t1x[i] * wx + t1y[i] * wy + t1z[i] * wz;
+						const auto e = t2x[i] * wx + t2y[i] * wy + t2z[i] * wz;
+						const auto denominator = a * c - b * b;
+
+						//parallel rays give a zero denominator, which ends up as an infinite or NaN length and is rejected below
+						const auto s = (b * e - c * d) / denominator;
+						const auto t = (a * e - b * d) / denominator;
+
+						const auto px = s1x[i] + s * t1x[i];
+						const auto py = s1y[i] + s * t1y[i];
+						const auto pz = s1z[i] + s * t1z[i];
+						const auto qx = s2x[i] + t * t2x[i];
+						const auto qy = s2y[i] + t * t2y[i];
+						const auto qz = s2z[i] + t * t2z[i];
+
+						mx[i] = (px + qx) * 0.5f;
+						my[i] = (py + qy) * 0.5f;
+						mz[i] = (pz + qz) * 0.5f;
+						lengthSquared[i] = (px - qx) * (px - qx) + (py - qy) * (py - qy) + (pz - qz) * (pz - qz);
+					}
+
+					//compact accepted points into this block's slice of the output
+					auto vertexCount = begin;
+					for (size_t i = 0; i < size; i++) {
+						if (!(lengthSquared[i] <= maxLengthSquared)) {
+							continue;
+						}
+						vertices[vertexCount] = ofVec3f(mx[i], my[i], mz[i]);
+						const auto & cameraXY = correspondences.cameraXY[begin + i];
+						if (giveColor) {
+							const auto x = (int)(cameraXY.x - cameraRoiOrigin.x);
+							const auto y = (int)(cameraXY.y - cameraRoiOrigin.y);
+							const auto channels = median->getNumChannels();
+							const auto brightness = median->getPixels()[(x + y * median->getWidth()) * channels];
+							colors[vertexCount] = ofFloatColor((float)brightness / 255.0f);
+						}
+						if (giveTexCoords) {
+							texCoords[vertexCount] = cameraXY;
+						}
+						vertexCount++;
+					}
+					blockVertexCount[begin / blockSize] = vertexCount - begin;
+				}, blockSize);
+
+				//close the gaps between blocks
+				size_t vertexCount = 0;
+				for (size_t block = 0; block < blockCount; block++) {
+					const auto blockBegin = block * blockSize;
+					const auto accepted = blockVertexCount[block];
+					if (vertexCount != blockBegin) {
+						std::copy(vertices.begin() + blockBegin, vertices.begin() + blockBegin + accepted, vertices.begin() + vertexCount);
+						if (giveColor) {
+							std::copy(colors.begin() + blockBegin, colors.begin() + blockBegin + accepted, colors.begin() + vertexCount);
+						}
+						if (giveTexCoords) {
+							std::copy(texCoords.begin() + blockBegin, texCoords.begin() + blockBegin + accepted, texCoords.begin() + vertexCount);
+						}
+					}
+					vertexCount += accepted;
+				}
+				vertices.resize(vertexCount);
+				colors.resize(giveColor ? vertexCount : 0);
+				texCoords.resize(giveTexCoords ? vertexCount : 0);
+
+				this->mesh.clear();
+				this->mesh.setMode(OF_PRIMITIVE_POINTS);
+				this->mesh.getVertices().swap(vertices);
+				this->mesh.getColors().swap(colors);
+				this->mesh.getTexCoords().swap(texCoords);
+				this->markMeshChanged();
+
+				this->triangulateStatistics.correspondenceCount = count;
+				this->triangulateStatistics.vertexCount = vertexCount;
+				this->triangulateStatistics.duration = (float)chrono::duration_cast<chrono::milliseconds>(chrono::high_resolution_clock::now() - startTime).count();
+			}
+
+			//----------
+			void Triangulate::downsample() {
+				if (this->mesh.getNumVertices() == 0) {
+					throw(Exception("No points to downsample. Triangulate or load a PLY first"));
+				}
+
+				ofxCvGui::Utils::drawProcessingNotice("Downsampling..");
+				Utils::VoxelGrid voxelGrid;
+				voxelGrid.build(this->mesh.getVertices(), this->voxelSize);
+
+				ofMesh downsampled;
+				voxelGrid.downsample(this->mesh, downsampled);
+				swap(this->mesh, downsampled);
+				this->markMeshChanged();
+			}
+
+			//----------
+			void Triangulate::removeOutliers() {
+				if (this->mesh.getNumVertices() == 0) {
+					throw(Exception("No points to filter. Triangulate or load a PLY first"));
+				}
+
+				ofxCvGui::Utils::drawProcessingNotice("Removing outliers..");
+				Utils::VoxelGrid voxelGrid;
+				voxelGrid.build(this->mesh.getVertices(), this->voxelSize);
+				auto isOutlier = voxelGrid.findStatisticalOutliers(this->outlierNeighbours, this->outlierDeviations);
+				voxelGrid.clear();
+
+				auto & vertices = this->mesh.getVertices();
+				auto & colors = this->mesh.getColors();
+				auto & texCoords = this->mesh.getTexCoords();
+				const auto hasColors = colors.size() == vertices.size();
+				const auto hasTexCoords = texCoords.size() == vertices.size();
+
+				size_t keepCount = 0;
+				for (size_t i = 0; i < vertices.size(); i++) {
+					if (isOutlier[i]) {
+						continue;
+					}
+					vertices[keepCount] = vertices[i];
+					if (hasColors) {
+						colors[keepCount] = colors[i];
+					}
+					if (hasTexCoords) {
+						texCoords[keepCount] = texCoords[i];
+					}
+					keepCount++;
+				}
+				vertices.resize(keepCount);
+				if (hasColors) {
+					colors.resize(keepCount);
+				}
+				if (hasTexCoords) {
+					texCoords.resize(keepCount);
+				}
+				this->markMeshChanged();
+			}
+
+			//----------
+			void Triangulate::populateInspector(ofxCvGui::ElementGroupPtr inspector) {
+				auto triangulateButton = Widgets::Button::make("Triangulate", [this]() {
+					try {
+						this->triangulate();
+					}
+					catch (std::exception e) {
+						ofSystemAlertDialog(e.what());
+					}
+				}, OF_KEY_RETURN);
+				triangulateButton->setHeight(100.0f);
+				inspector->add(triangulateButton);
+				inspector->add(Widgets::Slider::make(this->maxLength));
+				inspector->add(Widgets::Toggle::make(this->giveColor));
+				inspector->add(Widgets::Toggle::make(this->giveTexCoords));
+				inspector->add(Widgets::Slider::make(this->drawPointSize));
+				inspector->add(Widgets::Slider::make(this->drawPointBudget));
+				inspector->add(Widgets::LiveValue<string>::make("Level of detail for draw", [this]() -> string {
+					if (this->mesh.getNumVertices() <= (size_t) this->drawPointBudget.get()) {
+						return "All points";
+					}
+					else if (this->levelOfDetailVersion != this->meshVersion) {
+						return "Pending";
+					}
+					else {
+						return ofToString(this->levelOfDetail.getNumVertices()) + " points at " + ofToString(this->levelOfDetailVoxelSize * 1000.0f) + "mm";
+					}
+				}));
+				inspector->add(Widgets::LiveValue<string>::make("Vertices / correspondences", [this]() {
+					return ofToString(this->triangulateStatistics.vertexCount) + " / " + ofToString(this->triangulateStatistics.correspondenceCount);
+				}));
+				inspector->add(Widgets::LiveValue<float>::make("Triangulate duration [ms]", [this]() {
+					return this->triangulateStatistics.duration;
+				}));
+
+				inspector->add(Widgets::Title::make("Filtering", Widgets::Title::Level::H2));
+				inspector->add(Widgets::Slider::make(this->voxelSize));
+				inspector->add(Widgets::Button::make("Downsample to voxel grid", [this]() {
+					try {
+						this->downsample();
+					}
+					RULR_CATCH_ALL_TO_ALERT
+				}));
+				inspector->add(Widgets::Slider::make(this->outlierNeighbours));
+				inspector->add(Widgets::Slider::make(this->outlierDeviations));
+				inspector->add(Widgets::Button::make("Remove statistical outliers", [this]() {
+					try {
+						this->removeOutliers();
+					}
+					RULR_CATCH_ALL_TO_ALERT
+				}));
+
+				inspector->add(Widgets::Title::make("File", Widgets::Title::Level::H2));
+				inspector->add(Widgets::Button::make("Save PLY...", [this]() {
+					try {
+						auto result = ofSystemSaveDialog("mesh.ply", "Save mesh as binary PLY");
+						if (result.bSuccess) {
+							ofxCvGui::Utils::drawProcessingNotice("Saving PLY..");
+							Utils::PlyWriter::save(result.filePath, this->mesh);
+						}
+					}
+					RULR_CATCH_ALL_TO_ALERT
+				}));
+				inspector->add(Widgets::Button::make("Load PLY...", [this]() {
+					try {
+						auto result = ofSystemLoadDialog("Load binary PLY");
+						if (result.bSuccess) {
+							ofxCvGui::Utils::drawProcessingNotice("Loading PLY..");
+							Utils::PlyReader::load(result.filePath, this->mesh);
+							this->markMeshChanged();
+							this->triangulateStatistics.vertexCount = this->mesh.getNumVertices();
+							this->triangulateStatistics.correspondenceCount = 0;
+						}
+					}
+					RULR_CATCH_ALL_TO_ALERT
+				}));
+				inspector->add(Widgets::Button::make("Save binary mesh...", [this]() {
+					auto result = ofSystemSaveDialog("mesh.bin", "Save mesh as PLY");
+					if (result.bSuccess) {
+						ofstream save(ofToDataPath(result.filePath).c_str(), ios::binary);
+						if (!save.is_open()) {
+							ofLogError("ofxRulr::Triangulate") << "save failed to open file " << result.fileName;
+							return;
+						}
+						auto numVertices = (uint32_t) this->mesh.getNumVertices();
+						save.write((char *)& numVertices, sizeof(numVertices));
+						save.write((char *) this->mesh.getVerticesPointer(), sizeof(ofVec3f)* numVertices);
+
+						auto numTexCoords = (uint32_t) this->mesh.getNumTexCoords();
+						save.write((char *)& numTexCoords, sizeof(numTexCoords));
+						save.write((char *) this->mesh.getTexCoordsPointer(), sizeof(ofVec2f)* numTexCoords);
+
+						auto numColors = (uint32_t) this->mesh.getNumColors();
+						save.write((char *)& numColors, sizeof(numColors));
+						save.write((char *) this->mesh.getColorsPointer(), sizeof(ofFloatColor)* numColors);
+
+						save.close();
+					}
+				}));
+			}
+
+			//----------
+			void Triangulate::drawWorld() {
+				glPushAttrib(GL_POINT_BIT);
+				glPointSize(this->drawPointSize);
+				const auto & drawMesh = this->getDrawMesh();
+				if (&drawMesh == &this->mesh) {
+					this->getRetainedMesh("mesh", this->meshVersion, this->mesh).drawVertices();
+				}
+				else {
+					this->getRetainedMesh("levelOfDetail", this->levelOfDetailBuildCount, this->levelOfDetail).drawVertices();
+				}
+				glPopAttrib();
+
+				auto graycode = this->getInput<Scan::Graycode>();
+				if (graycode && !graycode->getIsDataSetLoaded()) {
+					graycode.reset();
+				}
+
+				auto camera = this->getInput<Item::Camera>();
+				if (camera) {
+					if (graycode) {
+						camera->getViewInWorldSpace().drawOnNearPlane(graycode->getDecoder().getProjectorInCamera());
+					}
+				}
+				auto projector = this->getInput<Item::Projector>();
+				if (projector) {
+					if (graycode) {
+						projector->getViewInWorldSpace().drawOnNearPlane(graycode->getDecoder().getCameraInProjector());
+					}
+				}
+			}
+
+			//----------
+			Utils::Bounds Triangulate::getWorldBounds() const {
+				auto bounds = this->meshBounds;
+
+				//we also draw onto the near planes of the camera and projector
+				auto camera = this->getInput<Item::Camera>();
+				if (camera) {
+					bounds.add(camera->getWorldBounds());
+				}
+				auto projector = this->getInput<Item::Projector>();
+				if (projector) {
+					bounds.add(projector->getWorldBounds());
+				}
+				return bounds;
+			}
+
+			//----------
+			void Triangulate::markMeshChanged() {
+				this->meshVersion++;
+				this->levelOfDetail.clear();
+
+				//find the bounds here rather than at draw time, so that culling doesn't touch every vertex each frame
+				const auto & vertices = this->mesh.getVertices();
+				mutex boundsLock;
+				this->meshBounds = Utils::Bounds();
+				Utils::parallelFor(vertices.size(), [&](size_t begin, size_t end) {
+					Utils::Bounds blockBounds;
+					for (size_t i = begin; i < end; i++) {
+						blockBounds.add(vertices[i]);
+					}
+					lock_guard<mutex> lock(boundsLock);
+					this->meshBounds.add(blockBounds);
+				});
+			}
+
+			//----------
+			const ofMesh & Triangulate::getDrawMesh() {
+				const auto budget = (size_t) max(this->drawPointBudget.get(), 1);
+				if (this->mesh.getNumVertices() <= budget) {
+					return this->mesh;
+				}
+
+				//rebuild when the mesh or the budget has changed
+				if (this->levelOfDetailVersion != this->meshVersion || this->levelOfDetailBudget != budget) {
+					try {
+						ofxCvGui::Utils::drawProcessingNotice("Building level of detail..");
+						Utils::VoxelGrid voxelGrid;
+						auto voxelSize = this->voxelSize.get();
+						do {
+							voxelGrid.build(this->mesh.getVertices(), voxelSize);
+							this->levelOfDetailVoxelSize = voxelSize;
+							voxelSize *= 2.0f;
+						} while (voxelGrid.getCells().size() > budget);
+						voxelGrid.downsample(this->mesh, this->levelOfDetail);
+					}
+					RULR_CATCH_ALL_TO_ERROR
+					this->levelOfDetailBuildCount++;
+					this->levelOfDetailVersion = this->meshVersion;
+					this->levelOfDetailBudget = budget;
+				}
+
+				if (this->levelOfDetail.getNumVertices() == 0) {
+					return this->mesh;
+				}
+				return this->levelOfDetail;
+			}
+		}
+	}
 }
\ No newline at end of file
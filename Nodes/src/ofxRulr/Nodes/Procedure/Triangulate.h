@@ -1,35 +1,60 @@
-#pragma once
-
-#include "Base.h"
-
-#include "ofxCvGui/Panels/World.h"
-
-#include "../../../addons/ofxRay/src/ofxRay.h"
-
-namespace ofxRulr {
-	namespace Nodes {
-		namespace Procedure {
-			class Triangulate : public Base {
-			public:
-				Triangulate();
-				void init();
-				string getTypeName() const override;
-
-				void serialize(Json::Value &);
-				void deserialize(const Json::Value &);
-
-				void triangulate();
-			protected:
-				void populateInspector(ofxCvGui::ElementGroupPtr);
-				void drawWorld();
-
-				ofMesh mesh;
-
-				ofParameter<float> maxLength;
-				ofParameter<bool> giveColor;
-				ofParameter<bool> giveTexCoords;
-				ofParameter<float> drawPointSize;
-			};
-		}
-	}
+#pragma once
+
+#include "Base.h"
+
+#include "ofxCvGui/Panels/World.h"
+
+#include "../../../addons/ofxRay/src/ofxRay.h"
+
+namespace ofxRulr {
+	namespace Nodes {
+		namespace Procedure {
+			class Triangulate : public Base {
+			public:
+				Triangulate();
+				void init();
+				string getTypeName() const override;
+
+				void serialize(Json::Value &);
+				void deserialize(const Json::Value &);
+
+				void triangulate();
+				void downsample();
+				void removeOutliers();
+
+				Utils::Bounds getWorldBounds() const override;
+			protected:
+				void populateInspector(ofxCvGui::ElementGroupPtr);
+				void drawWorld();
+				void markMeshChanged();
+				const ofMesh & getDrawMesh();
+
+				ofMesh mesh;
+				unsigned int meshVersion;
+				Utils::Bounds meshBounds;
+
+				ofMesh levelOfDetail;
+				unsigned int levelOfDetailVersion;
+				float levelOfDetailVoxelSize;
+				size_t levelOfDetailBudget;
+				unsigned int levelOfDetailBuildCount;
+
+				struct {
+					size_t correspondenceCount;
+					size_t vertexCount;
+					float duration; // [ms]
+				} triangulateStatistics;
+
+				ofParameter<float> maxLength;
+				ofParameter<bool> giveColor;
+				ofParameter<bool> giveTexCoords;
+				ofParameter<float> drawPointSize;
+				ofParameter<int> drawPointBudget;
+
+				ofParameter<float> voxelSize;
+				ofParameter<int> outlierNeighbours;
+				ofParameter<float> outlierDeviations;
+			};
+		}
+	}
 }
\ No newline at end of file
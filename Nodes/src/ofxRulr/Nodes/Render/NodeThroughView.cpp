@@ -1,50 +1,60 @@
-#include "NodeThroughView.h"
-
-#include "../Item/View.h"
-#include "../Device/VideoOutput.h"
-
-using namespace ofxRulr::Nodes;
-
-namespace ofxRulr {
-	namespace Render {
-		//----------
-		NodeThroughView::NodeThroughView() {
-			RULR_NODE_INIT_LISTENER;
-		}
-
-		//----------
-		string NodeThroughView::getTypeName() const {
-			return "Render::NodeThroughView";
-		}
-
-		//----------
-		void NodeThroughView::init() {
-			this->addInput<Nodes::Base>();
-			this->addInput<Item::View>();
-			auto videoOutputInput = this->addInput<Device::VideoOutput>();
-
-			videoOutputInput->onNewConnection += [this](shared_ptr<Device::VideoOutput> videoOutput) {
-				videoOutput->onDrawOutput.addListener([this](ofRectangle & videoBounds) {
-					this->drawOnVideoOutput(videoBounds);
-				}, this);
-			};
-			videoOutputInput->onDeleteConnection += [this](shared_ptr<Device::VideoOutput> videoOutput) {
-				if (videoOutput) {
-					videoOutput->onDrawOutput.removeListeners(this);
-				}
-			};
-		}
-
-		//----------
-		void NodeThroughView::drawOnVideoOutput(const ofRectangle & viewBounds) {
-			auto node = this->getInput<Nodes::Base>();
-			auto view = this->getInput<Item::View>();
-
-			if (node && view) {
-				view->getViewInWorldSpace().beginAsCamera(true);
-				node->drawWorld();
-				view->getViewInWorldSpace().endAsCamera();
-			}
-		}
-	}
+#include "NodeThroughView.h"
+
+#include "../Item/View.h"
+#include "../Device/VideoOutput.h"
+
+#include "ofxRulr/Utils/Bounds.h"
+
+using namespace ofxRulr::Nodes;
+
+namespace ofxRulr {
+	namespace Render {
+		//----------
+		NodeThroughView::NodeThroughView() {
+			RULR_NODE_INIT_LISTENER;
+		}
+
+		//----------
+		string NodeThroughView::getTypeName() const {
+			return "Render::NodeThroughView";
+		}
+
+		//----------
+		void NodeThroughView::init() {
+			this->addInput<Nodes::Base>();
+			this->addInput<Item::View>();
+			auto videoOutputInput = this->addInput<Device::VideoOutput>();
+
+			videoOutputInput->onNewConnection += [this](shared_ptr<Device::VideoOutput> videoOutput) {
+				videoOutput->onDrawOutput.addListener([this](ofRectangle & videoBounds) {
+					this->drawOnVideoOutput(videoBounds);
+				}, this);
+			};
+			videoOutputInput->onDeleteConnection += [this](shared_ptr<Device::VideoOutput> videoOutput) {
+				if (videoOutput) {
+					videoOutput->onDrawOutput.removeListeners(this);
+				}
+			};
+		}
+
+		//----------
+		void NodeThroughView::drawOnVideoOutput(const ofRectangle & viewBounds) {
+			auto node = this->getInput<Nodes::Base>();
+			auto view = this->getInput<Item::View>();
+
+			if (node && view) {
+				auto viewInWorldSpace = view->getViewInWorldSpace();
+
+				//skip drawing entirely if the node is outside of the view
+				Utils::Frustum frustum(viewInWorldSpace.getViewMatrix() * viewInWorldSpace.getClippedProjectionMatrix());
+				if (!frustum.intersects(node->getWorldBounds())) {
+					return;
+				}
+
+				viewInWorldSpace.beginAsCamera(true);
+				node->drawWorld();
+				viewInWorldSpace.endAsCamera();
+			}
+		}
+	}
 }
\ No newline at end of file
@@ -1,16 +1,16 @@
-#pragma once
-
-#include "ofxRulr/Nodes/Base.h"
-
-namespace ofxRulr {
-	namespace Render {
-		class NodeThroughView : public Nodes::Base {
-		public:
-			NodeThroughView();
-			string getTypeName() const override;
-			void init();
-		protected:
-			void drawOnVideoOutput(const ofRectangle &);
-		};
-	}
+#pragma once
+
+#include "ofxRulr/Nodes/Base.h"
+
+namespace ofxRulr {
+	namespace Render {
+		class NodeThroughView : public Nodes::Base {
+		public:
+			NodeThroughView();
+			string getTypeName() const override;
+			void init();
+		protected:
+			void drawOnVideoOutput(const ofRectangle &);
+		};
+	}
 }
\ No newline at end of file
@@ -21,6 +21,12 @@ namespace ofxRulr {
 				RULR_NODE_INIT_LISTENER;
 			}
 
+			//----------
+			EnttecUsbPro::~EnttecUsbPro() {
+				this->stopOutputThread();
+				this->disconnect();
+			}
+
 			//----------
 			void EnttecUsbPro::init() {
 				RULR_NODE_SERIALIZATION_LISTENERS;
@@ -51,6 +57,9 @@ namespace ofxRulr {
 			void EnttecUsbPro::connect() {
 				this->disconnect();
 
+				//the output thread mustn't see the port until it's open
+				lock_guard<mutex> lock(this->outputLock);
+
 				try {
 					this->sender = make_shared<ofSerial>();
 					this->sender->setup(this->portName.get(), 57600);
@@ -66,6 +75,7 @@ namespace ofxRulr {
 
 			//----------
 			void EnttecUsbPro::disconnect() {
+				lock_guard<mutex> lock(this->outputLock);
 				if (this->sender) {
 					this->sender->close();
 					this->sender.reset();
@@ -73,8 +83,8 @@ namespace ofxRulr {
 			}
 
 			//----------
-			void EnttecUsbPro::sendUniverse(UniverseIndex index, shared_ptr<Universe> universe) {
-				if (this->sender && universe) {
+			void EnttecUsbPro::sendUniverse(UniverseIndex index, const Value * channels) {
+				if (this->sender) {
 					//code taken from ofxDmx
 
 					//we only have one universe, so send it
@@ -91,7 +101,7 @@ namespace ofxRulr {
 
 														// data
 					packet[4] = DMX_START_CODE; // first data byte
-					memcpy(packet + 5, universe->getChannels() + 1, 512);
+					memcpy(packet + 5, channels + 1, 512);
 
 					// end
 					packet[packetSize - 1] = DMX_PRO_END_MSG;